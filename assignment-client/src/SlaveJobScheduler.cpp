@@ -0,0 +1,144 @@
+//
+//  SlaveJobScheduler.cpp
+//  assignment-client/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SlaveJobScheduler.h"
+
+#include <algorithm>
+
+void SlaveJobScheduler::schedule(ConstIter begin, ConstIter end, int numSlaves) {
+    _jobs.clear();
+
+    // look up the estimated cost of each job
+    uint64_t totalEstimate = 0;
+    int numEstimates = 0;
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        uint64_t cost = 0;
+        auto estimate = _estimates.find(node->getUUID());
+        if (estimate != _estimates.end()) {
+            cost = estimate->second;
+            totalEstimate += cost;
+            ++numEstimates;
+        }
+        _jobs.push_back({ node, cost });
+    });
+
+    // new nodes are estimated at the average cost
+    uint64_t defaultEstimate = numEstimates > 0 ? std::max(totalEstimate / numEstimates, (uint64_t)1) : 1;
+
+    std::vector<int> order(_jobs.size());
+    for (size_t i = 0; i < _jobs.size(); ++i) {
+        order[i] = (int)i;
+        if (_jobs[i].cost == 0) {
+            _jobs[i].cost = defaultEstimate;
+        }
+    }
+
+    // deal the most expensive jobs first, each to the least loaded slave
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return _jobs[a].cost > _jobs[b].cost;
+    });
+
+    _numSlaves = numSlaves;
+    while ((int)_deques.size() < numSlaves) {
+        _deques.emplace_back(new Deque());
+    }
+    for (int i = 0; i < numSlaves; ++i) {
+        _deques[i]->jobs.clear();
+        _deques[i]->head = 0;
+    }
+
+    std::vector<uint64_t> loads(numSlaves, 0);
+    for (int job : order) {
+        int slave = (int)(std::min_element(loads.begin(), loads.end()) - loads.begin());
+        _deques[slave]->jobs.push_back(job);
+        loads[slave] += _jobs[job].cost;
+    }
+
+    for (int i = 0; i < numSlaves; ++i) {
+        _deques[i]->size = (int)_deques[i]->jobs.size();
+    }
+}
+
+bool SlaveJobScheduler::pop(int slave, SharedNodePointer& node, int& job) {
+    // slaves that were not dealt jobs (i.e. before the first frame, or while resizing) have nothing to do
+    if (slave >= _numSlaves) {
+        return false;
+    }
+
+    Deque& deque = *_deques[slave];
+
+    do {
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        if (deque.head < deque.jobs.size()) {
+            job = deque.jobs[deque.head++];
+            deque.size = (int)(deque.jobs.size() - deque.head);
+            node = _jobs[job].node;
+            return true;
+        }
+    } while (steal(slave));
+
+    return false;
+}
+
+bool SlaveJobScheduler::steal(int slave) {
+    std::vector<int> stolen;
+
+    while (stolen.empty()) {
+        // find the fullest other deque
+        int victim = -1;
+        int victimSize = 0;
+        for (int i = 0; i < _numSlaves; ++i) {
+            int size = _deques[i]->size;
+            if (i != slave && size > victimSize) {
+                victim = i;
+                victimSize = size;
+            }
+        }
+
+        if (victim == -1) {
+            // every deque is empty
+            return false;
+        }
+
+        // take the back half of its jobs (at least one)
+        Deque& deque = *_deques[victim];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        size_t remaining = deque.jobs.size() - deque.head;
+        size_t count = (remaining + 1) / 2;
+        stolen.assign(deque.jobs.end() - count, deque.jobs.end());
+        deque.jobs.resize(deque.jobs.size() - count);
+        deque.size = (int)(remaining - count);
+    }
+
+    Deque& deque = *_deques[slave];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    deque.jobs.swap(stolen);
+    deque.head = 0;
+    deque.size = (int)deque.jobs.size();
+
+    return true;
+}
+
+void SlaveJobScheduler::harvest() {
+    // smooth the estimates, so that a single slow job does not reshuffle the next deal
+    // nodes that were not scheduled this frame are dropped
+    _nextEstimates.clear();
+    for (auto& job : _jobs) {
+        QUuid nodeID = job.node->getUUID();
+        auto estimate = _estimates.find(nodeID);
+        uint64_t cost = (estimate != _estimates.end()) ? (3 * estimate->second + job.cost) / 4 : job.cost;
+        _nextEstimates[nodeID] = std::max(cost, (uint64_t)1);
+    }
+    std::swap(_estimates, _nextEstimates);
+
+    // release the nodes
+    _jobs.clear();
+}
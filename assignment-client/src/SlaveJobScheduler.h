@@ -0,0 +1,75 @@
+//
+//  SlaveJobScheduler.h
+//  assignment-client/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SlaveJobScheduler_h
+#define hifi_SlaveJobScheduler_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <NodeList.h>
+#include <UUIDHasher.h>
+
+// busy and idle time of a slave thread, accumulated across frames
+//   idle time is the time a slave spent waiting for the other slaves to finish a frame
+struct SlaveThreadTiming {
+    uint64_t busyUsecs { 0 };
+    uint64_t idleUsecs { 0 };
+};
+
+// Work-stealing scheduler of per-node jobs, for the mixer slave pools
+//   Each frame, jobs are dealt to one deque per slave by their estimated cost (the cost measured for
+//   the same node on the previous frame), so that every slave starts with a similar load.
+//   A slave pops jobs from the front of its own deque. Once it is empty, the slave steals the back half
+//   of the fullest other deque, so that a few expensive nodes cannot hold up the frame.
+//   schedule and harvest are not thread-safe, and must be called while the slaves are idle.
+class SlaveJobScheduler {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    // deal the jobs for a frame, one per node
+    void schedule(ConstIter begin, ConstIter end, int numSlaves);
+
+    // pop the next job for a slave, returns false when all jobs are taken
+    bool pop(int slave, SharedNodePointer& node, int& job);
+
+    // record the measured cost of a finished job
+    void finish(int job, uint64_t costUsecs) { _jobs[job].cost = costUsecs; }
+
+    // fold the measured costs into the estimates for the next frame
+    void harvest();
+
+private:
+    struct Job {
+        SharedNodePointer node;
+        uint64_t cost;
+    };
+
+    struct Deque {
+        std::mutex mutex;
+        std::vector<int> jobs; // guarded by mutex
+        size_t head { 0 }; // guarded by mutex
+        std::atomic<int> size { 0 }; // hint for thieves
+    };
+
+    bool steal(int slave);
+
+    std::vector<Job> _jobs;
+    std::vector<std::unique_ptr<Deque>> _deques;
+    int _numSlaves { 0 };
+    std::unordered_map<QUuid, uint64_t> _estimates;
+    std::unordered_map<QUuid, uint64_t> _nextEstimates;
+};
+
+#endif // hifi_SlaveJobScheduler_h
@@ -404,6 +404,12 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    static const QString CONGESTION_CONTROL_OPTION = "congestion_control";
+    auto congestionControlValue = assetServerObject[CONGESTION_CONTROL_OPTION];
+    if (congestionControlValue.isString()) {
+        nodeList->setConnectionCongestionControl(congestionControlValue.toString());
+    }
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
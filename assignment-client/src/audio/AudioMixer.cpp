@@ -12,6 +12,7 @@
 #include "AudioMixer.h"
 
 #include <thread>
+#include <unordered_map>
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
@@ -30,6 +31,7 @@
 #include <StDev.h>
 #include <UUID.h>
 #include <CPUDetect.h>
+#include <GLMHelpers.h>
 
 #include "AudioLogging.h"
 #include "AudioHelpers.h"
@@ -274,6 +276,7 @@ void AudioMixer::sendStatsPacket() {
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
+    statsObject["avg_listeners_(shared)_per_frame"] = (float)_stats.sumListenersShared / (float)_numStatFrames;
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
@@ -302,6 +305,17 @@ void AudioMixer::sendStatsPacket() {
     // call it "avg_..." to keep it higher in the display, sorted alphabetically
     statsObject["avg_timing_stats"] = timingStats;
 
+    // per-thread timing stats, covering both packet processing and mixing
+    QJsonObject threadTimingStats;
+    auto threadTimings = _slavePool.harvestThreadTimings();
+    for (size_t i = 0; i < threadTimings.size(); ++i) {
+        QJsonObject threadStats;
+        threadStats["us_busy_per_frame"] = (qint64)(threadTimings[i].busyUsecs / _numStatFrames);
+        threadStats["us_idle_per_frame"] = (qint64)(threadTimings[i].idleUsecs / _numStatFrames);
+        threadTimingStats[QString::number(i + 1)] = threadStats;
+    }
+    statsObject["thread_timing_stats"] = threadTimingStats;
+
     // mix stats
     QJsonObject mixStats;
 
@@ -314,6 +328,10 @@ void AudioMixer::sendStatsPacket() {
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
+    float numListeners = (float)std::max(_stats.sumListeners, 1);
+    mixStats["avg_candidates_per_listener"] = (float)_stats.totalCandidates / numListeners;
+    mixStats["avg_candidates_mixed_per_listener"] = (float)_stats.totalCandidatesMixed / numListeners;
+
     statsObject["mix_stats"] = mixStats;
 
     _numStatFrames = _numSilentPackets = 0;
@@ -408,12 +426,17 @@ void AudioMixer::start() {
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
                     _stats.sumStreams += prepareFrame(node, frame);
                 });
+
+                clusterListeners(cbegin, cend, frame);
+
+                // index the sources once, to be shared by all slaves
+                _spatialIndex.build(cbegin, cend);
             }
 
             // mix across slave threads
             {
                 auto mixTimer = _mixTiming.timer();
-                _slavePool.mix(cbegin, cend, frame, _throttlingRatio);
+                _slavePool.mix(cbegin, cend, _spatialIndex, frame, _throttlingRatio);
             }
         });
 
@@ -525,6 +548,267 @@ int AudioMixer::prepareFrame(const SharedNodePointer& node, unsigned int frame)
     return data->checkBuffersBeforeFrameSend();
 }
 
+namespace {
+
+// listeners are clustered when their position and orientation quantize to the same values
+const float SHARED_MIX_POSITION_QUANTUM = 0.5f; // meters
+const float SHARED_MIX_ORIENTATION_QUANTA = 8.0f; // steps per unit of each axis
+
+struct SharedMixKey {
+    glm::ivec3 position;
+    glm::ivec3 forward;
+    glm::ivec3 up;
+    uint8_t masterGain;
+    bool isIgnoreRadiusEnabled;
+    QString codec;
+    std::vector<QUuid> ignoreSet; // sorted
+    std::vector<QString> audioZones; // that the listener is in, in the order of AudioMixer::getAudioZones()
+
+    bool operator==(const SharedMixKey& other) const {
+        return position == other.position && forward == other.forward && up == other.up &&
+            masterGain == other.masterGain && isIgnoreRadiusEnabled == other.isIgnoreRadiusEnabled &&
+            codec == other.codec && ignoreSet == other.ignoreSet && audioZones == other.audioZones;
+    }
+};
+
+struct SharedMixKeyHasher {
+    size_t operator()(const SharedMixKey& key) const {
+        uint hash = qHash(key.codec) ^ key.masterGain ^ ((uint)key.isIgnoreRadiusEnabled << 8);
+        auto combine = [&hash](uint value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+        for (int i = 0; i < 3; ++i) {
+            combine(key.position[i]);
+            combine(key.forward[i]);
+            combine(key.up[i]);
+        }
+        for (const auto& nodeID : key.ignoreSet) {
+            combine(qHash(nodeID));
+        }
+        for (const auto& zone : key.audioZones) {
+            combine(qHash(zone));
+        }
+        return hash;
+    }
+};
+
+// the ignore zones of the sources, in the cells of a grid that they overlap, so that only the sources near a listener
+// are looked at to find those that its ignore radius, or theirs, could silence
+class IgnoreZoneGrid {
+public:
+    void insert(const SharedNodePointer& node, const AABox& zone) {
+        glm::ivec3 minCell, maxCell;
+        findCells(zone, minCell, maxCell);
+        glm::ivec3 numCells = maxCell - minCell + glm::ivec3(1);
+        if (numCells.x * numCells.y * numCells.z > MAX_CELLS_PER_ZONE) {
+            _largeZoneNodes.push_back(node);
+            return;
+        }
+        for (int x = minCell.x; x <= maxCell.x; ++x) {
+            for (int y = minCell.y; y <= maxCell.y; ++y) {
+                for (int z = minCell.z; z <= maxCell.z; ++z) {
+                    _cells[cellKey(glm::ivec3(x, y, z))].push_back(node);
+                }
+            }
+        }
+    }
+
+    // append the nodes whose ignore zones could touch the zone, some of them more than once
+    void find(const AABox& zone, std::vector<SharedNodePointer>& nodes) const {
+        glm::ivec3 minCell, maxCell;
+        findCells(zone, minCell, maxCell);
+        glm::ivec3 numCells = maxCell - minCell + glm::ivec3(1);
+        if (numCells.x * numCells.y * numCells.z > MAX_CELLS_PER_ZONE) {
+            for (auto& cell : _cells) {
+                nodes.insert(nodes.end(), cell.second.begin(), cell.second.end());
+            }
+        } else {
+            for (int x = minCell.x; x <= maxCell.x; ++x) {
+                for (int y = minCell.y; y <= maxCell.y; ++y) {
+                    for (int z = minCell.z; z <= maxCell.z; ++z) {
+                        auto cell = _cells.find(cellKey(glm::ivec3(x, y, z)));
+                        if (cell != _cells.end()) {
+                            nodes.insert(nodes.end(), cell->second.begin(), cell->second.end());
+                        }
+                    }
+                }
+            }
+        }
+        nodes.insert(nodes.end(), _largeZoneNodes.begin(), _largeZoneNodes.end());
+    }
+
+private:
+    static const int MAX_CELLS_PER_ZONE = 64;
+
+    static void findCells(const AABox& zone, glm::ivec3& minCell, glm::ivec3& maxCell) {
+        // the zones are grown a little, so that those that touch are found despite rounding
+        const float CELL_SIZE = 4.0f; // meters, about the size of the ignore zone of an avatar
+        const float ZONE_MARGIN = 0.01f; // meters
+        minCell = glm::ivec3(glm::floor((zone.getMinimumPoint() - ZONE_MARGIN) / CELL_SIZE));
+        maxCell = glm::ivec3(glm::floor((zone.getMaximumPoint() + ZONE_MARGIN) / CELL_SIZE));
+    }
+
+    static uint64_t cellKey(const glm::ivec3& cell) {
+        const uint64_t COORD_MASK = (1 << 21) - 1;
+        return ((uint64_t)(cell.x & COORD_MASK) << 42) | ((uint64_t)(cell.y & COORD_MASK) << 21) |
+            (uint64_t)(cell.z & COORD_MASK);
+    }
+
+    std::unordered_map<uint64_t, std::vector<SharedNodePointer>> _cells;
+    std::vector<SharedNodePointer> _largeZoneNodes;
+};
+
+// a listener can share a mix only if that mix is the same as its own:
+// it must be silent (its own streams are not mixed for it), and must not adjust any per-avatar gains
+// whether it ignores the same sources as the leader of its cluster is checked once the leader is known
+bool canShareMix(const SharedNodePointer& node, AudioMixerClientData& data) {
+    if (node->getType() != NodeType::Agent || !node->getActiveSocket() || node->isUpstream()) {
+        return false;
+    }
+
+    auto avatarStream = data.getAvatarAudioStream();
+    if (!avatarStream || !avatarStream->hasValidPosition()) {
+        return false;
+    }
+
+    // domain list data requests bypass ignores, and per-avatar gains change the mix
+    if (data.getRequestsDomainListData() || data.hasPerAvatarGains()) {
+        return false;
+    }
+
+    for (auto& streamPair : data.getAudioStreams()) {
+        auto& stream = streamPair.second;
+        if (stream->shouldLoopbackForNode() || !stream->lastPopSucceeded() || stream->getLastPopOutputLoudness() != 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// whether the follower ignores exactly the sources the leader does, by the same predicate the mix uses
+// the explicit ignores of both are the same, as they are part of the key of the cluster, so they can only differ on the
+// sources whose ignore zones touch one of theirs, with an ignore radius enabled
+bool ignoresSameSources(const SharedNodePointer& leader, AudioMixerClientData& leaderData,
+        const SharedNodePointer& follower, AudioMixerClientData& followerData,
+        const IgnoreZoneGrid& ignoreZones, unsigned int frame) {
+    std::vector<SharedNodePointer> sources;
+    ignoreZones.find(leaderData.getIgnoreZone(frame), sources);
+    ignoreZones.find(followerData.getIgnoreZone(frame), sources);
+    std::sort(sources.begin(), sources.end(), [](const SharedNodePointer& a, const SharedNodePointer& b) {
+        return a.data() < b.data();
+    });
+    sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+
+    for (auto& source : sources) {
+        if (source == leader || source == follower) {
+            // both are silent, so neither is mixed for the other
+            continue;
+        }
+        if (leaderData.computeShouldIgnore(leader, source, frame) !=
+                followerData.computeShouldIgnore(follower, source, frame)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+void AudioMixer::clusterListeners(NodeList::const_iterator cbegin, NodeList::const_iterator cend, unsigned int frame) {
+    // collect the ignore sets in both directions, since either side of an ignore silences the pair
+    std::unordered_map<QUuid, std::vector<QUuid>> ignoreSets;
+    std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+        QUuid nodeID = node->getUUID();
+        node->eachIgnoredNodeID([&](const QUuid& ignoredNodeID) {
+            ignoreSets[nodeID].push_back(ignoredNodeID);
+            ignoreSets[ignoredNodeID].push_back(nodeID);
+        });
+    });
+    for (auto& ignoreSet : ignoreSets) {
+        auto& nodeIDs = ignoreSet.second;
+        std::sort(nodeIDs.begin(), nodeIDs.end());
+        nodeIDs.erase(std::unique(nodeIDs.begin(), nodeIDs.end()), nodeIDs.end());
+    }
+
+    // the nodes whose streams could be mixed, by their ignore zones
+    // those without an ignore radius can only be silenced by the ignore radius of a listener
+    IgnoreZoneGrid ignoreZones;
+    IgnoreZoneGrid ignoreRadiusZones;
+    std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+        if (data && !data->getAudioStreams().empty()) {
+            const AABox& zone = data->getIgnoreZone(frame);
+            ignoreZones.insert(node, zone);
+            if (node->isIgnoreRadiusEnabled()) {
+                ignoreRadiusZones.insert(node, zone);
+            }
+        }
+    });
+    auto& audioZones = AudioMixer::getAudioZones();
+
+    // the first listener of each cluster leads it
+    std::unordered_map<SharedMixKey, SharedNodePointer, SharedMixKeyHasher> leaders;
+
+    std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+        if (data == nullptr) {
+            return;
+        }
+
+        // a follower's own HRTFs aren't rendered, so they are stale by the time it mixes for itself again
+        bool wasFollower = data->isSharedMixFollower();
+        data->getSharedMixFollowers().clear();
+        data->setIsSharedMixFollower(false);
+
+        if (!canShareMix(node, *data)) {
+            if (wasFollower) {
+                data->clearHRTFs();
+            }
+            return;
+        }
+
+        auto avatarStream = data->getAvatarAudioStream();
+        const glm::quat& orientation = avatarStream->getOrientation();
+
+        SharedMixKey key;
+        key.position = glm::ivec3(glm::floor(avatarStream->getPosition() / SHARED_MIX_POSITION_QUANTUM));
+        key.forward = glm::ivec3(glm::round(orientation * Vectors::FRONT * SHARED_MIX_ORIENTATION_QUANTA));
+        key.up = glm::ivec3(glm::round(orientation * Vectors::UP * SHARED_MIX_ORIENTATION_QUANTA));
+        key.masterGain = packFloatGainToByte(data->getMasterAvatarGain());
+        key.isIgnoreRadiusEnabled = node->isIgnoreRadiusEnabled();
+        key.codec = data->getCodecName();
+
+        // the attenuation and reverb of the mix depend on the zones the listener is in
+        for (auto zone = audioZones.cbegin(); zone != audioZones.cend(); ++zone) {
+            if (zone.value().contains(avatarStream->getPosition())) {
+                key.audioZones.push_back(zone.key());
+            }
+        }
+
+        auto ignoreSet = ignoreSets.find(node->getUUID());
+        if (ignoreSet != ignoreSets.end()) {
+            key.ignoreSet = ignoreSet->second;
+        }
+
+        auto leader = leaders.find(key);
+        if (leader == leaders.end()) {
+            leaders.emplace(std::move(key), node);
+        } else {
+            auto& leaderNode = leader->second;
+            AudioMixerClientData* leaderData = (AudioMixerClientData*)leaderNode->getLinkedData();
+            bool isIgnoreRadiusEnabled = node->isIgnoreRadiusEnabled();
+            if (ignoresSameSources(leaderNode, *leaderData, node, *data,
+                    isIgnoreRadiusEnabled ? ignoreZones : ignoreRadiusZones, frame)) {
+                leaderData->getSharedMixFollowers().push_back(node);
+                data->setIsSharedMixFollower(true);
+            }
+        }
+
+        if (wasFollower && !data->isSharedMixFollower()) {
+            data->clearHRTFs();
+        }
+    });
+}
+
 void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
@@ -81,6 +81,8 @@ private:
     // pop a frame from any streams on the node
     // returns the number of available streams
     int prepareFrame(const SharedNodePointer& node, unsigned int frame);
+    // cluster co-located listeners, so that each cluster is mixed and encoded once
+    void clusterListeners(NodeList::const_iterator cbegin, NodeList::const_iterator cend, unsigned int frame);
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
 
@@ -98,6 +100,7 @@ private:
     AudioMixerStats _stats;
 
     AudioMixerSlavePool _slavePool;
+    AudioMixerSpatialIndex _spatialIndex;
 
     class Timer {
     public:
@@ -198,6 +198,16 @@ void AudioMixerClientData::parsePerAvatarGainSet(ReceivedMessage& message, const
     } else {
         // set the per-source avatar gain
         hrtfForStream(avatarUuid, QUuid()).setGainAdjustment(gain);
+        _hasPerAvatarGains = true;
+
+        // the audible radius of this listener grows with the loudest of them
+        _maxAvatarGain = 1.0f;
+        for (auto& nodeHRTFs : _nodeSourcesHRTFMap) {
+            auto itr = nodeHRTFs.second.find(QUuid());
+            if (itr != nodeHRTFs.second.end()) {
+                _maxAvatarGain = std::max(_maxAvatarGain, itr->second.getGainAdjustment() / HRTF_GAIN);
+            }
+        }
         qCDebug(audio) << "Setting avatar gain adjustment for hrtf[" << uuid << "][" << avatarUuid << "] to " << gain;
     }
 }
@@ -647,15 +657,16 @@ AudioMixerClientData::IgnoreZone& AudioMixerClientData::IgnoreZoneMemo::get(unsi
     return _zone;
 }
 
-void AudioMixerClientData::IgnoreNodeCache::cache(bool shouldIgnore) {
-    if (!_isCached) {
+void AudioMixerClientData::IgnoreNodeCache::cache(bool shouldIgnore, unsigned int frame) {
+    if (!isCached(frame)) {
         _shouldIgnore = shouldIgnore;
+        _frame = frame;
         _isCached = true;
     }
 }
 
-bool AudioMixerClientData::IgnoreNodeCache::isCached() {
-    return _isCached;
+bool AudioMixerClientData::IgnoreNodeCache::isCached(unsigned int frame) {
+    return _isCached && _frame == frame;
 }
 
 bool AudioMixerClientData::IgnoreNodeCache::shouldIgnore() {
@@ -669,7 +680,7 @@ bool AudioMixerClientData::shouldIgnore(const SharedNodePointer self, const Shar
 
     // check the cache to avoid computation
     auto& cache = _nodeSourcesIgnoreMap[node->getUUID()];
-    if (cache.isCached()) {
+    if (cache.isCached(frame)) {
         return cache.shouldIgnore();
     }
 
@@ -678,7 +689,21 @@ bool AudioMixerClientData::shouldIgnore(const SharedNodePointer self, const Shar
         return false;
     }
 
-    // compute shouldIgnore
+    bool shouldIgnore = computeShouldIgnore(self, node, frame);
+
+    // cache in node
+    nodeData->_nodeSourcesIgnoreMap[self->getUUID()].cache(shouldIgnore, frame);
+
+    return shouldIgnore;
+}
+
+bool AudioMixerClientData::computeShouldIgnore(const SharedNodePointer& self, const SharedNodePointer& node,
+        unsigned int frame) {
+    AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+    if (!nodeData) {
+        return false;
+    }
+
     bool shouldIgnore = true;
     if ( // the nodes are not ignoring each other explicitly (or are but get data regardless)
             (!self->isIgnoringNodeWithID(node->getUUID()) ||
@@ -696,9 +721,6 @@ bool AudioMixerClientData::shouldIgnore(const SharedNodePointer self, const Shar
         }
     }
 
-    // cache in node
-    nodeData->_nodeSourcesIgnoreMap[self->getUUID()].cache(shouldIgnore);
-
     return shouldIgnore;
 }
 
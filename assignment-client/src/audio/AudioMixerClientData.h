@@ -13,6 +13,7 @@
 #define hifi_AudioMixerClientData_h
 
 #include <queue>
+#include <unordered_set>
 
 #include <QtCore/QJsonObject>
 
@@ -47,6 +48,13 @@ public:
     // precondition: frame is increasing after first call (including overflow wrap)
     bool shouldIgnore(SharedNodePointer self, SharedNodePointer node, unsigned int frame);
 
+    // returns whether self (this data's node) should ignore node, without reading or writing the memo
+    bool computeShouldIgnore(const SharedNodePointer& self, const SharedNodePointer& node, unsigned int frame);
+
+    // returns the zone in which self and the nodes it's near ignore each other if either has an ignore radius enabled,
+    // memoized by frame
+    const AABox& getIgnoreZone(unsigned int frame) { return _ignoreZone.get(frame); }
+
     // the following methods should be called from the AudioMixer assignment thread ONLY
     // they are not thread-safe
 
@@ -56,6 +64,9 @@ public:
     // removes an AudioHRTF object for a given stream
     void removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID = QUuid());
 
+    // removes every AudioHRTF object, so that the sources are faded in again from silence
+    void clearHRTFs() { _nodeSourcesHRTFMap.clear(); }
+
     // remove all sources and data from this node
     void removeNode(const QUuid& nodeID) { _nodeSourcesIgnoreMap.unsafe_erase(nodeID); _nodeSourcesHRTFMap.erase(nodeID); }
 
@@ -86,6 +97,28 @@ public:
 
     float getMasterAvatarGain() const { return _masterAvatarGain; }
     void setMasterAvatarGain(float gain) { _masterAvatarGain = gain; }
+    bool hasPerAvatarGains() const { return _hasPerAvatarGains; }
+    float getMaxAvatarGain() const { return _maxAvatarGain; }
+
+    // calls f(hrtf) for every existing AudioHRTF object of the streams from the given node, without creating any
+    template <typename F>
+    void forEachHRTF(const QUuid& nodeID, F f) {
+        auto itr = _nodeSourcesHRTFMap.find(nodeID);
+        if (itr != _nodeSourcesHRTFMap.end()) {
+            for (auto& streamHRTF : itr->second) {
+                f(streamHRTF.second);
+            }
+        }
+    }
+
+    // the nodes that were candidates for the last mix of this listener, swapped with those of each new mix
+    std::unordered_set<QUuid>& getLastCandidateIDs() { return _lastCandidateIDs; }
+
+    // co-located listeners share a mix, which is mixed and encoded once by the first listener of their cluster
+    // these are set by the AudioMixer before each mix, and are read-only while mixing
+    std::vector<SharedNodePointer>& getSharedMixFollowers() { return _sharedMixFollowers; }
+    bool isSharedMixFollower() const { return _isSharedMixFollower; }
+    void setIsSharedMixFollower(bool isFollower) { _isSharedMixFollower = isFollower; }
 
     AudioLimiter audioLimiter;
 
@@ -156,12 +189,15 @@ private:
         IgnoreNodeCache() {}
         IgnoreNodeCache(const IgnoreNodeCache& other) {}
 
-        void cache(bool shouldIgnore);
-        bool isCached();
+        // the cache is stamped with the frame, since a node culled from a mix
+        // may never read back the value that its peer cached for it
+        void cache(bool shouldIgnore, unsigned int frame);
+        bool isCached(unsigned int frame);
         bool shouldIgnore();
 
     private:
         std::atomic<bool> _isCached { false };
+        std::atomic<unsigned int> _frame { 0 };
         bool _shouldIgnore { false };
     };
     struct IgnoreNodeCacheHasher { std::size_t operator()(const QUuid& key) const { return qHash(key); } };
@@ -172,6 +208,7 @@ private:
     using HRTFMap = std::unordered_map<QUuid, AudioHRTF>;
     using NodeSourcesHRTFMap = std::unordered_map<QUuid, HRTFMap>;
     NodeSourcesHRTFMap _nodeSourcesHRTFMap;
+    std::unordered_set<QUuid> _lastCandidateIDs;
 
     quint16 _outgoingMixedAudioSequenceNumber;
 
@@ -180,6 +217,11 @@ private:
     int _frameToSendStats { 0 };
 
     float _masterAvatarGain { 1.0f };   // per-listener mixing gain, applied only to avatars
+    bool _hasPerAvatarGains { false };  // set once any per-avatar gain is adjusted
+    float _maxAvatarGain { 1.0f };      // the largest per-avatar gain, at least unity
+
+    std::vector<SharedNodePointer> _sharedMixFollowers;
+    bool _isSharedMixFollower { false };
 
     CodecPluginPointer _codec;
     QString _selectedCodecName;
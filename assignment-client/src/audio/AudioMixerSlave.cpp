@@ -12,6 +12,8 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -52,6 +54,8 @@ inline float computeGain(const AudioMixerClientData& listenerNodeData, const Ava
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance, bool isEcho);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
+inline float computeAudibleRadius(const AudioMixerClientData& listenerNodeData,
+        const AvatarAudioStream& listeningNodeStream);
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
@@ -60,9 +64,11 @@ void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     }
 }
 
-void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, const AudioMixerSpatialIndex& spatialIndex,
+        unsigned int frame, float throttlingRatio) {
     _begin = begin;
     _end = end;
+    _spatialIndex = &spatialIndex;
     _frame = frame;
     _throttlingRatio = throttlingRatio;
 }
@@ -93,25 +99,21 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
 
-        // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        if (data->isSharedMixFollower()) {
+            // the leader of this listener's cluster mixes, and sends its audio packet
+            ++stats.sumListenersShared;
+        } else {
+            // mix the audio
+            bool mixHasAudio = prepareMix(node);
 
-        // send audio packet
-        if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
-            } else {
-                // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
-            }
+            // co-located listeners that share this mix
+            auto& followers = data->getSharedMixFollowers();
 
-            sendMixPacket(node, *data, encodedBuffer);
-        } else {
-            ++stats.sumListenersSilent;
-            sendSilentPacket(node, *data);
+            // send audio packets, each encoded by the listener's own (stateful) encoder
+            sendMix(node, *data, mixHasAudio);
+            for (auto& follower : followers) {
+                sendMix(follower, *static_cast<AudioMixerClientData*>(follower->getLinkedData()), mixHasAudio);
+            }
         }
 
         // send environment packet
@@ -125,6 +127,25 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     }
 }
 
+void AudioMixerSlave::sendMix(const SharedNodePointer& node, AudioMixerClientData& data, bool mixHasAudio) {
+    if (mixHasAudio || data.shouldFlushEncoder()) {
+        QByteArray encodedBuffer;
+        if (mixHasAudio) {
+            // encode the audio
+            QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+            data.encode(decodedBuffer, encodedBuffer);
+        } else {
+            // time to flush (resets shouldFlush until the next encode)
+            data.encodeFrameOfZeros(encodedBuffer);
+        }
+
+        sendMixPacket(node, data, encodedBuffer);
+    } else {
+        ++stats.sumListenersSilent;
+        sendSilentPacket(node, data);
+    }
+}
+
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
@@ -155,11 +176,20 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     auto mixStart = p_high_resolution_clock::now();
 #endif
 
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+    // only consider the sources that are close enough to be heard
+    float audibleRadius = computeAudibleRadius(*listenerData, *listenerAudioStream);
+    _spatialIndex->query(listenerAudioStream->getPosition(), audibleRadius, _candidates);
+    stats.totalCandidates += (int)_candidates.size();
+
+    const auto& nodes = _spatialIndex->getNodes();
+    _candidateIDs.clear();
+    std::for_each(_candidates.cbegin(), _candidates.cend(), [&](int nodeIndex) {
+        const SharedNodePointer& node = nodes[nodeIndex];
         AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
         if (!nodeData) {
             return;
         }
+        _candidateIDs.insert(node->getUUID());
 
         if (*node == *listener) {
             // only mix the echo, if requested
@@ -172,6 +202,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         } else if (!listenerData->shouldIgnore(listener, node, _frame)) {
             if (!isThrottling) {
                 forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+                ++stats.totalCandidatesMixed;
             } else {
                 auto nodeID = node->getUUID();
 
@@ -212,6 +243,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             auto& node = throttledNodes.back().second;
             AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
             forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+            ++stats.totalCandidatesMixed;
 
             throttledNodes.pop_back();
         }
@@ -224,6 +256,19 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         }
     }
 
+    // to reduce artifacts the HRTFs of culled sources are faded out, as for throttled sources, rather than cut off
+    // a fade-out takes a single frame, so only the sources that were candidates last frame but not this one need it
+    const int HRTF_DATASET_INDEX = 1;
+    auto& lastCandidateIDs = listenerData->getLastCandidateIDs();
+    for (const auto& nodeID : lastCandidateIDs) {
+        if (_candidateIDs.find(nodeID) == _candidateIDs.end()) {
+            listenerData->forEachHRTF(nodeID, [&](AudioHRTF& hrtf) {
+                hrtf.renderFadeOut(_mixSamples, HRTF_DATASET_INDEX, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            });
+        }
+    }
+    lastCandidateIDs.swap(_candidateIDs);
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     auto mixEnd = p_high_resolution_clock::now();
     auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
@@ -584,3 +629,34 @@ float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const Positio
         return 0.0f; 
     }
 }
+
+float computeAudibleRadius(const AudioMixerClientData& listenerNodeData,
+        const AvatarAudioStream& listeningNodeStream) {
+    // sources attenuated by more than this are not mixed
+    const float AUDIBILITY_THRESHOLD = 0.001f; // -60dB
+
+    // the master and per-avatar gains can boost a source, so they raise the attenuation it takes to be inaudible
+    // (the other gains of computeGain can only attenuate it)
+    float maxGain = std::max(listenerNodeData.getMasterAvatarGain(), 1.0f) * listenerNodeData.getMaxAvatarGain();
+
+    auto& audioZones = AudioMixer::getAudioZones();
+    auto& zoneSettings = AudioMixer::getZoneSettings();
+
+    // use the weakest attenuation that could apply to a source, so that culling stays conservative
+    float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
+    for (int i = 0; i < zoneSettings.length(); ++i) {
+        if (audioZones[zoneSettings[i].listener].contains(listeningNodeStream.getPosition())) {
+            attenuationPerDoublingInDistance = std::min(attenuationPerDoublingInDistance, zoneSettings[i].coefficient);
+        }
+    }
+    float g = glm::clamp(1.0f - attenuationPerDoublingInDistance, EPSILON, 1.0f);
+
+    if (g >= 1.0f) {
+        // no distance attenuation, every source is audible
+        return std::numeric_limits<float>::infinity();
+    }
+
+    // invert the distance attenuation of computeGain, gain = g^log2(distance)
+    // (this runs once per listener, so use the exact functions; the result may overflow to infinity)
+    return std::exp2(std::log2(AUDIBILITY_THRESHOLD / maxGain) / std::log2(g));
+}
@@ -12,6 +12,8 @@
 #ifndef hifi_AudioMixerSlave_h
 #define hifi_AudioMixerSlave_h
 
+#include <unordered_set>
+
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
@@ -19,6 +21,7 @@
 #include <UUIDHasher.h>
 #include <NodeList.h>
 
+#include "AudioMixerSpatialIndex.h"
 #include "AudioMixerStats.h"
 
 class PositionalAudioStream;
@@ -34,7 +37,8 @@ public:
     void processPackets(const SharedNodePointer& node);
 
     // configure a round of mixing
-    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    void configureMix(ConstIter begin, ConstIter end, const AudioMixerSpatialIndex& spatialIndex,
+            unsigned int frame, float throttlingRatio);
 
     // mix and broadcast non-ignored streams to the node (requires configuration using configureMix, above)
     // returns true if a mixed packet was sent to the node
@@ -45,6 +49,8 @@ public:
 private:
     // create mix, returns true if mix has audio
     bool prepareMix(const SharedNodePointer& listener);
+    // encode the limited mix for the node and send it, or send a silent packet
+    void sendMix(const SharedNodePointer& node, AudioMixerClientData& data, bool mixHasAudio);
     void throttleStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
     void mixStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
@@ -57,9 +63,14 @@ private:
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
+    // candidate sources for the current listener
+    AudioMixerSpatialIndex::Candidates _candidates;
+    std::unordered_set<QUuid> _candidateIDs;
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
+    const AudioMixerSpatialIndex* _spatialIndex { nullptr };
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
 };
@@ -14,15 +14,31 @@
 #include <assert.h>
 #include <algorithm>
 
+#include <PortableHighResolutionClock.h>
+
+using namespace std::chrono;
+
 void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
 
+        // packets sent during the frame are batched, and sent together once this slave is out of jobs
+        auto nodeList = DependencyManager::get<NodeList>();
+        nodeList->beginSendBatch();
+
         // iterate over all available nodes
+        auto start = p_high_resolution_clock::now();
         SharedNodePointer node;
-        while (try_pop(node)) {
+        int job;
+        while (try_pop(node, job)) {
+            auto jobStart = p_high_resolution_clock::now();
             (this->*_function)(node);
+            finish(job, duration_cast<microseconds>(p_high_resolution_clock::now() - jobStart).count());
         }
+        node.reset();
+
+        nodeList->flushSendBatch();
+        _busyUsecs = duration_cast<microseconds>(p_high_resolution_clock::now() - start).count();
 
         bool stopping = _stop;
         notify(stopping);
@@ -60,8 +76,12 @@ void AudioMixerSlaveThread::notify(bool stopping) {
     _pool._poolCondition.notify_one();
 }
 
-bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node, int& job) {
+    return _pool._scheduler->pop(_index, node, job);
+}
+
+void AudioMixerSlaveThread::finish(int job, uint64_t costUsecs) {
+    _pool._scheduler->finish(job, costUsecs);
 }
 
 #ifdef AUDIO_SINGLE_THREADED
@@ -71,21 +91,23 @@ static AudioMixerSlave slave;
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    run(begin, end, _packetsScheduler);
 }
 
-void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, const AudioMixerSpatialIndex& spatialIndex,
+        unsigned int frame, float throttlingRatio) {
     _function = &AudioMixerSlave::mix;
     _configure = [=](AudioMixerSlave& slave) {
-        slave.configureMix(_begin, _end, _frame, _throttlingRatio);
+        slave.configureMix(_begin, _end, *_spatialIndex, _frame, _throttlingRatio);
     };
+    _spatialIndex = &spatialIndex;
     _frame = frame;
     _throttlingRatio = throttlingRatio;
 
-    run(begin, end);
+    run(begin, end, _mixScheduler);
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, SlaveJobScheduler& scheduler) {
     _begin = begin;
     _end = end;
 
@@ -95,15 +117,11 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         _function(slave, node);
     });
 #else
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-#if defined(__clang__) && defined(Q_OS_LINUX)
-        _queue.push(node);
-#else
-        _queue.emplace(node);
-#endif
-    });
+    // deal the jobs
+    _scheduler = &scheduler;
+    _scheduler->schedule(_begin, _end, _numThreads);
 
+    auto start = p_high_resolution_clock::now();
     {
         Lock lock(_mutex);
 
@@ -119,8 +137,16 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
 
         assert(_numStarted == _numThreads);
     }
+    uint64_t runUsecs = duration_cast<microseconds>(p_high_resolution_clock::now() - start).count();
+
+    // a slave is idle from when it runs out of jobs to when the last slave finishes
+    for (int i = 0; i < _numThreads; ++i) {
+        uint64_t busyUsecs = std::min(_slaves[i]->_busyUsecs, runUsecs);
+        _timings[i].busyUsecs += busyUsecs;
+        _timings[i].idleUsecs += runUsecs - busyUsecs;
+    }
 
-    assert(_queue.empty());
+    _scheduler->harvest();
 #endif
 }
 
@@ -134,6 +160,12 @@ void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> funct
 #endif
 }
 
+std::vector<SlaveThreadTiming> AudioMixerSlavePool::harvestThreadTimings() {
+    std::vector<SlaveThreadTiming> timings(_timings.size());
+    std::swap(timings, _timings);
+    return timings;
+}
+
 void AudioMixerSlavePool::setNumThreads(int numThreads) {
     // clamp to allowed size
     {
@@ -167,7 +199,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this);
+            auto slave = new AudioMixerSlaveThread(*this, _numThreads + i);
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -206,6 +238,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
     }
 
     _numThreads = _numStarted = _numFinished = numThreads;
+    _timings.resize(numThreads);
     assert(_numThreads == (int)_slaves.size());
 #endif
 }
@@ -18,8 +18,7 @@
 
 #include <QThread>
 
-#include <TBBHelpers.h>
-
+#include "../SlaveJobScheduler.h"
 #include "AudioMixerSlave.h"
 
 class AudioMixerSlavePool;
@@ -31,7 +30,7 @@ class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool) : _pool(pool) {}
+    AudioMixerSlaveThread(AudioMixerSlavePool& pool, int index) : _pool(pool), _index(index) {}
 
     void run() override final;
 
@@ -40,17 +39,19 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
+    bool try_pop(SharedNodePointer& node, int& job);
+    void finish(int job, uint64_t costUsecs);
 
     AudioMixerSlavePool& _pool;
+    const int _index;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
+    uint64_t _busyUsecs { 0 }; // time spent on jobs during the last run
     bool _stop { false };
 };
 
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -64,24 +65,29 @@ public:
     // process packets on slave threads
     void processPackets(ConstIter begin, ConstIter end);
 
-    // mix on slave threads
-    void mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    // mix on slave threads, culling sources with the given (prebuilt) spatial index
+    void mix(ConstIter begin, ConstIter end, const AudioMixerSpatialIndex& spatialIndex,
+            unsigned int frame, float throttlingRatio);
 
     // iterate over all slaves
     void each(std::function<void(AudioMixerSlave& slave)> functor);
 
+    // get the busy and idle time of each slave thread since the last harvest, and reset them
+    std::vector<SlaveThreadTiming> harvestThreadTimings();
+
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, SlaveJobScheduler& scheduler);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
 
     friend void AudioMixerSlaveThread::wait();
     friend void AudioMixerSlaveThread::notify(bool stopping);
-    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node, int& job);
+    friend void AudioMixerSlaveThread::finish(int job, uint64_t costUsecs);
 
     // synchronization state
     Mutex _mutex;
@@ -94,10 +100,16 @@ private:
     int _numFinished { 0 }; // guarded by _mutex
     int _numStopped { 0 }; // guarded by _mutex
 
+    // scheduling state, one scheduler per job type so that their cost estimates do not mix
+    SlaveJobScheduler _packetsScheduler;
+    SlaveJobScheduler _mixScheduler;
+    SlaveJobScheduler* _scheduler { &_mixScheduler };
+    std::vector<SlaveThreadTiming> _timings;
+
     // frame state
-    Queue _queue;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    const AudioMixerSpatialIndex* _spatialIndex { nullptr };
     ConstIter _begin;
     ConstIter _end;
 };
@@ -0,0 +1,120 @@
+//
+//  AudioMixerSpatialIndex.cpp
+//  assignment-client/src/audio
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtx/norm.hpp>
+
+#include "AudioMixerClientData.h"
+
+// cells are sized for typical conversation distances, so most queries only touch a handful of columns
+static const float CELL_SIZE = 16.0f;
+static const float INV_CELL_SIZE = 1.0f / CELL_SIZE;
+
+// cell coordinates are packed into 21 bits each
+static const int CELL_BITS = 21;
+static const int64_t CELL_OFFSET = 1LL << (CELL_BITS - 1);
+static const int64_t CELL_MAX = (1LL << CELL_BITS) - 1;
+
+static inline int64_t toCell(float coordinate) {
+    // clamp before converting, so that distant (or huge query) coordinates cannot overflow
+    float cell = floorf(coordinate * INV_CELL_SIZE) + (float)CELL_OFFSET;
+    return (int64_t)std::min(std::max(cell, 0.0f), (float)CELL_MAX);
+}
+
+static inline uint64_t packCell(int64_t x, int64_t y, int64_t z) {
+    // z is packed in the lowest bits, so that each (x, y) column is contiguous in the sorted entries
+    return ((uint64_t)x << (2 * CELL_BITS)) | ((uint64_t)y << CELL_BITS) | (uint64_t)z;
+}
+
+void AudioMixerSpatialIndex::build(ConstIter begin, ConstIter end) {
+    _nodes.clear();
+    _entries.clear();
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!nodeData) {
+            return;
+        }
+
+        int nodeIndex = (int)_nodes.size();
+        bool hasPositionedStream = false;
+
+        for (auto& streamPair : nodeData->getAudioStreams()) {
+            auto& stream = streamPair.second;
+
+            // streams without a valid position are never mixed, so they need not be indexed
+            if (!stream->hasValidPosition()) {
+                continue;
+            }
+
+            glm::vec3 position = stream->getPosition();
+            uint64_t cell = packCell(toCell(position.x), toCell(position.y), toCell(position.z));
+            _entries.push_back({ cell, position, nodeIndex });
+            hasPositionedStream = true;
+        }
+
+        if (hasPositionedStream) {
+            _nodes.push_back(node);
+        }
+    });
+
+    std::sort(_entries.begin(), _entries.end());
+}
+
+void AudioMixerSpatialIndex::query(const glm::vec3& position, float radius, Candidates& candidates) const {
+    candidates.clear();
+
+    float radiusSquared = radius * radius;
+    auto addIfInRange = [&](const Entry& entry) {
+        if (glm::distance2(entry.position, position) <= radiusSquared) {
+            candidates.push_back(entry.node);
+        }
+    };
+
+    // an unbounded radius (no distance attenuation) reaches every source
+    if (!std::isfinite(radius)) {
+        std::for_each(_entries.cbegin(), _entries.cend(), addIfInRange);
+    } else {
+        int64_t minX = toCell(position.x - radius);
+        int64_t maxX = toCell(position.x + radius);
+        int64_t minY = toCell(position.y - radius);
+        int64_t maxY = toCell(position.y + radius);
+        int64_t minZ = toCell(position.z - radius);
+        int64_t maxZ = toCell(position.z + radius);
+
+        // each column costs a binary search, so fall back to a linear scan when the query covers too many of them
+        uint64_t numColumns = (uint64_t)(maxX - minX + 1) * (uint64_t)(maxY - minY + 1);
+        if (numColumns > _entries.size()) {
+            std::for_each(_entries.cbegin(), _entries.cend(), addIfInRange);
+        } else {
+            for (int64_t x = minX; x <= maxX; ++x) {
+                for (int64_t y = minY; y <= maxY; ++y) {
+                    Entry first { packCell(x, y, minZ), glm::vec3(), 0 };
+                    uint64_t lastCell = packCell(x, y, maxZ);
+
+                    auto entry = std::lower_bound(_entries.cbegin(), _entries.cend(), first);
+                    while (entry != _entries.cend() && entry->cell <= lastCell) {
+                        addIfInRange(*entry);
+                        ++entry;
+                    }
+                }
+            }
+        }
+    }
+
+    // a node is a candidate once, even when several of its streams are in range
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
@@ -0,0 +1,52 @@
+//
+//  AudioMixerSpatialIndex.h
+//  assignment-client/src/audio
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerSpatialIndex_h
+#define hifi_AudioMixerSpatialIndex_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+
+// Spatial index of audio sources, bucketed by a uniform grid over their stream positions.
+//   It is rebuilt once per frame by the AudioMixer, and then shared read-only across slave threads.
+//   AudioMixerSpatialIndex::build is not thread-safe; AudioMixerSpatialIndex::query is.
+class AudioMixerSpatialIndex {
+public:
+    using ConstIter = NodeList::const_iterator;
+    using Nodes = std::vector<SharedNodePointer>;
+    using Candidates = std::vector<int>;
+
+    // rebuild the index from the positioned streams of the given nodes
+    void build(ConstIter begin, ConstIter end);
+
+    // fill candidates with the indices (into getNodes) of nodes with a stream within radius of position
+    // candidates are sorted, so iteration follows the order of the nodes used to build the index
+    void query(const glm::vec3& position, float radius, Candidates& candidates) const;
+
+    const Nodes& getNodes() const { return _nodes; }
+
+private:
+    struct Entry {
+        uint64_t cell;
+        glm::vec3 position;
+        int node;
+
+        bool operator<(const Entry& other) const { return cell < other.cell; }
+    };
+
+    Nodes _nodes;
+    std::vector<Entry> _entries; // sorted by cell
+};
+
+#endif // hifi_AudioMixerSpatialIndex_h
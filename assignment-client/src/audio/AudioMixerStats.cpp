@@ -15,7 +15,10 @@ void AudioMixerStats::reset() {
     sumStreams = 0;
     sumListeners = 0;
     sumListenersSilent = 0;
+    sumListenersShared = 0;
     totalMixes = 0;
+    totalCandidates = 0;
+    totalCandidatesMixed = 0;
     hrtfRenders = 0;
     hrtfSilentRenders = 0;
     hrtfThrottleRenders = 0;
@@ -30,7 +33,10 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumStreams += otherStats.sumStreams;
     sumListeners += otherStats.sumListeners;
     sumListenersSilent += otherStats.sumListenersSilent;
+    sumListenersShared += otherStats.sumListenersShared;
     totalMixes += otherStats.totalMixes;
+    totalCandidates += otherStats.totalCandidates;
+    totalCandidatesMixed += otherStats.totalCandidatesMixed;
     hrtfRenders += otherStats.hrtfRenders;
     hrtfSilentRenders += otherStats.hrtfSilentRenders;
     hrtfThrottleRenders += otherStats.hrtfThrottleRenders;
@@ -20,9 +20,13 @@ struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
     int sumListenersSilent { 0 };
+    int sumListenersShared { 0 };
 
     int totalMixes { 0 };
 
+    int totalCandidates { 0 };
+    int totalCandidatesMixed { 0 };
+
     int hrtfRenders { 0 };
     int hrtfSilentRenders { 0 };
     int hrtfThrottleRenders { 0 };
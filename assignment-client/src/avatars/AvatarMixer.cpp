@@ -240,12 +240,14 @@ void AvatarMixer::start() {
 
         // process pending display names... this doesn't currently run on multiple threads, because it
         // side-effects the mixer's data, which is fine because it's a very low cost operation
+        int numAgents = 0;
         {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
                     if (node->getType() == NodeType::Agent) {
                         manageIdentityData(node);
+                        ++numAgents;
                     }
 
                     ++_sumListeners;
@@ -257,10 +259,17 @@ void AvatarMixer::start() {
 
         // this is where we need to put the real work...
         {
+            // split the broadcast time of a frame evenly between agents, so that the frame rate holds as agents join
+            const float BROADCAST_TIME_BUDGET_RATIO = 0.75f;
+            const float FRAME_TIME = USECS_PER_SECOND / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+            uint64_t timeBudgetPerNode = (uint64_t)(BROADCAST_TIME_BUDGET_RATIO * FRAME_TIME *
+                (float)_slavePool.numThreads() / (float)std::max(numAgents, 1));
+
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
-                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
+                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio,
+                                               timeBudgetPerNode);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
             }, &lockWait, &nodeTransform, &functor);
@@ -719,6 +728,8 @@ void AvatarMixer::sendStatsPacket() {
 
     float secondsSinceLastStats = (float)(start - _lastStatsTime) / (float)USECS_PER_SECOND;
     // gather stats
+    auto threadTimings = _slavePool.harvestThreadTimings();
+    SlaveThreadTiming aggregateTiming;
     int slaveNumber = 1;
     _slavePool.each([&](AvatarMixerSlave& slave) {
         QJsonObject slaveObject;
@@ -742,13 +753,30 @@ void AvatarMixer::sendStatsPacket() {
         float averageOverBudgetAvatars = averageNodes ? stats.overBudgetAvatars / averageNodes : 0.0f;
         slaveObject["sent_7_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
 
+        float averageOverTimeBudgetAvatars = averageNodes ? stats.overTimeBudgetAvatars / averageNodes : 0.0f;
+        slaveObject["sent_8_averageOverTimeBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverTimeBudgetAvatars);
+
+        int numEncodes = stats.encodeCacheHits + stats.encodeCacheMisses;
+        slaveObject["sent_9_encodeCacheHitRate"] = numEncodes ? (float)stats.encodeCacheHits / (float)numEncodes : 0.0f;
+
         slaveObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(stats.processIncomingPacketsElapsedTime);
         slaveObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(stats.ignoreCalculationElapsedTime);
         slaveObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(stats.toByteArrayElapsedTime);
+        slaveObject["timing_3a_toByteArrayCacheHit"] = TIGHT_LOOP_STAT_UINT64(stats.toByteArrayCacheHitElapsedTime);
+        slaveObject["timing_3b_toByteArrayCacheMiss"] = TIGHT_LOOP_STAT_UINT64(stats.toByteArrayCacheMissElapsedTime);
+        slaveObject["timing_3c_toByteArrayPerReceiver"] = TIGHT_LOOP_STAT_UINT64(stats.toByteArrayPerReceiverElapsedTime);
         slaveObject["timing_4_avatarDataPacking"] = TIGHT_LOOP_STAT_UINT64(stats.avatarDataPackingElapsedTime);
         slaveObject["timing_5_packetSending"] = TIGHT_LOOP_STAT_UINT64(stats.packetSendingElapsedTime);
         slaveObject["timing_6_jobElapsedTime"] = TIGHT_LOOP_STAT_UINT64(stats.jobElapsedTime);
 
+        if (slaveNumber <= (int)threadTimings.size()) {
+            const SlaveThreadTiming& timing = threadTimings[slaveNumber - 1];
+            slaveObject["timing_7_threadBusy"] = TIGHT_LOOP_STAT_UINT64(timing.busyUsecs);
+            slaveObject["timing_8_threadIdle"] = TIGHT_LOOP_STAT_UINT64(timing.idleUsecs);
+            aggregateTiming.busyUsecs += timing.busyUsecs;
+            aggregateTiming.idleUsecs += timing.idleUsecs;
+        }
+
         slavesObject[QString::number(slaveNumber)] = slaveObject;
         slaveNumber++;
 
@@ -775,12 +803,23 @@ void AvatarMixer::sendStatsPacket() {
     float averageOverBudgetAvatars = averageNodes ? aggregateStats.overBudgetAvatars / averageNodes : 0.0f;
     slavesAggregatObject["sent_7_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
 
+    float averageOverTimeBudgetAvatars = averageNodes ? aggregateStats.overTimeBudgetAvatars / averageNodes : 0.0f;
+    slavesAggregatObject["sent_8_averageOverTimeBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverTimeBudgetAvatars);
+
+    int numEncodes = aggregateStats.encodeCacheHits + aggregateStats.encodeCacheMisses;
+    slavesAggregatObject["sent_9_encodeCacheHitRate"] = numEncodes ? (float)aggregateStats.encodeCacheHits / (float)numEncodes : 0.0f;
+
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
     slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
+    slavesAggregatObject["timing_3a_toByteArrayCacheHit"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayCacheHitElapsedTime);
+    slavesAggregatObject["timing_3b_toByteArrayCacheMiss"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayCacheMissElapsedTime);
+    slavesAggregatObject["timing_3c_toByteArrayPerReceiver"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayPerReceiverElapsedTime);
     slavesAggregatObject["timing_4_avatarDataPacking"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.avatarDataPackingElapsedTime);
     slavesAggregatObject["timing_5_packetSending"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.packetSendingElapsedTime);
     slavesAggregatObject["timing_6_jobElapsedTime"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.jobElapsedTime);
+    slavesAggregatObject["timing_7_threadBusy"] = TIGHT_LOOP_STAT_UINT64(aggregateTiming.busyUsecs);
+    slavesAggregatObject["timing_8_threadIdle"] = TIGHT_LOOP_STAT_UINT64(aggregateTiming.idleUsecs);
 
     statsObject["slaves_aggregate"] = slavesAggregatObject;
     statsObject["slaves_individual"] = slavesObject;
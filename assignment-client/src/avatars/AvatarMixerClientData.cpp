@@ -11,6 +11,8 @@
 
 #include "AvatarMixerClientData.h"
 
+#include <glm/gtx/norm.hpp>
+
 #include <udt/PacketHeaders.h>
 
 #include <DependencyManager.h>
@@ -84,9 +86,37 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message) {
     }
     _lastReceivedSequenceNumber = sequenceNumber;
 
+    // the avatar is about to change, so its shared encodings are stale
+    {
+        std::lock_guard<std::mutex> lock(_encodedAvatarDataMutex);
+        _encodedAvatarData.clear();
+    }
+
     // compute the offset to the data payload
     return _avatar->parseDataFromBuffer(message.readWithoutCopy(message.getBytesLeftToRead()));
 }
+
+static uint32_t encodedAvatarDataKey(AvatarData::AvatarDataDetail detail, AvatarDataPacket::HasFlags flags,
+                                     bool dropFaceTracking) {
+    return ((uint32_t)detail << 17) | ((uint32_t)flags << 1) | (dropFaceTracking ? 1 : 0);
+}
+
+bool AvatarMixerClientData::findEncodedAvatarData(AvatarData::AvatarDataDetail detail, AvatarDataPacket::HasFlags flags,
+                                                  bool dropFaceTracking, EncodedAvatarData& encoded) const {
+    std::lock_guard<std::mutex> lock(_encodedAvatarDataMutex);
+    auto itr = _encodedAvatarData.find(encodedAvatarDataKey(detail, flags, dropFaceTracking));
+    if (itr == _encodedAvatarData.end()) {
+        return false;
+    }
+    encoded = itr->second;
+    return true;
+}
+
+void AvatarMixerClientData::cacheEncodedAvatarData(AvatarData::AvatarDataDetail detail, AvatarDataPacket::HasFlags flags,
+                                                   bool dropFaceTracking, const EncodedAvatarData& encoded) const {
+    std::lock_guard<std::mutex> lock(_encodedAvatarDataMutex);
+    _encodedAvatarData[encodedAvatarDataKey(detail, flags, dropFaceTracking)] = encoded;
+}
 uint64_t AvatarMixerClientData::getLastBroadcastTime(const QUuid& nodeUUID) const {
     // return the matching PacketSequenceNumber, or the default if we don't have it
     auto nodeMatch = _lastBroadcastTimes.find(nodeUUID);
@@ -126,8 +156,19 @@ void AvatarMixerClientData::removeFromRadiusIgnoringSet(SharedNodePointer self,
     }
 }
 
+// views that moved less than this keep the sort priorities computed against them
+static bool isSimilarForSorting(const ConicalViewFrustum& a, const ConicalViewFrustum& b) {
+    const float MAX_POSITION_SLOP_SQUARED = 0.0025f; // 5 cm squared
+    const float MIN_DIRECTION_COSINE = 0.9998f; // ~1 degree
+
+    return glm::distance2(a.getPosition(), b.getPosition()) < MAX_POSITION_SLOP_SQUARED &&
+        glm::dot(a.getDirection(), b.getDirection()) > MIN_DIRECTION_COSINE &&
+        a.getAngle() == b.getAngle() && a.getRadius() == b.getRadius();
+}
+
 void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
-    _currentViewFrustums.clear();
+    ConicalViewFrustums previousViewFrustums;
+    previousViewFrustums.swap(_currentViewFrustums);
 
     auto sourceBuffer = reinterpret_cast<const unsigned char*>(message.constData());
     
@@ -141,6 +182,16 @@ void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
 
         _currentViewFrustums.push_back(frustum);
     }
+
+    bool isSimilar = previousViewFrustums.size() == _currentViewFrustums.size() &&
+        std::equal(previousViewFrustums.cbegin(), previousViewFrustums.cend(), _currentViewFrustums.cbegin(),
+                   isSimilarForSorting);
+    if (isSimilar) {
+        // keep the views the priorities were computed against, so that slow drift still adds up to a change
+        _currentViewFrustums.swap(previousViewFrustums);
+    } else if (++_viewFrustumsVersion == 0) {
+        _viewFrustumsVersion = 1;
+    }
 }
 
 bool AvatarMixerClientData::otherAvatarInView(const AABox& otherAvatarBox) {
@@ -16,6 +16,7 @@
 #include <cfloat>
 #include <unordered_map>
 #include <unordered_set>
+#include <mutex>
 #include <queue>
 
 #include <QtCore/QJsonObject>
@@ -33,6 +34,26 @@
 const QString OUTBOUND_AVATAR_DATA_STATS_KEY = "outbound_av_data_kbps";
 const QString INBOUND_AVATAR_DATA_STATS_KEY = "inbound_av_data_kbps";
 
+// sort priority of an other avatar relative to the views of a receiving node
+//   Only the age term of the priority changes from frame to frame, so the rest is kept until either
+//   the other avatar moves or the views of the receiving node change.
+struct OtherAvatarPriority {
+    glm::vec3 position; // position of the other avatar when the priority was computed
+    float basePriority { 0.0f }; // priority, without the age term
+    float ageWeight { 0.0f }; // priority per usec since the last encode
+    uint32_t viewFrustumsVersion { 0 }; // 0 is never a valid version, so new entries are always computed
+
+    float getPriority(uint64_t lastEncodeTime, uint64_t now) const {
+        return basePriority + ageWeight * (float)(now - lastEncodeTime);
+    }
+};
+
+// an encoding of an avatar that is the same for every receiver
+struct EncodedAvatarData {
+    QByteArray bytes;
+    QVector<JointData> sentJoints; // the joints carried by bytes, as a receiver's last sent joints
+};
+
 class AvatarMixerClientData : public NodeData {
     Q_OBJECT
 public:
@@ -57,6 +78,7 @@ public:
     Q_INVOKABLE void cleanupKilledNode(const QUuid& nodeUUID) {
         removeLastBroadcastSequenceNumber(nodeUUID);
         removeLastBroadcastTime(nodeUUID);
+        _otherAvatarPriorities.erase(nodeUUID);
     }
 
     uint16_t getLastReceivedSequenceNumber() const { return _lastReceivedSequenceNumber; }
@@ -111,12 +133,22 @@ public:
     void setRequestsDomainListData(bool requesting) { _requestsDomainListData = requesting; }
 
     const ConicalViewFrustums& getViewFrustums() const { return _currentViewFrustums; }
+    uint32_t getViewFrustumsVersion() const { return _viewFrustumsVersion; }
+
+    OtherAvatarPriority& getOtherAvatarPriority(const QUuid& otherAvatar) { return _otherAvatarPriorities[otherAvatar]; }
 
     uint64_t getLastOtherAvatarEncodeTime(QUuid otherAvatar) const;
     void setLastOtherAvatarEncodeTime(const QUuid& otherAvatar, uint64_t time);
 
     QVector<JointData>& getLastOtherAvatarSentJoints(QUuid otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
 
+    // encodings of this avatar shared by all receivers, until the next AvatarData packet changes it
+    //   these are thread-safe, so that slaves broadcasting to different receivers can share encodings
+    bool findEncodedAvatarData(AvatarData::AvatarDataDetail detail, AvatarDataPacket::HasFlags flags,
+                               bool dropFaceTracking, EncodedAvatarData& encoded) const;
+    void cacheEncodedAvatarData(AvatarData::AvatarDataDetail detail, AvatarDataPacket::HasFlags flags,
+                                bool dropFaceTracking, const EncodedAvatarData& encoded) const;
+
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(); // returns number of packets processed
 
@@ -137,6 +169,9 @@ private:
     std::unordered_map<QUuid, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<QUuid, QVector<JointData>> _lastOtherAvatarSentJoints;
 
+    mutable std::mutex _encodedAvatarDataMutex;
+    mutable std::unordered_map<uint32_t, EncodedAvatarData> _encodedAvatarData; // guarded by _encodedAvatarDataMutex
+
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
     bool _avatarSkeletonModelUrlMustChange{ false };
@@ -151,6 +186,8 @@ private:
     SimpleMovingAverage _avgOtherAvatarDataRate;
     std::unordered_set<QUuid> _radiusIgnoredOthers;
     ConicalViewFrustums _currentViewFrustums;
+    uint32_t _viewFrustumsVersion { 1 }; // bumped when the views move enough to change the sort priorities
+    std::unordered_map<QUuid, OtherAvatarPriority> _otherAvatarPriorities;
 
     int _recentOtherAvatarsInView { 0 };
     int _recentOtherAvatarsOutOfView { 0 };
@@ -12,6 +12,7 @@
 #include "AvatarMixerSlave.h"
 
 #include <algorithm>
+#include <limits>
 #include <random>
 
 #include <glm/glm.hpp>
@@ -24,7 +25,6 @@
 #include <NodeList.h>
 #include <Node.h>
 #include <OctreeConstants.h>
-#include <PrioritySortUtil.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <StDev.h>
@@ -40,12 +40,21 @@ void AvatarMixerSlave::configure(ConstIter begin, ConstIter end) {
 
 void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end, 
                                 p_high_resolution_clock::time_point lastFrameTimestamp,
-                                float maxKbpsPerNode, float throttlingRatio) {
+                                float maxKbpsPerNode, float throttlingRatio, uint64_t timeBudgetPerNode) {
     _begin = begin;
     _end = end;
     _lastFrameTimestamp = lastFrameTimestamp;
     _maxKbpsPerNode = maxKbpsPerNode;
     _throttlingRatio = throttlingRatio;
+    _timeBudgetPerNode = timeBudgetPerNode;
+
+    // gather the agents that have avatar data once, rather than once per receiving agent
+    _avatarNodes.clear();
+    std::for_each(_begin, _end, [&](const SharedNodePointer& otherNode) {
+        if (otherNode->getType() == NodeType::Agent && otherNode->getLinkedData()) {
+            _avatarNodes.push_back(otherNode);
+        }
+    });
 }
 
 void AvatarMixerSlave::harvestStats(AvatarMixerSlaveStats& stats) {
@@ -95,6 +104,52 @@ int AvatarMixerSlave::sendReplicatedIdentityPacket(const Node& agentNode, const
 
 static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
+// other avatars that moved less than this (relative to their distance to the receiver) keep their sort priority
+static const float PRIORITY_POSITION_SLOP = 0.05f;
+static const float PRIORITY_RELATIVE_POSITION_SLOP = 0.02f;
+
+// compute the parts of the sort priority that do not depend on time, following PrioritySortUtil::PriorityQueue
+static void computeOtherAvatarPriority(const ConicalViewFrustums& views, const AvatarData& otherAvatar,
+                                       uint64_t age, OtherAvatarPriority& priority) {
+    glm::vec3 position = otherAvatar.getWorldPosition();
+    glm::vec3 halfScale = position - otherAvatar.getGlobalBoundingBoxCorner() * otherAvatar.getSensorToWorldScale();
+    float otherRadius = glm::max(halfScale.x, glm::max(halfScale.y, halfScale.z));
+
+    priority.position = position;
+    priority.basePriority = std::numeric_limits<float>::lowest();
+    priority.ageWeight = 0.0f;
+
+    float bestPriority = std::numeric_limits<float>::lowest();
+    for (const auto& view : views) {
+        glm::vec3 offset = position - view.getPosition();
+        float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
+        const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
+        float radius = glm::min(otherRadius, MIN_RADIUS);
+        float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
+
+        const float MIN_COSINE_ANGLE_FACTOR = 0.1f;
+        float ageWeight = AvatarData::_avatarSortCoefficientAge * glm::max(cosineAngle, MIN_COSINE_ANGLE_FACTOR);
+        float basePriority = AvatarData::_avatarSortCoefficientSize * glm::max(radius, MIN_RADIUS) / distance
+            + AvatarData::_avatarSortCoefficientCenter * cosineAngle;
+
+        // decrement priority of things outside keyhole
+        if (distance - radius > view.getRadius()) {
+            if (!view.intersects(offset, distance, radius)) {
+                constexpr float OUT_OF_VIEW_PENALTY = -10.0f;
+                basePriority += OUT_OF_VIEW_PENALTY;
+            }
+        }
+
+        // the view that ranks the avatar highest now is kept until the priority is next computed
+        float viewPriority = basePriority + ageWeight * (float)age;
+        if (viewPriority > bestPriority) {
+            bestPriority = viewPriority;
+            priority.basePriority = basePriority;
+            priority.ageWeight = ageWeight;
+        }
+    }
+}
+
 void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
     quint64 start = usecTimestampNow();
 
@@ -108,10 +163,58 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
     _stats.jobElapsedTime += (end - start);
 }
 
+QByteArray AvatarMixerSlave::encodeAvatarData(const AvatarMixerClientData* nodeData, AvatarData::AvatarDataDetail detail,
+                                          quint64 lastSentTime, const QVector<JointData>& lastSentJoints,
+                                          bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
+                                          QVector<JointData>* sentJointsOut) {
+    quint64 start = usecTimestampNow();
+    const AvatarData* avatar = nodeData->getConstAvatarData();
+    AvatarDataPacket::HasFlags hasFlagsOut;
+
+    // culled joint data depends on the joints last sent to (and the distance of) the receiver, so it is not shared
+    if (detail == AvatarData::CullSmallData || detail == AvatarData::IncludeSmallData) {
+        QByteArray bytes = avatar->toByteArray(detail, lastSentTime, lastSentJoints, hasFlagsOut, dropFaceTracking,
+                                               distanceAdjust, viewerPosition, sentJointsOut);
+        quint64 end = usecTimestampNow();
+        _stats.toByteArrayElapsedTime += (end - start);
+        _stats.toByteArrayPerReceiverElapsedTime += (end - start);
+        return bytes;
+    }
+
+    // other detail levels only depend on which sections changed since the receiver was last sent this avatar
+    AvatarDataPacket::HasFlags flags = avatar->getHasFlags(detail, lastSentTime, dropFaceTracking);
+    EncodedAvatarData encoded;
+    bool isCached = nodeData->findEncodedAvatarData(detail, flags, dropFaceTracking, encoded);
+    if (!isCached) {
+        encoded.bytes = avatar->toByteArray(detail, lastSentTime, lastSentJoints, hasFlagsOut, dropFaceTracking,
+                                            false, glm::vec3(0), &encoded.sentJoints);
+        nodeData->cacheEncodedAvatarData(detail, flags, dropFaceTracking, encoded);
+    }
+
+    // like toByteArray, only touch the sent joints if joint data was included
+    if (sentJointsOut && (flags & AvatarDataPacket::PACKET_HAS_JOINT_DATA)) {
+        *sentJointsOut = encoded.sentJoints;
+    }
+
+    quint64 end = usecTimestampNow();
+    _stats.toByteArrayElapsedTime += (end - start);
+    if (isCached) {
+        _stats.encodeCacheHits++;
+        _stats.toByteArrayCacheHitElapsedTime += (end - start);
+    } else {
+        _stats.encodeCacheMisses++;
+        _stats.toByteArrayCacheMissElapsedTime += (end - start);
+    }
+    return encoded.bytes;
+}
+
 void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node) {
 
     auto nodeList = DependencyManager::get<NodeList>();
 
+    // past this time, other avatars are sent with the bare minimum data
+    uint64_t timeBudgetEnd = usecTimestampNow() + _timeBudgetPerNode;
+
     // setup for distributed random floating point values
     std::random_device randomDevice;
     std::mt19937 generator(randomDevice());
@@ -183,55 +286,15 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     nodeBox.embiggen(4.0f);
 
 
-    // setup list of AvatarData as well as maps to map betweeen the AvatarData and the original nodes
-    std::vector<AvatarSharedPointer> avatarsToSort;
-    std::unordered_map<AvatarSharedPointer, SharedNodePointer> avatarDataToNodes;
-    std::unordered_map<QUuid, uint64_t> avatarEncodeTimes;
-    std::for_each(_begin, _end, [&](const SharedNodePointer& otherNode) {
-        // make sure this is an agent that we have avatar data for before considering it for inclusion
-        if (otherNode->getType() == NodeType::Agent
-            && otherNode->getLinkedData()) {
-            const AvatarMixerClientData* otherNodeData = reinterpret_cast<const AvatarMixerClientData*>(otherNode->getLinkedData());
-
-            AvatarSharedPointer otherAvatar = otherNodeData->getAvatarSharedPointer();
-            avatarsToSort.push_back(otherAvatar);
-            avatarDataToNodes[otherAvatar] = otherNode;
-            QUuid id = otherAvatar->getSessionUUID();
-            avatarEncodeTimes[id] = nodeData->getLastOtherAvatarEncodeTime(id);
-        }
-    });
-
-    class SortableAvatar: public PrioritySortUtil::Sortable {
-    public:
-        SortableAvatar() = delete;
-        SortableAvatar(const AvatarSharedPointer& avatar, uint64_t lastEncodeTime)
-            : _avatar(avatar), _lastEncodeTime(lastEncodeTime) {}
-        glm::vec3 getPosition() const override { return _avatar->getWorldPosition(); }
-        float getRadius() const override {
-            glm::vec3 nodeBoxHalfScale = (_avatar->getWorldPosition() - _avatar->getGlobalBoundingBoxCorner() * _avatar->getSensorToWorldScale());
-            return glm::max(nodeBoxHalfScale.x, glm::max(nodeBoxHalfScale.y, nodeBoxHalfScale.z));
-        }
-        uint64_t getTimestamp() const override {
-            return _lastEncodeTime;
-        }
-        AvatarSharedPointer getAvatar() const { return _avatar; }
-
-    private:
-        AvatarSharedPointer _avatar;
-        uint64_t _lastEncodeTime;
-    };
-
     // prepare to sort
     const auto& cameraViews = nodeData->getViewFrustums();
-    PrioritySortUtil::PriorityQueue<SortableAvatar> sortedAvatars(cameraViews,
-            AvatarData::_avatarSortCoefficientSize,
-            AvatarData::_avatarSortCoefficientCenter,
-            AvatarData::_avatarSortCoefficientAge);
+    uint32_t viewFrustumsVersion = nodeData->getViewFrustumsVersion();
+    uint64_t sortTime = usecTimestampNow();
+    _sortedAvatars.clear();
 
     // ignore or sort
-    const AvatarSharedPointer& thisAvatar = nodeData->getAvatarSharedPointer();
-    for (const auto& avatar : avatarsToSort) {
-        if (avatar == thisAvatar) {
+    for (const auto& avatarNode : _avatarNodes) {
+        if (avatarNode == node) {
             // don't echo updates to self
             continue;
         }
@@ -243,9 +306,6 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         //      happen if for example the avatar is connected on a desktop and sending
         //      updates at ~30hz. So every 3 frames we skip a frame.
 
-        auto avatarNode = avatarDataToNodes[avatar];
-        assert(avatarNode); // we can't have gotten here without the avatarData being a valid key in the map
-
         const AvatarMixerClientData* avatarNodeData = reinterpret_cast<const AvatarMixerClientData*>(avatarNode->getLinkedData());
         assert(avatarNodeData); // we can't have gotten here without avatarNode having valid data
         quint64 startIgnoreCalculation = usecTimestampNow();
@@ -312,31 +372,43 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         _stats.ignoreCalculationElapsedTime += (endIgnoreCalculation - startIgnoreCalculation);
 
         if (!shouldIgnore) {
-            // sort this one for later
-            uint64_t lastEncodeTime = 0;
-            std::unordered_map<QUuid, uint64_t>::const_iterator itr = avatarEncodeTimes.find(avatar->getSessionUUID());
-            if (itr != avatarEncodeTimes.end()) {
-                lastEncodeTime = itr->second;
+            // sort this one for later, only recomputing its priority if it moved or our views changed
+            const AvatarData& otherAvatar = *avatarNodeData->getConstAvatarData();
+            uint64_t lastEncodeTime = nodeData->getLastOtherAvatarEncodeTime(avatarNode->getUUID());
+            OtherAvatarPriority& priority = nodeData->getOtherAvatarPriority(avatarNode->getUUID());
+
+            glm::vec3 otherPosition = otherAvatar.getWorldPosition();
+            float positionSlop = std::max(PRIORITY_POSITION_SLOP,
+                PRIORITY_RELATIVE_POSITION_SLOP * glm::distance(otherPosition, myPosition));
+            if (priority.viewFrustumsVersion != viewFrustumsVersion ||
+                    glm::distance2(otherPosition, priority.position) > positionSlop * positionSlop) {
+                computeOtherAvatarPriority(cameraViews, otherAvatar, sortTime - lastEncodeTime, priority);
+                priority.viewFrustumsVersion = viewFrustumsVersion;
             }
-            sortedAvatars.push(SortableAvatar(avatar, lastEncodeTime));
+
+            _sortedAvatars.push_back({ priority.getPriority(lastEncodeTime, sortTime), avatarNode });
         }
     }
 
+    std::sort(_sortedAvatars.begin(), _sortedAvatars.end(), [](const SortedAvatar& a, const SortedAvatar& b) {
+        return a.priority > b.priority;
+    });
+
     // loop through our sorted avatars and allocate our bandwidth to them accordingly
 
-    int remainingAvatars = (int)sortedAvatars.size();
-    while (!sortedAvatars.empty()) {
-        const auto avatarData = sortedAvatars.top().getAvatar();
-        sortedAvatars.pop();
+    int remainingAvatars = (int)_sortedAvatars.size();
+    for (const auto& sortedAvatar : _sortedAvatars) {
+        const SharedNodePointer& otherNode = sortedAvatar.node;
         remainingAvatars--;
 
-        auto otherNode = avatarDataToNodes[avatarData];
-        assert(otherNode); // we can't have gotten here without the avatarData being a valid key in the map
-
         // NOTE: Here's where we determine if we are over budget and drop to bare minimum data
         int minimRemainingAvatarBytes = minimumBytesPerAvatar * remainingAvatars;
         bool overBudget = (identityBytesSent + numAvatarDataBytes + minimRemainingAvatarBytes) > maxAvatarBytesPerFrame;
 
+        // once our share of the frame time is spent, the lowest priority avatars are sent with the bare minimum data
+        // their age keeps growing, so they sort higher on the next frame
+        bool overTimeBudget = !overBudget && usecTimestampNow() > timeBudgetEnd;
+
         quint64 startAvatarDataPacking = usecTimestampNow();
 
         ++numOtherAvatars;
@@ -369,6 +441,9 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             overBudgetAvatars++;
             _stats.overBudgetAvatars++;
             detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::NoData;
+        } else if (overTimeBudget) {
+            _stats.overTimeBudgetAvatars++;
+            detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::NoData;
         } else if (!isInView) {
             detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::MinimumData;
             nodeData->incrementAvatarOutOfView();
@@ -386,27 +461,23 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
         bool distanceAdjust = true;
         glm::vec3 viewerPosition = myPosition;
-        AvatarDataPacket::HasFlags hasFlagsOut; // the result of the toByteArray
         bool dropFaceTracking = false;
 
-        quint64 start = usecTimestampNow();
-        QByteArray bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                                                    hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
-        quint64 end = usecTimestampNow();
-        _stats.toByteArrayElapsedTime += (end - start);
+        QByteArray bytes = encodeAvatarData(otherNodeData, detail, lastEncodeForOther, lastSentJointsForOther,
+                                            dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
 
         static const int MAX_ALLOWED_AVATAR_DATA = (1400 - NUM_BYTES_RFC4122_UUID);
         if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
             qCWarning(avatars) << "otherAvatar.toByteArray() resulted in very large buffer:" << bytes.size() << "... attempt to drop facial data";
 
             dropFaceTracking = true; // first try dropping the facial data
-            bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                                             hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+            bytes = encodeAvatarData(otherNodeData, detail, lastEncodeForOther, lastSentJointsForOther,
+                                     dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
 
             if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
                 qCWarning(avatars) << "otherAvatar.toByteArray() without facial data resulted in very large buffer:" << bytes.size() << "... reduce to MinimumData";
-                bytes = otherAvatar->toByteArray(AvatarData::MinimumData, lastEncodeForOther, lastSentJointsForOther,
-                                                 hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+                bytes = encodeAvatarData(otherNodeData, AvatarData::MinimumData, lastEncodeForOther, lastSentJointsForOther,
+                                         dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
 
                 if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
                     qCWarning(avatars) << "otherAvatar.toByteArray() MinimumData resulted in very large buffer:" << bytes.size() << "... FAIL!!";
@@ -440,6 +511,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         quint64 endAvatarDataPacking = usecTimestampNow();
         _stats.avatarDataPackingElapsedTime += (endAvatarDataPacking - startAvatarDataPacking);
     }
+    _sortedAvatars.clear();
 
     quint64 startPacketSending = usecTimestampNow();
 
@@ -500,14 +572,11 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
             // so we always send a full update for this avatar
             
             quint64 start = usecTimestampNow();
-            AvatarDataPacket::HasFlags flagsOut;
 
             QVector<JointData> emptyLastJointSendData { otherAvatar->getJointCount() };
 
-            QByteArray avatarByteArray = otherAvatar->toByteArray(AvatarData::SendAllData, 0, emptyLastJointSendData,
-                                                                  flagsOut, false, false, glm::vec3(0), nullptr);
-            quint64 end = usecTimestampNow();
-            _stats.toByteArrayElapsedTime += (end - start);
+            QByteArray avatarByteArray = encodeAvatarData(agentNodeData, AvatarData::SendAllData, 0, emptyLastJointSendData,
+                                                          false, false, glm::vec3(0), nullptr);
 
             auto lastBroadcastTime = nodeData->getLastBroadcastTime(agentNode->getUUID());
             if (lastBroadcastTime <= agentNodeData->getIdentityChangeTimestamp()
@@ -530,15 +599,15 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
                 qCWarning(avatars) << "Replicated avatar data too large for" << otherAvatar->getSessionUUID()
                     << "-" << avatarByteArray.size() << "bytes";
 
-                avatarByteArray = otherAvatar->toByteArray(AvatarData::SendAllData, 0, emptyLastJointSendData,
-                                                           flagsOut, true, false, glm::vec3(0), nullptr);
+                avatarByteArray = encodeAvatarData(agentNodeData, AvatarData::SendAllData, 0, emptyLastJointSendData,
+                                                   true, false, glm::vec3(0), nullptr);
 
                 if (avatarByteArray.size() > maxAvatarByteArraySize) {
                     qCWarning(avatars) << "Replicated avatar data without facial data still too large for"
                         << otherAvatar->getSessionUUID() << "-" << avatarByteArray.size() << "bytes";
 
-                    avatarByteArray = otherAvatar->toByteArray(AvatarData::MinimumData, 0, emptyLastJointSendData,
-                                                               flagsOut, true, false, glm::vec3(0), nullptr);
+                    avatarByteArray = encodeAvatarData(agentNodeData, AvatarData::MinimumData, 0, emptyLastJointSendData,
+                                                       true, false, glm::vec3(0), nullptr);
                 }
             }
 
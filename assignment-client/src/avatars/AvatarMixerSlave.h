@@ -12,6 +12,7 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <AvatarData.h>
 #include <NodeList.h>
 
 class AvatarMixerClientData;
@@ -29,6 +30,7 @@ public:
     int numIdentityPackets { 0 };
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
+    int overTimeBudgetAvatars { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -36,6 +38,13 @@ public:
     quint64 toByteArrayElapsedTime { 0 };
     quint64 jobElapsedTime { 0 };
 
+    // encodings shared across receivers, see AvatarMixerClientData::findEncodedAvatarData
+    int encodeCacheHits { 0 };
+    int encodeCacheMisses { 0 };
+    quint64 toByteArrayCacheHitElapsedTime { 0 };
+    quint64 toByteArrayCacheMissElapsedTime { 0 };
+    quint64 toByteArrayPerReceiverElapsedTime { 0 }; // encodings that depend on the receiver
+
     void reset() {
         // receiving job stats
         nodesProcessed = 0;
@@ -50,12 +59,19 @@ public:
         numIdentityPackets = 0;
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
+        overTimeBudgetAvatars = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
         packetSendingElapsedTime = 0;
         toByteArrayElapsedTime = 0;
         jobElapsedTime = 0;
+
+        encodeCacheHits = 0;
+        encodeCacheMisses = 0;
+        toByteArrayCacheHitElapsedTime = 0;
+        toByteArrayCacheMissElapsedTime = 0;
+        toByteArrayPerReceiverElapsedTime = 0;
     }
 
     AvatarMixerSlaveStats& operator+=(const AvatarMixerSlaveStats& rhs) {
@@ -70,12 +86,19 @@ public:
         numIdentityPackets += rhs.numIdentityPackets;
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
+        overTimeBudgetAvatars += rhs.overTimeBudgetAvatars;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
         packetSendingElapsedTime += rhs.packetSendingElapsedTime;
         toByteArrayElapsedTime += rhs.toByteArrayElapsedTime;
         jobElapsedTime += rhs.jobElapsedTime;
+
+        encodeCacheHits += rhs.encodeCacheHits;
+        encodeCacheMisses += rhs.encodeCacheMisses;
+        toByteArrayCacheHitElapsedTime += rhs.toByteArrayCacheHitElapsedTime;
+        toByteArrayCacheMissElapsedTime += rhs.toByteArrayCacheMissElapsedTime;
+        toByteArrayPerReceiverElapsedTime += rhs.toByteArrayPerReceiverElapsedTime;
         return *this;
     }
 
@@ -88,7 +111,7 @@ public:
     void configure(ConstIter begin, ConstIter end);
     void configureBroadcast(ConstIter begin, ConstIter end, 
                     p_high_resolution_clock::time_point lastFrameTimestamp, 
-                    float maxKbpsPerNode, float throttlingRatio);
+                    float maxKbpsPerNode, float throttlingRatio, uint64_t timeBudgetPerNode);
 
     void processIncomingPackets(const SharedNodePointer& node);
     void broadcastAvatarData(const SharedNodePointer& node);
@@ -99,9 +122,18 @@ private:
     int sendIdentityPacket(const AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode);
     int sendReplicatedIdentityPacket(const Node& agentNode, const AvatarMixerClientData* nodeData, const Node& destinationNode);
 
+    QByteArray encodeAvatarData(const AvatarMixerClientData* nodeData, AvatarData::AvatarDataDetail detail,
+                                quint64 lastSentTime, const QVector<JointData>& lastSentJoints, bool dropFaceTracking,
+                                bool distanceAdjust, glm::vec3 viewerPosition, QVector<JointData>* sentJointsOut);
+
     void broadcastAvatarDataToAgent(const SharedNodePointer& node);
     void broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node);
 
+    struct SortedAvatar {
+        float priority;
+        SharedNodePointer node;
+    };
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
@@ -109,6 +141,10 @@ private:
     p_high_resolution_clock::time_point _lastFrameTimestamp;
     float _maxKbpsPerNode { 0.0f };
     float _throttlingRatio { 0.0f };
+    uint64_t _timeBudgetPerNode { 0 };
+
+    std::vector<SharedNodePointer> _avatarNodes; // agents with avatar data, gathered once per frame
+    std::vector<SortedAvatar> _sortedAvatars; // reused across agents, to avoid reallocating
 
     AvatarMixerSlaveStats _stats;
 };
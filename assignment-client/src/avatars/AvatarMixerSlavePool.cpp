@@ -14,15 +14,29 @@
 #include <assert.h>
 #include <algorithm>
 
+using namespace std::chrono;
+
 void AvatarMixerSlaveThread::run() {
     while (true) {
         wait();
 
+        // packets sent during the frame are batched, and sent together once this slave is out of jobs
+        auto nodeList = DependencyManager::get<NodeList>();
+        nodeList->beginSendBatch();
+
         // iterate over all available nodes
+        auto start = p_high_resolution_clock::now();
         SharedNodePointer node;
-        while (try_pop(node)) {
+        int job;
+        while (try_pop(node, job)) {
+            auto jobStart = p_high_resolution_clock::now();
             (this->*_function)(node);
+            finish(job, duration_cast<microseconds>(p_high_resolution_clock::now() - jobStart).count());
         }
+        node.reset();
+
+        nodeList->flushSendBatch();
+        _busyUsecs = duration_cast<microseconds>(p_high_resolution_clock::now() - start).count();
 
         bool stopping = _stop;
         notify(stopping);
@@ -59,8 +73,12 @@ void AvatarMixerSlaveThread::notify(bool stopping) {
     _pool._poolCondition.notify_one();
 }
 
-bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node, int& job) {
+    return _pool._scheduler->pop(_index, node, job);
+}
+
+void AvatarMixerSlaveThread::finish(int job, uint64_t costUsecs) {
+    _pool._scheduler->finish(job, costUsecs);
 }
 
 #ifdef AVATAR_SINGLE_THREADED
@@ -72,20 +90,21 @@ void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end
     _configure = [=](AvatarMixerSlave& slave) { 
         slave.configure(begin, end);
     };
-    run(begin, end);
+    run(begin, end, _packetsScheduler);
 }
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
                                                p_high_resolution_clock::time_point lastFrameTimestamp,
-                                               float maxKbpsPerNode, float throttlingRatio) {
+                                               float maxKbpsPerNode, float throttlingRatio,
+                                               uint64_t timeBudgetPerNode) {
     _function = &AvatarMixerSlave::broadcastAvatarData;
     _configure = [=](AvatarMixerSlave& slave) { 
-        slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio);
+        slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio, timeBudgetPerNode);
    };
-    run(begin, end);
+    run(begin, end, _broadcastScheduler);
 }
 
-void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end, SlaveJobScheduler& scheduler) {
     _begin = begin;
     _end = end;
 
@@ -95,15 +114,11 @@ void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
         _function(slave, node);
 });
 #else
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-#if defined(__clang__) && defined(Q_OS_LINUX)
-        _queue.push(node);
-#else
-        _queue.emplace(node);
-#endif
-    });
+    // deal the jobs
+    _scheduler = &scheduler;
+    _scheduler->schedule(_begin, _end, _numThreads);
 
+    auto start = p_high_resolution_clock::now();
     {
         Lock lock(_mutex);
 
@@ -119,8 +134,16 @@ void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
 
         assert(_numStarted == _numThreads);
     }
+    uint64_t runUsecs = duration_cast<microseconds>(p_high_resolution_clock::now() - start).count();
+
+    // a slave is idle from when it runs out of jobs to when the last slave finishes
+    for (int i = 0; i < _numThreads; ++i) {
+        uint64_t busyUsecs = std::min(_slaves[i]->_busyUsecs, runUsecs);
+        _timings[i].busyUsecs += busyUsecs;
+        _timings[i].idleUsecs += runUsecs - busyUsecs;
+    }
 
-    assert(_queue.empty());
+    _scheduler->harvest();
 #endif
 }
 
@@ -135,6 +158,12 @@ void AvatarMixerSlavePool::each(std::function<void(AvatarMixerSlave& slave)> fun
 #endif
 }
 
+std::vector<SlaveThreadTiming> AvatarMixerSlavePool::harvestThreadTimings() {
+    std::vector<SlaveThreadTiming> timings(_timings.size());
+    std::swap(timings, _timings);
+    return timings;
+}
+
 void AvatarMixerSlavePool::setNumThreads(int numThreads) {
     // clamp to allowed size
     {
@@ -168,7 +197,7 @@ void AvatarMixerSlavePool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AvatarMixerSlaveThread(*this);
+            auto slave = new AvatarMixerSlaveThread(*this, _numThreads + i);
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -207,6 +236,7 @@ void AvatarMixerSlavePool::resize(int numThreads) {
     }
 
     _numThreads = _numStarted = _numFinished = numThreads;
+    _timings.resize(numThreads);
     assert(_numThreads == (int)_slaves.size());
 #endif
 }
@@ -18,9 +18,9 @@
 
 #include <QThread>
 
-#include <TBBHelpers.h>
 #include <NodeList.h>
 
+#include "../SlaveJobScheduler.h"
 #include "AvatarMixerSlave.h"
 
 class AvatarMixerSlavePool;
@@ -32,7 +32,7 @@ class AvatarMixerSlaveThread : public QThread, public AvatarMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AvatarMixerSlaveThread(AvatarMixerSlavePool& pool) : _pool(pool) {}
+    AvatarMixerSlaveThread(AvatarMixerSlavePool& pool, int index) : _pool(pool), _index(index) {}
 
     void run() override final;
 
@@ -41,17 +41,19 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
+    bool try_pop(SharedNodePointer& node, int& job);
+    void finish(int job, uint64_t costUsecs);
 
     AvatarMixerSlavePool& _pool;
+    const int _index;
     void (AvatarMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
+    uint64_t _busyUsecs { 0 }; // time spent on jobs during the last run
     bool _stop { false };
 };
 
 // Slave pool for avatar mixers
 //   AvatarMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AvatarMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -65,23 +67,28 @@ public:
     // Jobs the slave pool can do...
     void processIncomingPackets(ConstIter begin, ConstIter end);
     void broadcastAvatarData(ConstIter begin, ConstIter end, 
-                    p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode, float throttlingRatio);
+                    p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode, float throttlingRatio,
+                    uint64_t timeBudgetPerNode);
 
     // iterate over all slaves
     void each(std::function<void(AvatarMixerSlave& slave)> functor);
 
+    // get the busy and idle time of each slave thread since the last harvest, and reset them
+    std::vector<SlaveThreadTiming> harvestThreadTimings();
+
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, SlaveJobScheduler& scheduler);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AvatarMixerSlaveThread>> _slaves;
 
     friend void AvatarMixerSlaveThread::wait();
     friend void AvatarMixerSlaveThread::notify(bool stopping);
-    friend bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node, int& job);
+    friend void AvatarMixerSlaveThread::finish(int job, uint64_t costUsecs);
 
     // synchronization state
     Mutex _mutex;
@@ -94,8 +101,13 @@ private:
     int _numFinished { 0 }; // guarded by _mutex
     int _numStopped { 0 }; // guarded by _mutex
 
+    // scheduling state, one scheduler per job type so that their cost estimates do not mix
+    SlaveJobScheduler _packetsScheduler;
+    SlaveJobScheduler _broadcastScheduler;
+    SlaveJobScheduler* _scheduler { &_broadcastScheduler };
+    std::vector<SlaveThreadTiming> _timings;
+
     // frame state
-    Queue _queue;
     ConstIter _begin;
     ConstIter _end;
 };
@@ -87,6 +87,9 @@ OctreePointer EntityServer::createTree() {
     EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
     tree->createRootElement();
     tree->addNewlyCreatedHook(this);
+    connect(tree.get(), &EntityTree::deletingEntity, this, [this](const EntityItemID& entityID) {
+        _encodeCache.remove(entityID);
+    }, Qt::DirectConnection);
     if (!_entitySimulation) {
         SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
         simpleSimulation->setEntityTree(tree);
@@ -326,6 +329,11 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
 
     startDynamicDomainVerification();
 
+    QString congestionControl;
+    if (readOptionString("congestionControl", settingsSectionObject, congestionControl)) {
+        DependencyManager::get<NodeList>()->setConnectionCongestionControl(congestionControl);
+    }
+
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
 
@@ -402,6 +410,10 @@ QString EntityServer::serverSubclassStats() {
     statsString += "<b>Entity Server Memory Statistics</b>\r\n";
     statsString += QString().sprintf("EntityTreeElement size... %ld bytes\r\n", sizeof(EntityTreeElement));
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
+    statsString += QString("     Encode cache size... %1 bytes, %2 hits, %3 misses\r\n")
+        .arg(locale.toString(_encodeCache.getSize()))
+        .arg(locale.toString(_encodeCache.getNumHits()))
+        .arg(locale.toString(_encodeCache.getNumMisses()));
     statsString += "\r\n\r\n";
 
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
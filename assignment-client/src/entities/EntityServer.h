@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "EntityEncodeCache.h"
 #include "EntityItem.h"
 #include "EntityServerConsts.h"
 #include "EntityTree.h"
@@ -60,6 +61,8 @@ public:
 
     virtual void aboutToFinish() override;
 
+    EntityEncodeCache& getEncodeCache() { return _encodeCache; }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -76,6 +79,7 @@ private slots:
 
 private:
     SimpleEntitySimulationPointer _entitySimulation;
+    EntityEncodeCache _encodeCache;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
     QReadWriteLock _viewerSendingStatsLock;
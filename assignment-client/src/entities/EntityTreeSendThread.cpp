@@ -23,6 +23,7 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
 {
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
+    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntity, this, &EntityTreeSendThread::deletingEntity, Qt::QueuedConnection);
 
     // connect to connection ID change on EntityNodeData so we can clear state for this receiver
     auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
@@ -34,6 +35,15 @@ void EntityTreeSendThread::resetState() {
 
     _knownState.clear();
     _traversal.reset();
+
+    // the client starts over without keyframes too
+    auto node = _node.toStrongRef();
+    if (node) {
+        auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
+        if (nodeData) {
+            nodeData->getTransformDeltaEncoder().clear();
+        }
+    }
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -45,6 +55,7 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
         // check if we have a JSON query with flags
         auto flags = jsonQuery[EntityJSONQueryProperties::FLAGS_PROPERTY].toObject();
+        nodeData->setWantsTransformDeltas(flags[EntityJSONQueryProperties::TRANSFORM_DELTAS_PROPERTY].toBool());
         if (!flags.isEmpty()) {
             // check the flags object for specific flags that require special pre-processing
 
@@ -343,6 +354,9 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     nodeData->stats.encodeStarted();
     auto entityNode = _node.toStrongRef();
     auto entityNodeData = static_cast<EntityNodeData*>(entityNode->getLinkedData());
+    auto& encodeCache = static_cast<EntityServer*>(_myServer)->getEncodeCache();
+    // the flags of the query aren't filters
+    bool hasFilters = jsonFilters.size() > (jsonFilters.contains(EntityJSONQueryProperties::FLAGS_PROPERTY) ? 1 : 0);
     while(!_sendQueue.empty()) {
         PrioritizedEntity queuedItem = _sendQueue.top();
         EntityItemPointer entity = queuedItem.getEntity();
@@ -354,11 +368,12 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
             bool entityPreviouslyMatchedFilter = entityNodeData->sentFilteredEntity(entityID);
 
             if (entityMatchesFilters || entityNodeData->isEntityFlaggedAsExtra(entityID) || entityPreviouslyMatchedFilter) {
-                if (!jsonFilters.isEmpty() && entityMatchesFilters) {
+                if (hasFilters && entityMatchesFilters) {
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
-                OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData);
+                OctreeElement::AppendState appendEntityState = encodeCache.appendEntityData(entity, _packetData, params,
+                                                                                            _extraEncodeData);
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
                     if (appendEntityState == OctreeElement::PARTIAL) {
@@ -418,3 +433,13 @@ void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity)
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
     _knownState.erase(entity);
 }
+
+void EntityTreeSendThread::deletingEntity(const EntityItemID& entityID) {
+    auto node = _node.toStrongRef();
+    if (node) {
+        auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
+        if (nodeData) {
+            nodeData->getTransformDeltaEncoder().remove(entityID);
+        }
+    }
+}
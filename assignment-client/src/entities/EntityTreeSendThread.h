@@ -61,6 +61,7 @@ private:
 private slots:
     void editingEntityPointer(const EntityItemPointer& entity);
     void deletingEntityPointer(EntityItem* entity);
+    void deletingEntity(const EntityItemID& entityID);
 };
 
 #endif // hifi_EntityTreeSendThread_h
@@ -34,6 +34,7 @@
 #include <QtCore/QDir>
 
 #include <OctreeDataUtils.h>
+#include <OctreeSnapshot.h>
 
 Q_LOGGING_CATEGORY(octree_server, "hifi.octree-server")
 
@@ -1051,6 +1052,12 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
         _persistAsFileType = "json.gz";
+        QString persistFileFormat;
+        if (readOptionString("persistFileFormat", settingsSectionObject, persistFileFormat)
+            && persistFileFormat == OctreeSnapshot::FILE_TYPE) {
+            _persistAsFileType = persistFileFormat;
+        }
+        qDebug() << "persistAsFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         readOptionInt(QString("persistInterval"), settingsSectionObject, _persistInterval);
@@ -1151,9 +1158,12 @@ void OctreeServer::domainSettingsRequestComplete() {
 
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
+    // the persist thread loads the most recent of the persist files, whatever its format
+    QString persistFilePath = findMostRecentFileExtension(_persistAbsoluteFilePath, PERSIST_EXTENSIONS);
+
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree_server) << "Reading octree data from" << _persistAbsoluteFilePath;
-    if (data.readOctreeDataInfoFromFile(_persistAbsoluteFilePath)) {
+    qCDebug(octree_server) << "Reading octree data from" << persistFilePath;
+    if (data.readOctreeDataInfoFromFile(persistFilePath)) {
         qCDebug(octree_server) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.version << ")";
         packet->writePrimitive(true);
         auto id = data.id.toRfc4122();
@@ -1183,19 +1193,27 @@ void OctreeServer::handleOctreeDataFileReply(QSharedPointer<ReceivedMessage> mes
     } else {
         qDebug() << "Got reply to octree data file request, current entity data is sufficient";
         
+        QString persistFilePath = findMostRecentFileExtension(_persistAbsoluteFilePath, PERSIST_EXTENSIONS);
+
         OctreeUtils::RawEntityData data;
-        qCDebug(octree_server) << "Reading octree data from" << _persistAbsoluteFilePath;
-        if (data.readOctreeDataInfoFromFile(_persistAbsoluteFilePath)) {
+        qCDebug(octree_server) << "Reading octree data from" << persistFilePath;
+        if (data.readOctreeDataInfoFromFile(persistFilePath)) {
             if (data.id.isNull()) {
                 qCDebug(octree_server) << "Current octree data has a null id, updating";
                 data.resetIdAndVersion();
 
-                QFile file(_persistAbsoluteFilePath);
-                if (file.open(QIODevice::WriteOnly)) {
+                // a snapshot is updated in place, rewriting it as JSON would drop its entities
+                bool isUpdated = OctreeSnapshot::writeVersionInfoToFile(persistFilePath, data.id, data.version);
+
+                QFile file(persistFilePath);
+                if (!isUpdated && file.open(QIODevice::WriteOnly)) {
                     auto entityData = data.toGzippedByteArray();
                     file.write(entityData);
                     file.close();
-                } else {
+                    isUpdated = true;
+                }
+
+                if (!isUpdated) {
                     qCDebug(octree_server) << "Failed to update octree data";
                 }
             }
@@ -1246,7 +1264,8 @@ void OctreeServer::beginRunning(QByteArray replaceData) {
             _persistAbsoluteFilePath.replace(ENTITY_PERSIST_EXTENSION, ENTITY_PERSIST_EXTENSION, Qt::CaseInsensitive);
         }
 
-        if (!QFile::exists(_persistAbsoluteFilePath)) {
+        // the persist file can also have been saved as a snapshot
+        if (!QFile::exists(findMostRecentFileExtension(_persistAbsoluteFilePath, PERSIST_EXTENSIONS))) {
             qDebug() << "Persist file does not exist, checking for existence of persist file next to application";
 
             static const QString OLD_DEFAULT_PERSIST_FILENAME = "resources/models.json.gz";
@@ -18,6 +18,10 @@ macro(TARGET_BULLET)
     else()
         add_dependency_external_projects(bullet)
         find_package(Bullet REQUIRED)
+        if (BULLET_NO_PROFILE)
+            # the external is built without its profiler, and its headers must agree
+            target_compile_definitions(${TARGET_NAME} PUBLIC BT_NO_PROFILE)
+        endif()
    endif()
     # perform the system include hack for OS X to ignore warnings
     if (APPLE)
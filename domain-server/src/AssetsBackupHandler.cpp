@@ -24,6 +24,8 @@
 #include <MappingRequest.h>
 #include <PathUtils.h>
 
+#include "BackupUtils.h"
+
 using namespace std;
 
 static const QString ASSETS_DIR { "/assets/" };
@@ -308,7 +310,7 @@ void AssetsBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip)
                     continue;
                 }
 
-                writeAssetFile(asset, zipFile.readAll());
+                writeAssetFile(asset, zipFile);
             }
         }
 
@@ -369,29 +371,22 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
         return;
     }
 
+    // assets are content addressed, so mappings that share a hash share a single file in the archive
+    std::set<AssetUtils::AssetHash> hashes;
     for (const auto& mapping : it->mappings) {
-        const auto& hash = mapping.second;
-
-        QDir assetsDir { _assetsDirectory };
-        QFile file { assetsDir.filePath(hash) };
-        if (!file.open(QFile::ReadOnly)) {
-            qCCritical(asset_backup) << "Could not open asset file" << file.fileName();
-            continue;
-        }
+        hashes.insert(mapping.second);
+    }
 
-        QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ZIP_ASSETS_FOLDER + "/" + hash))) {
-            qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
-            continue;
-        }
-        zipFile.write(file.readAll());
-        zipFile.close();
-        if (zipFile.getZipError() != UNZ_OK) {
-            qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
-            continue;
+    QDir assetsDir { _assetsDirectory };
+    ParallelZipWriter zipWriter { zip };
+    for (const auto& hash : hashes) {
+        if (!zipWriter.addFile(ZIP_ASSETS_FOLDER + "/" + hash, assetsDir.filePath(hash))) {
+            qCCritical(asset_backup) << "Could not open asset file" << assetsDir.filePath(hash);
         }
     }
-
+    if (!zipWriter.finish()) {
+        qCCritical(asset_backup) << "Could not add every asset of" << backupName << "to the consolidated backup";
+    }
 }
 
 void AssetsBackupHandler::refreshMappings() {
@@ -495,6 +490,25 @@ bool AssetsBackupHandler::writeAssetFile(const AssetUtils::AssetHash& hash, cons
     return true;
 }
 
+bool AssetsBackupHandler::writeAssetFile(const AssetUtils::AssetHash& hash, QIODevice& source) {
+    QDir assetsDir { _assetsDirectory };
+    QFile file { assetsDir.filePath(hash) };
+    if (!file.open(QFile::WriteOnly)) {
+        qCCritical(asset_backup) << "Could not open asset file for write:" << file.fileName();
+        return false;
+    }
+
+    if (!BackupUtils::copyData(source, file)) {
+        qCCritical(asset_backup) << "Could not write data to file" << file.fileName();
+        file.remove();
+        return false;
+    }
+
+    _assetsOnDisk.insert(hash);
+
+    return true;
+}
+
 void AssetsBackupHandler::computeServerStateDifference(const AssetUtils::Mappings& currentMappings,
                                                        const AssetUtils::Mappings& newMappings) {
     _mappingsLeftToSet.reserve((int)newMappings.size());
@@ -26,6 +26,8 @@
 
 #include "BackupHandler.h"
 
+class QIODevice;
+
 class AssetsBackupHandler : public QObject, public BackupHandlerInterface {
     Q_OBJECT
 
@@ -57,6 +59,7 @@ private:
     void downloadMissingFiles(const AssetUtils::Mappings& mappings);
     void downloadNextMissingFile();
     bool writeAssetFile(const AssetUtils::AssetHash& hash, const QByteArray& data);
+    bool writeAssetFile(const AssetUtils::AssetHash& hash, QIODevice& source);
 
     void computeServerStateDifference(const AssetUtils::Mappings& currentMappings,
                                       const AssetUtils::Mappings& newMappings);
@@ -0,0 +1,232 @@
+//
+//  BackupUtils.cpp
+//  domain-server/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BackupUtils.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QThread>
+
+#include <zlib.h>
+
+#include <quazip5/quazip.h>
+#include <quazip5/quazipfile.h>
+
+static const int STORED_METHOD = 0; // zip entries that aren't compressed
+static const int DEFLATE_MEMORY_LEVEL = 8; // zlib's default
+
+bool BackupUtils::copyData(QIODevice& source, QIODevice& destination) {
+    QByteArray buffer { (int)COPY_CHUNK_SIZE, Qt::Uninitialized };
+    while (true) {
+        auto bytesRead = source.read(buffer.data(), buffer.size());
+        if (bytesRead < 0) {
+            return false;
+        }
+        if (bytesRead == 0) {
+            return true;
+        }
+        if (destination.write(buffer.constData(), bytesRead) != bytesRead) {
+            return false;
+        }
+    }
+}
+
+bool BackupUtils::writeZipEntry(QuaZip& zip, const QuaZipNewInfo& info, QIODevice& source, bool compress) {
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::WriteOnly, info, nullptr, 0, compress ? Z_DEFLATED : STORED_METHOD)) {
+        qCritical().nospace() << "Failed to open " << info.name << " for writing in zip: " << zipFile.getZipError();
+        return false;
+    }
+
+    bool success = copyData(source, zipFile);
+    zipFile.close();
+    if (!success || zipFile.getZipError() != UNZ_OK) {
+        qCritical().nospace() << "Failed to zip " << info.name << ": " << zipFile.getZipError();
+        return false;
+    }
+    return true;
+}
+
+const qint64 ParallelZipWriter::DEFAULT_MAX_BYTES_IN_FLIGHT = 64 * 1024 * 1024;
+const qint64 ParallelZipWriter::MAX_PARALLEL_FILE_SIZE = 16 * 1024 * 1024;
+
+class DeflateTask : public QRunnable {
+public:
+    DeflateTask(ParallelZipWriter& writer, ParallelZipWriter::Entry entry) :
+        _writer(writer),
+        _entry(std::move(entry))
+    {
+    }
+
+    void run() override {
+        QFile file { _entry.filePath };
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Could not open" << _entry.filePath << "to zip";
+            _writer.entryReady(std::move(_entry));
+            return;
+        }
+        QByteArray data = file.readAll();
+        file.close();
+
+        _entry.uncompressedSize = data.size();
+        _entry.crc = crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(data.constData()), data.size());
+
+        // store files that don't get any smaller, like most compressed media, as they are
+        QByteArray deflated;
+        if (deflate(data, deflated) && deflated.size() < data.size()) {
+            _entry.data = deflated;
+            _entry.deflated = true;
+        } else {
+            _entry.data = data;
+        }
+        _entry.success = true;
+        _writer.entryReady(std::move(_entry));
+    }
+
+private:
+    // raw deflate, which is what zip entries hold
+    static bool deflate(const QByteArray& data, QByteArray& deflated) {
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, DEFLATE_MEMORY_LEVEL,
+                         Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+
+        deflated.resize((int)deflateBound(&stream, data.size()));
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+        stream.avail_in = data.size();
+        stream.next_out = reinterpret_cast<Bytef*>(deflated.data());
+        stream.avail_out = deflated.size();
+
+        bool success = ::deflate(&stream, Z_FINISH) == Z_STREAM_END;
+        deflated.resize(success ? (int)stream.total_out : 0);
+        deflateEnd(&stream);
+        return success;
+    }
+
+    ParallelZipWriter& _writer;
+    ParallelZipWriter::Entry _entry;
+};
+
+ParallelZipWriter::ParallelZipWriter(QuaZip& zip, qint64 maxBytesInFlight) :
+    _zip(zip),
+    _maxBytesInFlight(maxBytesInFlight)
+{
+    // leave a core for the domain server itself
+    _threadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+}
+
+ParallelZipWriter::~ParallelZipWriter() {
+    // the tasks hold on to this writer
+    _threadPool.waitForDone();
+}
+
+bool ParallelZipWriter::addFile(const QString& entryName, const QString& filePath) {
+    QFileInfo fileInfo { filePath };
+    if (!fileInfo.isFile() || !fileInfo.isReadable()) {
+        qCritical() << "Could not find" << filePath << "to zip";
+        return false;
+    }
+    auto size = fileInfo.size();
+
+    // write whatever is done already, so that it doesn't hold on to memory while this file is added
+    while (writeNextReadyEntry(false)) {
+    }
+
+    if (size > MAX_PARALLEL_FILE_SIZE || size > _maxBytesInFlight) {
+        QFile file { filePath };
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Could not open" << filePath << "to zip";
+            return false;
+        }
+        if (!BackupUtils::writeZipEntry(_zip, QuaZipNewInfo(entryName), file)) {
+            _success = false;
+        }
+        return true;
+    }
+
+    while (_numEntriesInFlight > 0 && _bytesInFlight + size > _maxBytesInFlight) {
+        writeNextReadyEntry(true);
+    }
+
+    Entry entry;
+    entry.entryName = entryName;
+    entry.filePath = filePath;
+    entry.reservedSize = size;
+    _bytesInFlight += size;
+    ++_numEntriesInFlight;
+    _threadPool.start(new DeflateTask(*this, std::move(entry)));
+    return true;
+}
+
+bool ParallelZipWriter::finish() {
+    while (_numEntriesInFlight > 0) {
+        writeNextReadyEntry(true);
+    }
+    return _success;
+}
+
+void ParallelZipWriter::entryReady(Entry entry) {
+    {
+        std::lock_guard<std::mutex> lock { _readyEntriesMutex };
+        _readyEntries.push_back(std::move(entry));
+    }
+    _readyEntriesCondition.notify_one();
+}
+
+bool ParallelZipWriter::writeNextReadyEntry(bool wait) {
+    Entry entry;
+    {
+        std::unique_lock<std::mutex> lock { _readyEntriesMutex };
+        if (wait) {
+            _readyEntriesCondition.wait(lock, [this] { return !_readyEntries.empty(); });
+        } else if (_readyEntries.empty()) {
+            return false;
+        }
+        entry = std::move(_readyEntries.front());
+        _readyEntries.pop_front();
+    }
+
+    if (!entry.success || !writeEntry(entry)) {
+        _success = false;
+    }
+
+    _bytesInFlight -= entry.reservedSize;
+    --_numEntriesInFlight;
+    return true;
+}
+
+bool ParallelZipWriter::writeEntry(const Entry& entry) {
+    QuaZipNewInfo info { entry.entryName };
+    info.uncompressedSize = entry.uncompressedSize;
+
+    // the data is already deflated, so it is written to the zip raw, with the checksum and size of the original
+    QuaZipFile zipFile { &_zip };
+    if (!zipFile.open(QIODevice::WriteOnly, info, nullptr, entry.crc, entry.deflated ? Z_DEFLATED : STORED_METHOD,
+                      Z_DEFAULT_COMPRESSION, true)) {
+        qCritical().nospace() << "Failed to open " << entry.entryName << " for writing in zip: " << zipFile.getZipError();
+        return false;
+    }
+
+    bool success = zipFile.write(entry.data) == entry.data.size();
+    zipFile.close();
+    if (!success || zipFile.getZipError() != UNZ_OK) {
+        qCritical().nospace() << "Failed to zip " << entry.entryName << ": " << zipFile.getZipError();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,93 @@
+//
+//  BackupUtils.h
+//  domain-server/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BackupUtils_h
+#define hifi_BackupUtils_h
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <QByteArray>
+#include <QString>
+#include <QThreadPool>
+
+#include <quazip5/quazipnewinfo.h>
+
+class QIODevice;
+class QuaZip;
+
+namespace BackupUtils {
+
+// Files are copied in chunks of this size, so that large assets are never held in memory whole
+const qint64 COPY_CHUNK_SIZE = 1024 * 1024;
+
+// Copy the rest of the source to the destination a chunk at a time
+bool copyData(QIODevice& source, QIODevice& destination);
+
+// Add the rest of the source to the zip as a new entry, a chunk at a time
+//   Data that is already compressed, like gzipped files, can be stored as it is rather than deflated again.
+bool writeZipEntry(QuaZip& zip, const QuaZipNewInfo& info, QIODevice& source, bool compress = true);
+
+}
+
+// Adds files to a zip, deflating them on a pool of threads
+//   Small files are read and deflated on the pool, then written to the zip as raw entries on the calling thread in
+//   the order they complete. The bytes of the files that are being deflated or are waiting to be written are capped,
+//   so that memory use stays bounded however large the backup is. Files too large to deflate in one go are streamed
+//   into the zip on the calling thread instead, while the pool keeps working on the others.
+class ParallelZipWriter {
+public:
+    static const qint64 DEFAULT_MAX_BYTES_IN_FLIGHT;
+    static const qint64 MAX_PARALLEL_FILE_SIZE;
+
+    ParallelZipWriter(QuaZip& zip, qint64 maxBytesInFlight = DEFAULT_MAX_BYTES_IN_FLIGHT);
+    ~ParallelZipWriter();
+
+    // returns false if the file could not be read, entries that fail to deflate or write are reported by finish
+    bool addFile(const QString& entryName, const QString& filePath);
+
+    // wait for the files in flight and write them, returns whether every entry was added to the zip
+    bool finish();
+
+    struct Entry {
+        QString entryName;
+        QString filePath;
+        qint64 reservedSize { 0 }; // of the file when it was added, counted against the bytes in flight
+        qint64 uncompressedSize { 0 };
+        bool success { false };
+        bool deflated { false };
+        quint32 crc { 0 };
+        QByteArray data;
+    };
+
+    // called by the deflate tasks
+    void entryReady(Entry entry);
+
+private:
+    // returns false if there was no entry ready and it didn't wait for one
+    bool writeNextReadyEntry(bool wait);
+    bool writeEntry(const Entry& entry);
+
+    QuaZip& _zip;
+    qint64 _maxBytesInFlight;
+    QThreadPool _threadPool;
+
+    std::mutex _readyEntriesMutex;
+    std::condition_variable _readyEntriesCondition;
+    std::deque<Entry> _readyEntries;
+
+    qint64 _bytesInFlight { 0 };
+    int _numEntriesInFlight { 0 };
+    bool _success { true };
+};
+
+#endif // hifi_BackupUtils_h
@@ -215,6 +215,8 @@ DomainServer::DomainServer(int argc, char* argv[]) :
             this, &DomainServer::updateDownstreamNodes);
     connect(&_settingsManager, &DomainServerSettingsManager::settingsUpdated,
             this, &DomainServer::updateUpstreamNodes);
+    connect(&_settingsManager, &DomainServerSettingsManager::settingsUpdated,
+            this, &DomainServer::updatePacketAuthenticationMethod);
 
     setupGroupCacheRefresh();
 
@@ -230,6 +232,7 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     updateReplicatedNodes();
     updateDownstreamNodes();
     updateUpstreamNodes();
+    updatePacketAuthenticationMethod();
 
     if (_type != NonMetaverse) {
         // if we have a metaverse domain, we'll use an access token for API calls
@@ -1115,7 +1118,7 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
 
 void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 
-        NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
+        NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4 + sizeof(quint8);
 
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
@@ -1129,6 +1132,7 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getLocalID();
     extendedHeaderStream << node->getPermissions();
+    extendedHeaderStream << (quint8)_packetAuthenticationMethod;
 
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
@@ -2891,6 +2895,19 @@ void DomainServer::updateUpstreamNodes() {
     updateReplicationNodes(Upstream);
 }
 
+void DomainServer::updatePacketAuthenticationMethod() {
+    static const QString PACKET_AUTHENTICATION_KEY_PATH = "security.packet_authentication";
+    static const QString SIPHASH_AUTHENTICATION = "siphash";
+
+    auto method = _settingsManager.valueOrDefaultValueForKeyPath(PACKET_AUTHENTICATION_KEY_PATH).toString();
+    auto newMethod = method == SIPHASH_AUTHENTICATION ? HMACAuth::SIPHASH : HMACAuth::MD5;
+
+    if (newMethod != _packetAuthenticationMethod) {
+        qDebug() << "Packets between nodes will be authenticated with" << (newMethod == HMACAuth::SIPHASH ? "SipHash" : "HMAC-MD5");
+        _packetAuthenticationMethod = newMethod;
+    }
+}
+
 void DomainServer::updateReplicatedNodes() {
     // Make sure we have downstream nodes in our list
     static const QString REPLICATED_USERS_KEY = "users";
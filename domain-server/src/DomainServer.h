@@ -125,6 +125,7 @@ private slots:
     void updateReplicatedNodes();
     void updateDownstreamNodes();
     void updateUpstreamNodes();
+    void updatePacketAuthenticationMethod();
 
     void tokenGrantFinished();
     void profileRequestFinished();
@@ -227,6 +228,8 @@ private:
 
     bool _isUsingDTLS;
 
+    HMACAuth::AuthMethod _packetAuthenticationMethod { HMACAuth::MD5 };
+
     QUrl _oauthProviderURL;
     QString _oauthClientID;
     QString _oauthClientSecret;
@@ -18,6 +18,8 @@
 
 #include <OctreeDataUtils.h>
 
+#include "BackupUtils.h"
+
 EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath) :
     _entitiesFilePath(entitiesFilePath),
     _entitiesReplacementFilePath(entitiesReplacementFilePath)
@@ -30,20 +32,10 @@ void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip)
     QFile entitiesFile { _entitiesFilePath };
 
     if (entitiesFile.open(QIODevice::ReadOnly)) {
-        QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
-            qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
-            return;
-        }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
+        // the entities file is gzipped already, so store it as it is rather than deflating it again
+        if (!BackupUtils::writeZipEntry(zip, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath), entitiesFile,
+                                        false)) {
             qCritical() << "Failed to write entities file to backup";
-            zipFile.close();
-            return;
-        }
-        zipFile.close();
-        if (zipFile.getZipError() != UNZ_OK) {
-            qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
         }
     }
 }
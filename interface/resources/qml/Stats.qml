@@ -223,6 +223,11 @@ Item {
                         text: "Processing: " + root.processing +
                               ", Pending: " + root.processingPending;
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Physics Queue: " + root.physicsObjectsToAdd + " to add, " +
+                              root.physicsObjectsToChange + " to change";
+                    }
                     StatText {
                         visible: root.expanded && root.downloadUrls.length > 0;
                         text: "Download URLs:"
@@ -72,6 +72,7 @@
 #include <VirtualPadManager.h>
 #include <DebugDraw.h>
 #include <DeferredLightingEffect.h>
+#include <EntityNodeData.h>
 #include <EntityScriptClient.h>
 #include <EntityScriptServerLogClient.h>
 #include <EntityScriptingInterface.h>
@@ -108,6 +109,7 @@
 #include <ui/OffscreenQmlSurfaceCache.h>
 #include <PathUtils.h>
 #include <PerfStat.h>
+#include <HullCache.h>
 #include <PhysicsEngine.h>
 #include <PhysicsHelpers.h>
 #include <plugins/CodecPlugin.h>
@@ -368,6 +370,7 @@ static const int THROTTLED_SIM_FRAME_PERIOD_MS = MSECS_PER_SECOND / THROTTLED_SI
 static const uint32_t INVALID_FRAME = UINT32_MAX;
 
 static const float PHYSICS_READY_RANGE = 3.0f; // how far from avatar to check for entities that aren't ready for simulation
+static const std::string HULL_CACHE_DIRNAME { "hull_cache" }; // relative to the application local data
 
 static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
 
@@ -4825,6 +4828,16 @@ void Application::loadSettings() {
         }
     }
 
+    // ask the entity server for deltas of the transforms of moving entities, rather than the full transforms
+    Setting::Handle<bool> entityTransformDeltas { "entityTransformDeltas", false };
+    if (entityTransformDeltas.get()) {
+        QJsonObject queryFlags;
+        queryFlags[EntityJSONQueryProperties::TRANSFORM_DELTAS_PROPERTY] = true;
+        QJsonObject queryJSONParameters;
+        queryJSONParameters[EntityJSONQueryProperties::FLAGS_PROPERTY] = queryFlags;
+        _octreeQuery.setJSONParameters(queryJSONParameters);
+    }
+
     getMyAvatar()->loadData();
     _settingsLoaded = true;
 }
@@ -4903,6 +4916,10 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    auto hullCache = std::make_shared<HullCache>(HULL_CACHE_DIRNAME);
+    hullCache->initialize();
+    _shapeManager.setHullCache(hullCache);
+    _shapeManager.setBuildShapesInBackground(true);
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
@@ -8064,6 +8081,10 @@ void Application::setShowBulletConstraintLimits(bool value) {
     _physicsEngine->setShowBulletConstraintLimits(value);
 }
 
+void Application::setParallelPhysicsSolver(bool value) {
+    _physicsEngine->setNumSolverThreads(value ? QThread::idealThreadCount() : 1);
+}
+
 void Application::startHMDStandBySession() {
     _autoSwitchDisplayModeSupportedHMDPlugin->startStandBySession();
 }
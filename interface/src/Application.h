@@ -252,6 +252,7 @@ public:
     bool isAboutToQuit() const { return _aboutToQuit; }
     bool isPhysicsEnabled() const { return _physicsEnabled; }
     PhysicsEnginePointer getPhysicsEngine() { return _physicsEngine; }
+    PhysicalEntitySimulationPointer getEntitySimulation() { return _entitySimulation; }
 
     // the isHMDMode is true whenever we use the interface from an HMD and not a standard flat display
     // rendering of several elements depend on that
@@ -477,6 +478,7 @@ private slots:
     void setShowBulletContactPoints(bool value);
     void setShowBulletConstraints(bool value);
     void setShowBulletConstraintLimits(bool value);
+    void setParallelPhysicsSolver(bool value);
 
 private:
     void init();
@@ -25,6 +25,7 @@
 #include <display-plugins/DisplayPlugin.h>
 #include <PathUtils.h>
 #include <SettingHandle.h>
+#include <ThreadSafeDynamicsWorld.h>
 #include <UserActivityLogger.h>
 #include <VrMenu.h>
 #include <ScriptEngines.h>
@@ -740,6 +741,10 @@ Menu::Menu() {
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletContactPoints, 0, false, qApp, SLOT(setShowBulletContactPoints(bool)));
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletConstraints, 0, false, qApp, SLOT(setShowBulletConstraints(bool)));
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletConstraintLimits, 0, false, qApp, SLOT(setShowBulletConstraintLimits(bool)));
+    QAction* parallelSolverAction = addCheckableActionToQMenuAndActionHash(physicsOptionsMenu,
+        MenuOption::PhysicsParallelSolver, 0, false, qApp, SLOT(setParallelPhysicsSolver(bool)));
+    // only builds with Bullet's profiler compiled out (BULLET_NO_PROFILE) can solve islands on several threads
+    parallelSolverAction->setEnabled(ThreadSafeDynamicsWorld::isParallelSolverSupported());
 
     // Developer > Ask to Reset Settings
     addCheckableActionToQMenuAndActionHash(developerMenu, MenuOption::AskToResetSettings, 0, false);
@@ -148,6 +148,7 @@ namespace MenuOption {
     const QString PhysicsShowBulletContactPoints = "Show Bullet Contact Points";
     const QString PhysicsShowBulletConstraints = "Show Bullet Constraints";
     const QString PhysicsShowBulletConstraintLimits = "Show Bullet Constraint Limits";
+    const QString PhysicsParallelSolver = "Solve Islands in Parallel";
     const QString PipelineWarnings = "Log Render Pipeline Warnings";
     const QString Preferences = "General...";
     const QString Quit =  "Quit";
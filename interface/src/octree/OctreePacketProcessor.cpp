@@ -55,7 +55,7 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
         
         if (piggybackBytes) {
             // construct a new packet from the piggybacked one
-            auto buffer = std::unique_ptr<char[]>(new char[piggybackBytes]);
+            auto buffer = udt::PacketBufferPool::allocate(piggybackBytes);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggybackBytes);
             
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggybackBytes, message->getSenderSockAddr());
@@ -251,6 +251,10 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(downloadsPending, ResourceCache::getPendingRequestCount());
         STAT_UPDATE(processing, DependencyManager::get<StatTracker>()->getStat("Processing").toInt());
         STAT_UPDATE(processingPending, DependencyManager::get<StatTracker>()->getStat("PendingProcessing").toInt());
+
+        auto entitySimulation = qApp->getEntitySimulation();
+        STAT_UPDATE(physicsObjectsToAdd, entitySimulation->getNumEntitiesToAddToPhysics());
+        STAT_UPDATE(physicsObjectsToChange, entitySimulation->getNumObjectsToChange());
         
 
         // See if the active download urls have changed
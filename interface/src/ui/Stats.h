@@ -90,6 +90,8 @@ class Stats : public QQuickItem {
     Q_PROPERTY(QStringList downloadUrls READ downloadUrls NOTIFY downloadUrlsChanged)
     STATS_PROPERTY(int, processing, 0)
     STATS_PROPERTY(int, processingPending, 0)
+    STATS_PROPERTY(int, physicsObjectsToAdd, 0)
+    STATS_PROPERTY(int, physicsObjectsToChange, 0)
     STATS_PROPERTY(int, triangles, 0)
     STATS_PROPERTY(int, quads, 0)
     STATS_PROPERTY(int, materialSwitches, 0)
@@ -1164,3 +1164,11 @@ void AudioHRTF::renderSilent(int16_t* input, float* output, int index, float azi
 
     _silentState = true;
 }
+
+void AudioHRTF::renderFadeOut(float* output, int index, int numFrames) {
+
+    static int16_t silentBlock[HRTF_BLOCK] = {};
+
+    // the state is stored after gain adjustment, and the crossfade to zero gain doesn't depend on it
+    renderSilent(silentBlock, output, index, _azimuthState, _distanceState, 0.0f, numFrames);
+}
@@ -50,6 +50,11 @@ public:
     //
     void renderSilent(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
+    //
+    // Fast path when the source is no longer rendered: fades out to silence from the last parameters
+    //
+    void renderFadeOut(float* output, int index, int numFrames);
+
     //
     // HRTF local gain adjustment in amplitude (1.0 == unity)
     //
@@ -227,45 +227,15 @@ QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dro
                         &_outboundDataRate);
 }
 
-QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
-    AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust,
-    glm::vec3 viewerPosition, QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut) const {
+AvatarDataPacket::HasFlags AvatarData::getHasFlags(AvatarDataDetail dataDetail, quint64 lastSentTime, bool dropFaceTracking) const {
+    if (dataDetail == NoData) {
+        return 0;
+    }
 
-    bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
     bool sendMinimum = (dataDetail == MinimumData);
     bool sendPALMinimum = (dataDetail == PALMinimum);
 
-    lazyInitHeadData();
-
-    // special case, if we were asked for no data, then just include the flags all set to nothing
-    if (dataDetail == NoData) {
-        AvatarDataPacket::HasFlags packetStateFlags = 0;
-        QByteArray avatarDataByteArray(reinterpret_cast<char*>(&packetStateFlags), sizeof(packetStateFlags));
-        return avatarDataByteArray;
-    }
-
-    // FIXME -
-    //
-    //    BUG -- if you enter a space bubble, and then back away, the avatar has wrong orientation until "send all" happens...
-    //      this is an iFrame issue... what to do about that?
-    //
-    //    BUG -- Resizing avatar seems to "take too long"... the avatar doesn't redraw at smaller size right away
-    //
-    // TODO consider these additional optimizations in the future
-    // 1) SensorToWorld - should we only send this for avatars with attachments?? - 20 bytes - 7.20 kbps
-    // 2) GUIID for the session change to 2byte index                   (savings) - 14 bytes - 5.04 kbps
-    // 3) Improve Joints -- currently we use rotational tolerances, but if we had skeleton/bone length data
-    //    we could do a better job of determining if the change in joints actually translates to visible
-    //    changes at distance.
-    //
-    //    Potential savings:
-    //              63 rotations   * 6 bytes = 136kbps
-    //              3 translations * 6 bytes = 6.48kbps
-    //
-
-    auto parentID = getParentID();
-
     bool hasAvatarGlobalPosition = true; // always include global position
     bool hasAvatarOrientation = false;
     bool hasAvatarBoundingBox = false;
@@ -305,18 +275,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         hasJointDefaultPoseFlags = hasJointData;
     }
 
-
-    const size_t byteArraySize = AvatarDataPacket::MAX_CONSTANT_HEADER_SIZE +
-        (hasFaceTrackerInfo ? AvatarDataPacket::maxFaceTrackerInfoSize(_headData->getNumSummedBlendshapeCoefficients()) : 0) +
-        (hasJointData ? AvatarDataPacket::maxJointDataSize(_jointData.size()) : 0) +
-        (hasJointDefaultPoseFlags ? AvatarDataPacket::maxJointDefaultPoseFlagsSize(_jointData.size()) : 0);
-
-    QByteArray avatarDataByteArray((int)byteArraySize, 0);
-    unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(avatarDataByteArray.data());
-    unsigned char* startPosition = destinationBuffer;
-
-    // Leading flags, to indicate how much data is actually included in the packet...
-    AvatarDataPacket::HasFlags packetStateFlags =
+    return
         (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
         | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
         | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
@@ -330,7 +289,71 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
         | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
         | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0);
+}
 
+QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
+    AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust,
+    glm::vec3 viewerPosition, QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut) const {
+
+    bool cullSmallChanges = (dataDetail == CullSmallData);
+    bool sendAll = (dataDetail == SendAllData);
+
+    lazyInitHeadData();
+
+    // special case, if we were asked for no data, then just include the flags all set to nothing
+    if (dataDetail == NoData) {
+        AvatarDataPacket::HasFlags packetStateFlags = 0;
+        QByteArray avatarDataByteArray(reinterpret_cast<char*>(&packetStateFlags), sizeof(packetStateFlags));
+        return avatarDataByteArray;
+    }
+
+    // FIXME -
+    //
+    //    BUG -- if you enter a space bubble, and then back away, the avatar has wrong orientation until "send all" happens...
+    //      this is an iFrame issue... what to do about that?
+    //
+    //    BUG -- Resizing avatar seems to "take too long"... the avatar doesn't redraw at smaller size right away
+    //
+    // TODO consider these additional optimizations in the future
+    // 1) SensorToWorld - should we only send this for avatars with attachments?? - 20 bytes - 7.20 kbps
+    // 2) GUIID for the session change to 2byte index                   (savings) - 14 bytes - 5.04 kbps
+    // 3) Improve Joints -- currently we use rotational tolerances, but if we had skeleton/bone length data
+    //    we could do a better job of determining if the change in joints actually translates to visible
+    //    changes at distance.
+    //
+    //    Potential savings:
+    //              63 rotations   * 6 bytes = 136kbps
+    //              3 translations * 6 bytes = 6.48kbps
+    //
+
+    auto parentID = getParentID();
+
+    AvatarDataPacket::HasFlags packetStateFlags = getHasFlags(dataDetail, lastSentTime, dropFaceTracking);
+
+    bool hasAvatarGlobalPosition = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION;
+    bool hasAvatarOrientation = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION;
+    bool hasAvatarBoundingBox = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX;
+    bool hasAvatarScale = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_SCALE;
+    bool hasLookAtPosition = packetStateFlags & AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION;
+    bool hasAudioLoudness = packetStateFlags & AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS;
+    bool hasSensorToWorldMatrix = packetStateFlags & AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX;
+    bool hasAdditionalFlags = packetStateFlags & AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS;
+    bool hasParentInfo = packetStateFlags & AvatarDataPacket::PACKET_HAS_PARENT_INFO;
+    bool hasAvatarLocalPosition = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION;
+    bool hasFaceTrackerInfo = packetStateFlags & AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO;
+    bool hasJointData = packetStateFlags & AvatarDataPacket::PACKET_HAS_JOINT_DATA;
+    bool hasJointDefaultPoseFlags = packetStateFlags & AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS;
+
+    const size_t byteArraySize = AvatarDataPacket::MAX_CONSTANT_HEADER_SIZE +
+        (hasFaceTrackerInfo ? AvatarDataPacket::maxFaceTrackerInfoSize(_headData->getNumSummedBlendshapeCoefficients()) : 0) +
+        (hasJointData ? AvatarDataPacket::maxJointDataSize(_jointData.size()) : 0) +
+        (hasJointDefaultPoseFlags ? AvatarDataPacket::maxJointDefaultPoseFlagsSize(_jointData.size()) : 0);
+
+    QByteArray avatarDataByteArray((int)byteArraySize, 0);
+    unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(avatarDataByteArray.data());
+    unsigned char* startPosition = destinationBuffer;
+
+    // Leading flags, to indicate how much data is actually included in the packet...
     memcpy(destinationBuffer, &packetStateFlags, sizeof(packetStateFlags));
     destinationBuffer += sizeof(packetStateFlags);
 
@@ -427,6 +427,9 @@ public:
         AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
         QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut = nullptr) const;
 
+    // the sections of data toByteArray includes for a detail level, given when the receiver was last sent this avatar
+    AvatarDataPacket::HasFlags getHasFlags(AvatarDataDetail dataDetail, quint64 lastSentTime, bool dropFaceTracking) const;
+
     virtual void doneEncoding(bool cullSmallChanges);
 
     /// \return true if an error should be logged
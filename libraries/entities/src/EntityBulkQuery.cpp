@@ -0,0 +1,234 @@
+//
+//  EntityBulkQuery.cpp
+//  libraries/entities/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBulkQuery.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "EntityItem.h"
+#include "EntityTreeElement.h"
+
+// the finer tests of spheres against entities are only done for the entities the AABox test doesn't rule out, which
+// is slightly looser than AABox::findSpherePenetration so that rounding never rules out an entity it would find
+static const float SPHERE_BOUNDS_SLOP = 1.0e-3f;
+
+int EntityBulkQuery::addSphere(const glm::vec3& center, float radius) {
+    Query query;
+    query.type = SPHERE;
+    query.center = center;
+    query.radius = radius;
+    _queries.push_back(query);
+    return (int)_queries.size() - 1;
+}
+
+int EntityBulkQuery::addBox(const AABox& box) {
+    Query query;
+    query.type = BOX;
+    query.box = box;
+    _queries.push_back(query);
+    return (int)_queries.size() - 1;
+}
+
+int EntityBulkQuery::addFrustum(const ViewFrustum& frustum) {
+    Query query;
+    query.type = FRUSTUM;
+    query.frustum = frustum;
+    _queries.push_back(query);
+    return (int)_queries.size() - 1;
+}
+
+void EntityBulkQuery::EntityBounds::clear() {
+    entities.clear();
+    cornerX.clear();
+    cornerY.clear();
+    cornerZ.clear();
+    scaleX.clear();
+    scaleY.clear();
+    scaleZ.clear();
+    hasBox.clear();
+}
+
+void EntityBulkQuery::EntityBounds::append(const EntityItemPointer& entity) {
+    bool success;
+    AABox box = entity->getAABox(success);
+    const glm::vec3& corner = box.getCorner();
+    const glm::vec3& scale = box.getScale();
+
+    entities.push_back(entity);
+    cornerX.push_back(corner.x);
+    cornerY.push_back(corner.y);
+    cornerZ.push_back(corner.z);
+    scaleX.push_back(scale.x);
+    scaleY.push_back(scale.y);
+    scaleZ.push_back(scale.z);
+    hasBox.push_back(success ? 1 : 0);
+}
+
+bool EntityBulkQuery::touchesElement(const Query& query, const OctreeElementPointer& element) const {
+    switch (query.type) {
+        case SPHERE: {
+            glm::vec3 penetration;
+            return element->getAACube().findSpherePenetration(query.center, query.radius, penetration);
+        }
+        case BOX:
+            return element->getAACube().touches(query.box);
+        case FRUSTUM:
+            return element->isInView(query.frustum);
+    }
+    return false;
+}
+
+// AABox::touches, for every entity
+static void touchBox(int numEntities, const float* cornerX, const float* cornerY, const float* cornerZ,
+                     const float* scaleX, const float* scaleY, const float* scaleZ, const AABox& box, uint8_t* hits) {
+    const glm::vec3& boxCorner = box.getCorner();
+    const glm::vec3& boxScale = box.getScale();
+    for (int i = 0; i < numEntities; ++i) {
+        float relativeCenterX = cornerX[i] - boxCorner.x + ((scaleX[i] - boxScale.x) * 0.5f);
+        float relativeCenterY = cornerY[i] - boxCorner.y + ((scaleY[i] - boxScale.y) * 0.5f);
+        float relativeCenterZ = cornerZ[i] - boxCorner.z + ((scaleZ[i] - boxScale.z) * 0.5f);
+        hits[i] = (uint8_t)((fabsf(relativeCenterX) <= (scaleX[i] + boxScale.x) * 0.5f) &
+                            (fabsf(relativeCenterY) <= (scaleY[i] + boxScale.y) * 0.5f) &
+                            (fabsf(relativeCenterZ) <= (scaleZ[i] + boxScale.z) * 0.5f));
+    }
+}
+
+// AABox::touchesSphere, for every entity
+static void touchSphere(int numEntities, const float* cornerX, const float* cornerY, const float* cornerZ,
+                        const float* scaleX, const float* scaleY, const float* scaleZ,
+                        const glm::vec3& center, float radius, uint8_t* hits) {
+    float radiusSquared = radius * radius;
+    for (int i = 0; i < numEntities; ++i) {
+        float x = std::max(cornerX[i] - center.x, 0.0f) + std::max(center.x - cornerX[i] - scaleX[i], 0.0f);
+        float y = std::max(cornerY[i] - center.y, 0.0f) + std::max(center.y - cornerY[i] - scaleY[i], 0.0f);
+        float z = std::max(cornerZ[i] - center.z, 0.0f) + std::max(center.z - cornerZ[i] - scaleZ[i], 0.0f);
+        hits[i] = (uint8_t)(x * x + y * y + z * z <= radiusSquared);
+    }
+}
+
+// ViewFrustum::boxIntersectsFrustum for one plane, for every entity
+static void clipToPlane(int numEntities, const float* cornerX, const float* cornerY, const float* cornerZ,
+                        const float* scaleX, const float* scaleY, const float* scaleZ, const ::Plane& plane,
+                        uint8_t* hits) {
+    // the farthest vertex along the normal of the plane
+    const glm::vec3& normal = plane.getNormal();
+    float farthestX = normal.x > 0.0f ? 1.0f : 0.0f;
+    float farthestY = normal.y > 0.0f ? 1.0f : 0.0f;
+    float farthestZ = normal.z > 0.0f ? 1.0f : 0.0f;
+    float dCoefficient = plane.getDCoefficient();
+    for (int i = 0; i < numEntities; ++i) {
+        float x = cornerX[i] + farthestX * scaleX[i];
+        float y = cornerY[i] + farthestY * scaleY[i];
+        float z = cornerZ[i] + farthestZ * scaleZ[i];
+        hits[i] &= (uint8_t)(dCoefficient + (normal.x * x + normal.y * y + normal.z * z) >= 0.0f);
+    }
+}
+
+void EntityBulkQuery::findInElement(Query& query, EntityBounds& bounds) const {
+    int numEntities = bounds.size();
+    bounds.hits.resize(numEntities);
+    uint8_t* hits = bounds.hits.data();
+    const float* cornerX = bounds.cornerX.data();
+    const float* cornerY = bounds.cornerY.data();
+    const float* cornerZ = bounds.cornerZ.data();
+    const float* scaleX = bounds.scaleX.data();
+    const float* scaleY = bounds.scaleY.data();
+    const float* scaleZ = bounds.scaleZ.data();
+
+    switch (query.type) {
+        case SPHERE:
+            touchSphere(numEntities, cornerX, cornerY, cornerZ, scaleX, scaleY, scaleZ, query.center,
+                        query.radius * (1.0f + SPHERE_BOUNDS_SLOP) + SPHERE_BOUNDS_SLOP, hits);
+            break;
+
+        case BOX:
+            touchBox(numEntities, cornerX, cornerY, cornerZ, scaleX, scaleY, scaleZ, query.box, hits);
+            break;
+
+        case FRUSTUM: {
+            // boxIntersectsFrustum || boxIntersectsKeyhole, which adds the central sphere to the frustum
+            std::fill(hits, hits + numEntities, (uint8_t)1);
+            const ::Plane* planes = query.frustum.getPlanes();
+            for (int j = 0; j < NUM_FRUSTUM_PLANES; ++j) {
+                clipToPlane(numEntities, cornerX, cornerY, cornerZ, scaleX, scaleY, scaleZ, planes[j], hits);
+            }
+            std::vector<uint8_t> inKeyhole(numEntities);
+            touchSphere(numEntities, cornerX, cornerY, cornerZ, scaleX, scaleY, scaleZ, query.frustum.getPosition(),
+                        query.frustum.getCenterRadius(), inKeyhole.data());
+            for (int i = 0; i < numEntities; ++i) {
+                hits[i] |= inKeyhole[i];
+            }
+            break;
+        }
+    }
+
+    for (int i = 0; i < numEntities; ++i) {
+        bool found = !bounds.hasBox[i] || hits[i];
+        if (found && query.type == SPHERE) {
+            if (bounds.hasBox[i]) {
+                AABox entityBox(glm::vec3(cornerX[i], cornerY[i], cornerZ[i]), glm::vec3(scaleX[i], scaleY[i], scaleZ[i]));
+                glm::vec3 penetration;
+                found = entityBox.findSpherePenetration(query.center, query.radius, penetration);
+            }
+            found = found && EntityTreeElement::sphereTouchesEntityShape(bounds.entities[i], query.center, query.radius);
+        }
+        if (found) {
+            query.results.push_back(bounds.entities[i]);
+        }
+    }
+}
+
+EntityBulkQueryOperator::EntityBulkQueryOperator(EntityBulkQuery& query) :
+    _query(query)
+{
+    for (int i = 0; i < _query.getNumQueries(); ++i) {
+        _query._queries[i].results.clear();
+        _activeQueries.push_back(i);
+    }
+    _levels.push_back(0);
+}
+
+bool EntityBulkQueryOperator::preRecursion(const OctreeElementPointer& element) {
+    size_t parentStart = _levels.back();
+    size_t parentEnd = _activeQueries.size();
+    size_t start = parentEnd;
+    for (size_t i = parentStart; i < parentEnd; ++i) {
+        int query = _activeQueries[i];
+        if (_query.touchesElement(_query._queries[query], element)) {
+            _activeQueries.push_back(query);
+        }
+    }
+    _levels.push_back(start);
+
+    // none of the children of an element that no query touches can be touched either
+    if (_activeQueries.size() == start) {
+        return false;
+    }
+
+    auto entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+    _bounds.clear();
+    entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) {
+        _bounds.append(entity);
+    });
+    if (_bounds.size() > 0) {
+        for (size_t i = start; i < _activeQueries.size(); ++i) {
+            _query.findInElement(_query._queries[_activeQueries[i]], _bounds);
+        }
+    }
+    return true;
+}
+
+bool EntityBulkQueryOperator::postRecursion(const OctreeElementPointer& element) {
+    _activeQueries.resize(_levels.back());
+    _levels.pop_back();
+    return true;
+}
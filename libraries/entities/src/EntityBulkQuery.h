@@ -0,0 +1,98 @@
+//
+//  EntityBulkQuery.h
+//  libraries/entities/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBulkQuery_h
+#define hifi_EntityBulkQuery_h
+
+#include <stdint.h>
+#include <vector>
+
+#include <QVector>
+
+#include <AABox.h>
+#include <Octree.h>
+#include <ViewFrustum.h>
+
+#include "EntityTypes.h"
+
+// Batch of spatial queries for entities, all answered in a single traversal of the entity tree
+//   Each element of the tree is only visited by the queries that touch it. The world frame bounds of the entities of
+//   an element are gathered once, into an array per coordinate, and each query then tests all of them in a loop the
+//   compiler can vectorize. The tests are the same as those of the EntityTree::findEntities for a single query, so the
+//   results are too. The results of every query are replaced each time the batch is run.
+class EntityBulkQuery {
+public:
+    enum Type : uint8_t {
+        SPHERE,
+        BOX,
+        FRUSTUM
+    };
+
+    // each returns the index of the query, for getResults
+    int addSphere(const glm::vec3& center, float radius);
+    int addBox(const AABox& box);
+    int addCube(const AACube& cube) { return addBox(AABox(cube)); }
+    int addFrustum(const ViewFrustum& frustum);
+
+    int getNumQueries() const { return (int)_queries.size(); }
+    const QVector<EntityItemPointer>& getResults(int query) const { return _queries[query].results; }
+    QVector<EntityItemPointer>& getResults(int query) { return _queries[query].results; }
+
+    void clear() { _queries.clear(); }
+
+private:
+    friend class EntityBulkQueryOperator;
+
+    struct Query {
+        Type type;
+        glm::vec3 center; // of a sphere
+        float radius { 0.0f };
+        AABox box;
+        ViewFrustum frustum;
+        QVector<EntityItemPointer> results;
+    };
+
+    // the world frame AABoxes of the entities of an element, a coordinate per array
+    struct EntityBounds {
+        std::vector<EntityItemPointer> entities;
+        std::vector<float> cornerX, cornerY, cornerZ;
+        std::vector<float> scaleX, scaleY, scaleZ;
+        std::vector<uint8_t> hasBox; // entities that can't compute their AABox are found by every query
+        std::vector<uint8_t> hits;
+
+        void clear();
+        void append(const EntityItemPointer& entity);
+        int size() const { return (int)entities.size(); }
+    };
+
+    bool touchesElement(const Query& query, const OctreeElementPointer& element) const;
+    void findInElement(Query& query, EntityBounds& bounds) const;
+
+    std::vector<Query> _queries;
+};
+
+// Visits the elements touched by any of the queries of a batch, keeping the queries that touch each element on a
+// stack, so that the children of an element are only tested against those
+class EntityBulkQueryOperator : public RecurseOctreeOperator {
+public:
+    EntityBulkQueryOperator(EntityBulkQuery& query);
+
+    bool preRecursion(const OctreeElementPointer& element) override;
+    bool postRecursion(const OctreeElementPointer& element) override;
+
+private:
+    EntityBulkQuery& _query;
+    std::vector<int> _activeQueries; // of the elements being visited, from the root down
+    std::vector<size_t> _levels; // where the queries of each element being visited start in _activeQueries
+    EntityBulkQuery::EntityBounds _bounds;
+};
+
+#endif // hifi_EntityBulkQuery_h
@@ -0,0 +1,130 @@
+//
+//  EntityEncodeCache.cpp
+//  libraries/entities/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodeCache.h"
+
+#include <OctreePacketData.h>
+
+#include "EntityNodeData.h"
+
+const int EntityEncodeCache::DEFAULT_MAX_SIZE = 32 * 1024 * 1024;
+
+// entities are encoded into a packet of their own before they are cached, one per send thread
+static thread_local OctreePacketData encodePacketData { false, MAX_OCTREE_UNCOMRESSED_PACKET_SIZE };
+
+bool EntityEncodeCache::Entry::matches(const Entry& other) const {
+    return lastEdited == other.lastEdited && lastUpdated == other.lastUpdated && lastSimulated == other.lastSimulated
+        && lastChangedOnServer == other.lastChangedOnServer && requestedProperties == other.requestedProperties;
+}
+
+EntityEncodeCache::EntityEncodeCache(int maxSize) :
+    _maxSize(maxSize)
+{
+}
+
+EntityEncodeCache::Entry EntityEncodeCache::makeKey(const EntityItemPointer& entity, EncodeBitstreamParams& params) const {
+    Entry key;
+    key.lastEdited = entity->getLastEdited();
+    key.lastUpdated = entity->getLastUpdated();
+    key.lastSimulated = entity->getLastSimulated();
+    key.lastChangedOnServer = entity->getLastChangedOnServer();
+    key.requestedProperties = entity->getEntityProperties(params);
+    return key;
+}
+
+QByteArray EntityEncodeCache::encode(const EntityItemPointer& entity, EncodeBitstreamParams& params) const {
+    // the bytes are only sent once they are appended to the packet of a client, which tracks the send then
+    EncodeBitstreamParams encodeParams = params;
+    encodeParams.trackSend = [](const QUuid&, quint64) {};
+    EntityTreeElementExtraEncodeDataPointer extraEncodeData { new EntityTreeElementExtraEncodeData() };
+
+    encodePacketData.reset();
+    if (entity->appendEntityData(&encodePacketData, encodeParams, extraEncodeData) != OctreeElement::COMPLETED) {
+        return QByteArray();
+    }
+    return QByteArray((const char*)encodePacketData.getUncompressedData(), encodePacketData.getUncompressedSize());
+}
+
+OctreeElement::AppendState EntityEncodeCache::appendEntityData(const EntityItemPointer& entity, OctreePacketData& packetData,
+                                                               EncodeBitstreamParams& params,
+                                                               EntityTreeElementExtraEncodeDataPointer extraEncodeData) {
+    const EntityItemID& entityID = entity->getEntityItemID();
+
+    // the rest of an entity that was split across packets is encoded as usual, and so are the entities sent to clients
+    // that asked for transform deltas, which are of what was sent to each of them
+    auto entityNodeData = static_cast<EntityNodeData*>(params.nodeData);
+    if (extraEncodeData->entities.contains(entityID) || (entityNodeData && entityNodeData->wantsTransformDeltas())) {
+        return entity->appendEntityData(&packetData, params, extraEncodeData);
+    }
+
+    // the key is taken before encoding, so that cached bytes are never older than their key
+    Entry entry = makeKey(entity, params);
+    bool found = false;
+    {
+        QReadLocker locker(&_entriesLock);
+        auto it = _entries.constFind(entityID);
+        if (it != _entries.constEnd() && it->matches(entry)) {
+            entry.data = it->data;
+            found = true;
+        }
+    }
+
+    if (found) {
+        ++_numHits;
+    } else {
+        ++_numMisses;
+        entry.data = encode(entity, params);
+        if (entry.data.isEmpty()) {
+            return entity->appendEntityData(&packetData, params, extraEncodeData);
+        }
+
+        QWriteLocker locker(&_entriesLock);
+        auto it = _entries.find(entityID);
+        if (it != _entries.end()) {
+            _size -= it->data.size();
+            _entries.erase(it);
+        }
+        // rather than track which entries are used least, start over once the cache is full
+        if (_size + entry.data.size() > _maxSize) {
+            _entries.clear();
+            _size = 0;
+        }
+        _entries.insert(entityID, entry);
+        _size += entry.data.size();
+    }
+
+    if (!packetData.appendRawData((const unsigned char*)entry.data.constData(), entry.data.size())) {
+        // encode as usual, so that as much of the entity as fits is sent in this packet
+        return entity->appendEntityData(&packetData, params, extraEncodeData);
+    }
+    params.trackSend(entity->getID(), entry.lastEdited);
+    return OctreeElement::COMPLETED;
+}
+
+void EntityEncodeCache::remove(const EntityItemID& entityID) {
+    QWriteLocker locker(&_entriesLock);
+    auto it = _entries.find(entityID);
+    if (it != _entries.end()) {
+        _size -= it->data.size();
+        _entries.erase(it);
+    }
+}
+
+void EntityEncodeCache::clear() {
+    QWriteLocker locker(&_entriesLock);
+    _entries.clear();
+    _size = 0;
+}
+
+int EntityEncodeCache::getSize() const {
+    QReadLocker locker(&_entriesLock);
+    return _size;
+}
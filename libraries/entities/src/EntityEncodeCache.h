@@ -0,0 +1,81 @@
+//
+//  EntityEncodeCache.h
+//  libraries/entities/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodeCache_h
+#define hifi_EntityEncodeCache_h
+
+#include <atomic>
+
+#include <QByteArray>
+#include <QHash>
+#include <QReadWriteLock>
+
+#include <OctreeElement.h>
+
+#include "EntityItem.h"
+#include "EntityItemID.h"
+#include "EntityTreeElement.h"
+
+class OctreePacketData;
+
+// Cache of entities encoded for entity data packets, shared by the send threads of all the clients of a server
+//   Every client that is sent an entity is sent the same bytes, as long as the entity hasn't changed since and the same
+//   properties are requested, so the entity is only encoded once for all of them. This matters most when many users
+//   load the same scene at once.
+//   An entry is reused while the edited, updated, simulated and changed-on-server times of its entity, and the
+//   properties requested, are what they were when it was encoded. Only complete entities are cached: an entity that
+//   doesn't fit the rest of a packet is encoded as usual, so that it can be split across packets. Neither are the
+//   entities sent to clients that asked for transform deltas.
+class EntityEncodeCache {
+public:
+    static const int DEFAULT_MAX_SIZE;
+
+    EntityEncodeCache(int maxSize = DEFAULT_MAX_SIZE);
+
+    // Append the entity to the packet the way EntityItem::appendEntityData does, reusing its cached bytes if they are
+    // still current
+    OctreeElement::AppendState appendEntityData(const EntityItemPointer& entity, OctreePacketData& packetData,
+                                                EncodeBitstreamParams& params,
+                                                EntityTreeElementExtraEncodeDataPointer extraEncodeData);
+
+    void remove(const EntityItemID& entityID);
+    void clear();
+
+    int getSize() const;
+    quint64 getNumHits() const { return _numHits; }
+    quint64 getNumMisses() const { return _numMisses; }
+
+private:
+    struct Entry {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 lastChangedOnServer { 0 };
+        QByteArray requestedProperties;
+        QByteArray data;
+
+        bool matches(const Entry& other) const;
+    };
+
+    Entry makeKey(const EntityItemPointer& entity, EncodeBitstreamParams& params) const;
+    QByteArray encode(const EntityItemPointer& entity, EncodeBitstreamParams& params) const;
+
+    int _maxSize;
+
+    mutable QReadWriteLock _entriesLock;
+    QHash<EntityItemID, Entry> _entries;
+    int _size { 0 }; // bytes of encoded data in the entries
+
+    std::atomic<quint64> _numHits { 0 };
+    std::atomic<quint64> _numMisses { 0 };
+};
+
+#endif // hifi_EntityEncodeCache_h
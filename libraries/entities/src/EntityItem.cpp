@@ -34,6 +34,7 @@
 
 #include "EntityScriptingInterface.h"
 #include "EntitiesLogging.h"
+#include "EntityNodeData.h"
 #include "EntityTree.h"
 #include "EntitySimulation.h"
 #include "EntityDynamicFactoryInterface.h"
@@ -167,6 +168,18 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
     }
 
+    // clients that ask for them are sent a delta of the transform and velocities in place of each of them
+    auto entityNodeData = static_cast<EntityNodeData*>(params.nodeData);
+    if (entityNodeData && entityNodeData->wantsTransformDeltas() &&
+            requestedProperties.getHasProperty(PROP_POSITION) && requestedProperties.getHasProperty(PROP_ROTATION) &&
+            requestedProperties.getHasProperty(PROP_VELOCITY) && requestedProperties.getHasProperty(PROP_ANGULAR_VELOCITY)) {
+        requestedProperties -= PROP_POSITION;
+        requestedProperties -= PROP_ROTATION;
+        requestedProperties -= PROP_VELOCITY;
+        requestedProperties -= PROP_ANGULAR_VELOCITY;
+        requestedProperties += PROP_TRANSFORM_DELTA;
+    }
+
     EntityPropertyFlags propertiesDidntFit = requestedProperties;
 
     LevelDetails entityLevel = packetData->startLevel();
@@ -235,6 +248,16 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         APPEND_ENTITY_PROPERTY(PROP_ROTATION, getLocalOrientation());
         APPEND_ENTITY_PROPERTY(PROP_VELOCITY, getLocalVelocity());
         APPEND_ENTITY_PROPERTY(PROP_ANGULAR_VELOCITY, getLocalAngularVelocity());
+        if (requestedProperties.getHasProperty(PROP_TRANSFORM_DELTA)) {
+            auto& transformDeltaEncoder = entityNodeData->getTransformDeltaEncoder();
+            EntityTransform transform { getLocalPosition(), getLocalOrientation(),
+                                        getLocalVelocity(), getLocalAngularVelocity() };
+            QByteArray transformDelta = transformDeltaEncoder.encode(getEntityItemID(), transform, usecTimestampNow());
+            APPEND_ENTITY_PROPERTY(PROP_TRANSFORM_DELTA, transformDelta);
+            if (successPropertyFits) {
+                transformDeltaEncoder.trackSend(getEntityItemID(), transformDelta);
+            }
+        }
         APPEND_ENTITY_PROPERTY(PROP_ACCELERATION, getAcceleration());
 
         APPEND_ENTITY_PROPERTY(PROP_DIMENSIONS, getUnscaledDimensions());
@@ -771,6 +794,22 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
         READ_ENTITY_PROPERTY(PROP_ROTATION, glm::quat, customUpdateRotationFromNetwork);
         READ_ENTITY_PROPERTY(PROP_VELOCITY, glm::vec3, customUpdateVelocityFromNetwork);
         READ_ENTITY_PROPERTY(PROP_ANGULAR_VELOCITY, glm::vec3, customUpdateAngularVelocityFromNetwork);
+        if (propertyFlags.getHasProperty(PROP_TRANSFORM_DELTA)) {
+            QByteArray fromBuffer;
+            int bytes = OctreePacketData::unpackDataFromBytes(dataAt, fromBuffer);
+            dataAt += bytes;
+            bytesRead += bytes;
+
+            // the keyframe is kept even when the rest of the packet is ignored, since the deltas that follow are of it
+            EntityTransform transform;
+            if (EntityTransformDelta::decode(fromBuffer, _transformKeyframe, transform) && overwriteLocalData) {
+                customUpdatePositionFromNetwork(transform.position);
+                customUpdateRotationFromNetwork(transform.rotation);
+                customUpdateVelocityFromNetwork(transform.velocity);
+                customUpdateAngularVelocityFromNetwork(transform.angularVelocity);
+            }
+            somethingChanged = true;
+        }
         READ_ENTITY_PROPERTY(PROP_ACCELERATION, glm::vec3, customSetAcceleration);
     }
 
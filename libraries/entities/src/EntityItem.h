@@ -31,6 +31,7 @@
 #include "EntityItemID.h"
 #include "EntityItemPropertiesDefaults.h"
 #include "EntityPropertyFlags.h"
+#include "EntityTransformDelta.h"
 #include "EntityTypes.h"
 #include "SimulationOwner.h"
 #include "SimulationFlags.h"
@@ -646,6 +647,9 @@ protected:
     quint64 _lastUpdatedQueryAACubeTimestamp { 0 };
     uint64_t _simulationOwnershipExpiry { 0 };
 
+    // the last transform the entity server sent in full, which the transform deltas it sends are relative to
+    EntityTransformKeyframe _transformKeyframe;
+
     bool _cauterized { false }; // if true, don't draw because it would obscure 1st-person camera
 
 private:
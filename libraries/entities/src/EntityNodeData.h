@@ -16,11 +16,14 @@
 
 #include <OctreeQueryNode.h>
 
+#include "EntityTransformDelta.h"
+
 namespace EntityJSONQueryProperties {
     static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
     static const QString FLAGS_PROPERTY = "flags";
     static const QString INCLUDE_ANCESTORS_PROPERTY = "includeAncestors";
     static const QString INCLUDE_DESCENDANTS_PROPERTY = "includeDescendants";
+    static const QString TRANSFORM_DELTAS_PROPERTY = "transformDeltas";
 }
 
 class EntityNodeData : public OctreeQueryNode {
@@ -44,11 +47,18 @@ public:
     bool isEntityFlaggedAsExtra(const QUuid& entityID) const;
     void resetFlaggedExtraEntities() { _previousFlaggedExtraEntities = _flaggedExtraEntities; _flaggedExtraEntities.clear(); }
 
+    // the transform deltas can only be used from the OctreeSendThread for the given Node
+    bool wantsTransformDeltas() const { return _wantsTransformDeltas; }
+    void setWantsTransformDeltas(bool wantsTransformDeltas) { _wantsTransformDeltas = wantsTransformDeltas; }
+    EntityTransformDeltaEncoder& getTransformDeltaEncoder() { return _transformDeltaEncoder; }
+
 private:
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
     QSet<QUuid> _sentFilteredEntities;
     QHash<QUuid, QSet<QUuid>> _flaggedExtraEntities;
     QHash<QUuid, QSet<QUuid>> _previousFlaggedExtraEntities;
+    bool _wantsTransformDeltas { false };
+    EntityTransformDeltaEncoder _transformDeltaEncoder;
 };
 
 #endif // hifi_EntityNodeData_h
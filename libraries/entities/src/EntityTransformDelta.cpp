@@ -0,0 +1,227 @@
+//
+//  EntityTransformDelta.cpp
+//  libraries/entities/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTransformDelta.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+const quint64 EntityTransformDeltaEncoder::KEYFRAME_INTERVAL_USECS = 2 * USECS_PER_SECOND;
+
+enum TransformMode : quint8 {
+    KEYFRAME,
+    DELTA
+};
+
+// the integers the components of a delta are sent as
+enum DeltaSize : quint8 {
+    ZERO,
+    BYTE,
+    SHORT,
+    DOESNT_FIT
+};
+
+// position, rotation, velocity and angular velocity
+static const int NUM_QUANTITIES = 4;
+
+// the value of one unit of the delta of each quantity
+static const float DELTA_UNITS[NUM_QUANTITIES] = {
+    1.0f / 1024.0f, // meters
+    1.0f / 16384.0f, // of the components of the rotation from the keyframe
+    1.0f / 512.0f, // meters per second
+    1.0f / 512.0f // radians per second
+};
+
+//    mode [1 byte]
+//    keyframe sequence [1 byte]
+static const int HEADER_SIZE = 2;
+
+//    header [2 bytes]
+//    sent at [8 bytes]
+//    position, rotation, velocity, angular velocity [12 + 8 + 12 + 12 bytes]
+static const int KEYFRAME_SIZE = HEADER_SIZE + sizeof(quint64) + 3 * sizeof(glm::vec3) + 4 * sizeof(uint16_t);
+
+// the rotation from the keyframe to the transform, without its w, which is positive
+static glm::vec3 rotationDelta(const glm::quat& keyframeRotation, const glm::quat& rotation) {
+    glm::quat delta = glm::inverse(keyframeRotation) * rotation;
+    if (delta.w < 0.0f) {
+        delta = -delta;
+    }
+    return glm::vec3(delta.x, delta.y, delta.z);
+}
+
+static glm::quat applyRotationDelta(const glm::quat& keyframeRotation, const glm::vec3& delta) {
+    float w = sqrtf(std::max(0.0f, 1.0f - glm::dot(delta, delta)));
+    return glm::normalize(keyframeRotation * glm::quat(w, delta.x, delta.y, delta.z));
+}
+
+// Quantize the components of a delta, returning the smallest integers they all fit in
+static DeltaSize quantize(const glm::vec3& delta, float unit, qint16 components[3]) {
+    DeltaSize size = ZERO;
+    for (int i = 0; i < 3; ++i) {
+        float value = roundf(delta[i] / unit);
+        if (!(fabsf(value) <= (float)INT16_MAX)) { // NaN doesn't fit either
+            return DOESNT_FIT;
+        }
+        components[i] = (qint16)value;
+        if (value != 0.0f) {
+            size = std::max(size, (value >= (float)INT8_MIN && value <= (float)INT8_MAX) ? BYTE : SHORT);
+        }
+    }
+    return size;
+}
+
+bool EntityTransformDelta::isKeyframe(const QByteArray& data) {
+    return data.size() > 0 && (quint8)data.at(0) == KEYFRAME;
+}
+
+bool EntityTransformDelta::decode(const QByteArray& data, EntityTransformKeyframe& keyframe, EntityTransform& transform) {
+    if (data.size() < HEADER_SIZE) {
+        return false;
+    }
+    const unsigned char* dataAt = (const unsigned char*)data.constData();
+    const unsigned char* dataEnd = dataAt + data.size();
+    quint8 mode = *dataAt++;
+    quint8 sequence = *dataAt++;
+
+    if (mode == KEYFRAME) {
+        if (data.size() != KEYFRAME_SIZE) {
+            return false;
+        }
+        quint64 sentAt;
+        memcpy(&sentAt, dataAt, sizeof(sentAt));
+        dataAt += sizeof(sentAt);
+        memcpy(&transform.position, dataAt, sizeof(transform.position));
+        dataAt += sizeof(transform.position);
+        dataAt += unpackOrientationQuatFromBytes(dataAt, transform.rotation);
+        memcpy(&transform.velocity, dataAt, sizeof(transform.velocity));
+        dataAt += sizeof(transform.velocity);
+        memcpy(&transform.angularVelocity, dataAt, sizeof(transform.angularVelocity));
+
+        // a keyframe whose packet was resent can arrive after a later one
+        if (!keyframe.valid || sentAt > keyframe.sentAt) {
+            keyframe.transform = transform;
+            keyframe.sentAt = sentAt;
+            keyframe.sequence = sequence;
+            keyframe.valid = true;
+        }
+        return true;
+    }
+
+    if (mode != DELTA || dataAt == dataEnd || !keyframe.valid || keyframe.sequence != sequence) {
+        return false;
+    }
+
+    quint8 sizes = *dataAt++;
+    glm::vec3 deltas[NUM_QUANTITIES];
+    for (int i = 0; i < NUM_QUANTITIES; ++i) {
+        DeltaSize size = (DeltaSize)((sizes >> (2 * i)) & 0x3);
+        if (size == ZERO) {
+            deltas[i] = glm::vec3(0.0f);
+        } else if (size == BYTE) {
+            if (dataEnd - dataAt < 3) {
+                return false;
+            }
+            for (int j = 0; j < 3; ++j) {
+                deltas[i][j] = (float)(qint8)(*dataAt++) * DELTA_UNITS[i];
+            }
+        } else if (size == SHORT) {
+            qint16 components[3];
+            if (dataEnd - dataAt < (int)sizeof(components)) {
+                return false;
+            }
+            memcpy(components, dataAt, sizeof(components));
+            dataAt += sizeof(components);
+            for (int j = 0; j < 3; ++j) {
+                deltas[i][j] = (float)components[j] * DELTA_UNITS[i];
+            }
+        } else {
+            return false;
+        }
+    }
+    if (dataAt != dataEnd) {
+        return false;
+    }
+
+    const EntityTransform& keyframeTransform = keyframe.transform;
+    transform.position = keyframeTransform.position + deltas[0];
+    transform.rotation = applyRotationDelta(keyframeTransform.rotation, deltas[1]);
+    transform.velocity = keyframeTransform.velocity + deltas[2];
+    transform.angularVelocity = keyframeTransform.angularVelocity + deltas[3];
+    return true;
+}
+
+QByteArray EntityTransformDeltaEncoder::encode(const EntityItemID& entityID, const EntityTransform& transform,
+                                               quint64 now) const {
+    auto keyframe = _keyframes.constFind(entityID);
+    bool hasKeyframe = keyframe != _keyframes.constEnd() && keyframe->valid;
+
+    if (hasKeyframe && now - keyframe->sentAt < KEYFRAME_INTERVAL_USECS) {
+        const EntityTransform& keyframeTransform = keyframe->transform;
+        glm::vec3 deltas[NUM_QUANTITIES] = {
+            transform.position - keyframeTransform.position,
+            rotationDelta(keyframeTransform.rotation, transform.rotation),
+            transform.velocity - keyframeTransform.velocity,
+            transform.angularVelocity - keyframeTransform.angularVelocity
+        };
+
+        qint16 components[NUM_QUANTITIES][3];
+        DeltaSize sizes[NUM_QUANTITIES];
+        bool fits = true;
+        for (int i = 0; i < NUM_QUANTITIES && fits; ++i) {
+            sizes[i] = quantize(deltas[i], DELTA_UNITS[i], components[i]);
+            fits = sizes[i] != DOESNT_FIT;
+        }
+
+        if (fits) {
+            QByteArray data;
+            data.append((char)DELTA);
+            data.append((char)keyframe->sequence);
+            data.append((char)(sizes[0] | (sizes[1] << 2) | (sizes[2] << 4) | (sizes[3] << 6)));
+            for (int i = 0; i < NUM_QUANTITIES; ++i) {
+                if (sizes[i] == BYTE) {
+                    for (int j = 0; j < 3; ++j) {
+                        data.append((char)(qint8)components[i][j]);
+                    }
+                } else if (sizes[i] == SHORT) {
+                    data.append((const char*)components[i], sizeof(components[i]));
+                }
+            }
+            return data;
+        }
+    }
+
+    QByteArray data(KEYFRAME_SIZE, 0);
+    unsigned char* dataAt = (unsigned char*)data.data();
+    *dataAt++ = KEYFRAME;
+    *dataAt++ = hasKeyframe ? (quint8)(keyframe->sequence + 1) : 0;
+    memcpy(dataAt, &now, sizeof(now));
+    dataAt += sizeof(now);
+    memcpy(dataAt, &transform.position, sizeof(transform.position));
+    dataAt += sizeof(transform.position);
+    dataAt += packOrientationQuatToBytes(dataAt, transform.rotation);
+    memcpy(dataAt, &transform.velocity, sizeof(transform.velocity));
+    dataAt += sizeof(transform.velocity);
+    memcpy(dataAt, &transform.angularVelocity, sizeof(transform.angularVelocity));
+    return data;
+}
+
+void EntityTransformDeltaEncoder::trackSend(const EntityItemID& entityID, const QByteArray& data) {
+    if (EntityTransformDelta::isKeyframe(data)) {
+        // decode the keyframe the way the client will, so that the deltas are of exactly what it has
+        EntityTransform transform;
+        EntityTransformDelta::decode(data, _keyframes[entityID], transform);
+    }
+}
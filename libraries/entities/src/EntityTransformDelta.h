@@ -0,0 +1,76 @@
+//
+//  EntityTransformDelta.h
+//  libraries/entities/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTransformDelta_h
+#define hifi_EntityTransformDelta_h
+
+#include <QByteArray>
+#include <QHash>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "EntityItemID.h"
+
+// The local transform and velocities of an entity, as sent to clients
+class EntityTransform {
+public:
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 velocity;
+    glm::vec3 angularVelocity;
+};
+
+// The last transform of an entity sent in full, which the transforms sent since are deltas of
+class EntityTransformKeyframe {
+public:
+    EntityTransform transform;
+    quint64 sentAt { 0 }; // in the time of the server
+    quint8 sequence { 0 };
+    bool valid { false };
+};
+
+// Quantized deltas of the transforms of entities, for the clients that ask for them in place of full transforms
+//   Now and then the server sends the transform of an entity in full, as a keyframe, and in between it sends how far the
+//   entity has moved since, in integers of one or two bytes. A client keeps the last keyframe of each entity to add the
+//   deltas to. The entity protocol has no acknowledgements, only NACKs of lost packets, so a client drops the deltas of
+//   a keyframe it hasn't received yet: the keyframe arrives once its packet is resent, and keyframes are sent again
+//   every KEYFRAME_INTERVAL_USECS anyway.
+namespace EntityTransformDelta {
+    // Decode a transform, keeping it as the keyframe if it is one. Returns false if it is a delta of a keyframe other
+    // than the one kept, or isn't valid.
+    bool decode(const QByteArray& data, EntityTransformKeyframe& keyframe, EntityTransform& transform);
+
+    bool isKeyframe(const QByteArray& data);
+}
+
+// The keyframes sent to a client, for the server to encode the deltas of
+class EntityTransformDeltaEncoder {
+public:
+    static const quint64 KEYFRAME_INTERVAL_USECS;
+
+    // Encode the transform as a delta of the last keyframe sent for the entity if it can be, and as a new keyframe
+    // otherwise
+    QByteArray encode(const EntityItemID& entityID, const EntityTransform& transform, quint64 now) const;
+
+    // Record that an encoded transform was sent, keeping it as the keyframe of the entity if it is one
+    void trackSend(const EntityItemID& entityID, const QByteArray& data);
+
+    void remove(const EntityItemID& entityID) { _keyframes.remove(entityID); }
+    void clear() { _keyframes.clear(); }
+
+    int getNumKeyframes() const { return _keyframes.size(); }
+
+private:
+    QHash<EntityItemID, EntityTransformKeyframe> _keyframes;
+};
+
+#endif // hifi_EntityTransformDelta_h
@@ -24,6 +24,8 @@
 #include <QtScript/QScriptEngine>
 
 #include <Extents.h>
+#include <OctreeEditLog.h>
+#include <OctreeSnapshot.h>
 #include <PerfStat.h>
 #include <Profile.h>
 
@@ -97,8 +99,12 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     if (_simulation) {
         _simulation->clearEntities();
     }
-    QHash<EntityItemID, EntityItemPointer> localMap;
-    localMap.swap(_entityMap);
+    QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.takeAll();
+    if (_editLogEnabled) {
+        foreach (const EntityItemID& entityID, localMap.keys()) {
+            trackEditLogErase(entityID);
+        }
+    }
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -275,6 +281,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    trackEditLogChange(entity->getEntityItemID());
     emit addingEntity(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
@@ -282,11 +289,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityID);
     if (!entity) {
         return false;
     }
@@ -339,6 +342,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                trackEditLogChange(entity->getEntityItemID());
             }
         }
     } else {
@@ -422,44 +426,10 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
             emit editingEntityPointer(entity);
         }
 
-        // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
-        QQueue<SpatiallyNestablePointer> toProcess;
-        foreach (SpatiallyNestablePointer child, entity->getChildren()) {
-            if (child && child->getNestableType() == NestableType::Entity) {
-                toProcess.enqueue(child);
-            }
-        }
-
-        while (!toProcess.empty()) {
-            EntityItemPointer childEntity = std::static_pointer_cast<EntityItem>(toProcess.dequeue());
-            if (!childEntity) {
-                continue;
-            }
-            EntityTreeElementPointer childContainingElement = childEntity->getElement();
-            if (!childContainingElement) {
-                continue;
-            }
-
-            bool success;
-            AACube queryCube = childEntity->getQueryAACube(success);
-            if (!success) {
-                addToNeedsParentFixupList(childEntity);
-                continue;
-            }
-            if (!childEntity->getParentID().isNull()) {
-                addToNeedsParentFixupList(childEntity);
-            }
-
-            UpdateEntityOperator theChildOperator(getThisPointer(), childContainingElement, childEntity, queryCube);
-            recurseTreeWithOperator(&theChildOperator);
-            foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
-                if (childChild && childChild->getNestableType() == NestableType::Entity) {
-                    toProcess.enqueue(childChild);
-                }
-            }
-        }
+        updateDescendantsInTree(entity);
 
         _isDirty = true;
+        trackEditLogChange(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -492,6 +462,45 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
     return true;
 }
 
+void EntityTree::updateDescendantsInTree(const EntityItemPointer& entity) {
+    // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
+    QQueue<SpatiallyNestablePointer> toProcess;
+    foreach (SpatiallyNestablePointer child, entity->getChildren()) {
+        if (child && child->getNestableType() == NestableType::Entity) {
+            toProcess.enqueue(child);
+        }
+    }
+
+    while (!toProcess.empty()) {
+        EntityItemPointer childEntity = std::static_pointer_cast<EntityItem>(toProcess.dequeue());
+        if (!childEntity) {
+            continue;
+        }
+        EntityTreeElementPointer childContainingElement = childEntity->getElement();
+        if (!childContainingElement) {
+            continue;
+        }
+
+        bool success;
+        AACube queryCube = childEntity->getQueryAACube(success);
+        if (!success) {
+            addToNeedsParentFixupList(childEntity);
+            continue;
+        }
+        if (!childEntity->getParentID().isNull()) {
+            addToNeedsParentFixupList(childEntity);
+        }
+
+        UpdateEntityOperator theChildOperator(getThisPointer(), childContainingElement, childEntity, queryCube);
+        recurseTreeWithOperator(&theChildOperator);
+        foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
+            if (childChild && childChild->getNestableType() == NestableType::Entity) {
+                toProcess.enqueue(childChild);
+            }
+        }
+    }
+}
+
 EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties) {
     EntityItemPointer result = NULL;
     EntityItemProperties props = properties;
@@ -683,6 +692,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
         }
 
         theEntity->die();
+        trackEditLogErase(theEntity->getEntityItemID());
 
         if (getIsServer()) {
             {
@@ -922,17 +932,19 @@ void EntityTree::findEntities(RecurseOctreeOperation& elementFilter,
     recurseTreeWithOperation(elementFilter, nullptr);
 }
 
+// NOTE: assumes caller has handled locking
+void EntityTree::findEntities(EntityBulkQuery& query) {
+    EntityBulkQueryOperator theOperator(query);
+    recurseTreeWithOperator(&theOperator);
+}
+
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
     EntityItemID entityID(id);
     return findEntityByEntityItemID(entityID);
 }
 
 EntityItemPointer EntityTree::findEntityByEntityItemID(const EntityItemID& entityID) const {
-    EntityItemPointer foundEntity = nullptr;
-    {
-        QReadLocker locker(&_entityMapLock);
-        foundEntity = _entityMap.value(entityID);
-    }
+    EntityItemPointer foundEntity = _entityMap.value(entityID);
     if (foundEntity && !foundEntity->getElement()) {
         // special case to maintain legacy behavior:
         // if the entity is in the map but not in the tree
@@ -1985,11 +1997,7 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
 }
 
 EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& entityItemID)  /*const*/ {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityItemID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityItemID);
     if (entity) {
         return entity->getElement();
     }
@@ -1998,25 +2006,18 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 
 void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
     EntityItemID id = entity->getEntityItemID();
-    QWriteLocker locker(&_entityMapLock);
-    EntityItemPointer otherEntity = _entityMap.value(id);
-    if (otherEntity) {
+    if (!_entityMap.insert(id, entity)) {
         qCWarning(entities) << "EntityTree::addEntityMapEntry() found pre-existing id " << id;
         assert(false);
-        return;
     }
-    _entityMap.insert(id, entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
-    QWriteLocker locker(&_entityMapLock);
     _entityMap.remove(id);
 }
 
 void EntityTree::debugDumpMap() {
-    // QHash's are implicitly shared, so we make a shared copy and use that instead.
-    // This way we might be able to avoid both a lock and a true copy.
-    QHash<EntityItemID, EntityItemPointer> localMap(_entityMap);
+    QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.toHash();
     qCDebug(entities) << "EntityTree::debugDumpMap() --------------------------";
     QHashIterator<EntityItemID, EntityItemPointer> i(localMap);
     while (i.hasNext()) {
@@ -2419,6 +2420,430 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     return success;
 }
 
+// Sections of entity snapshots, each a column in the order of the entity index
+enum EntitySnapshotSection : uint32_t {
+    ENTITY_SNAPSHOT_INDEX = 1, // EntitySnapshotRecord per entity
+    ENTITY_SNAPSHOT_POSITIONS, // 3 floats per entity, local to the parent
+    ENTITY_SNAPSHOT_ROTATIONS, // 4 floats (x, y, z, w) per entity, local to the parent
+    ENTITY_SNAPSHOT_DIMENSIONS, // 3 floats per entity
+    ENTITY_SNAPSHOT_STRINGS, // string table
+    ENTITY_SNAPSHOT_STRING_COLUMNS, // uint32 count, uint32 properties[count], then a column of uint32 per property
+    ENTITY_SNAPSHOT_PROPERTIES // uint64 offsets[n + 1] into the rest, the remaining properties of each entity
+};
+
+struct EntitySnapshotRecord {
+    uint8_t id[NUM_BYTES_RFC4122_UUID];
+    uint8_t lastEditedBy[NUM_BYTES_RFC4122_UUID];
+    uint32_t type;
+    uint32_t flags;
+    quint64 created;
+    quint64 lastEdited;
+};
+
+static const uint32_t ENTITY_SNAPSHOT_CLIENT_ONLY = 1;
+
+// String properties stored by reference into the string table, rather than with the remaining properties
+//   A string column holds 0 for entities that don't have the property, or the index of the string plus one.
+struct EntitySnapshotStringColumn {
+    EntityPropertyList property;
+    const QString& (EntityItemProperties::*get)() const;
+    void (EntityItemProperties::*set)(const QString&);
+};
+
+static const EntitySnapshotStringColumn ENTITY_SNAPSHOT_STRING_COLUMNS[] = {
+    { PROP_NAME, &EntityItemProperties::getName, &EntityItemProperties::setName },
+    { PROP_SCRIPT, &EntityItemProperties::getScript, &EntityItemProperties::setScript },
+    { PROP_SERVER_SCRIPTS, &EntityItemProperties::getServerScripts, &EntityItemProperties::setServerScripts },
+    { PROP_USER_DATA, &EntityItemProperties::getUserData, &EntityItemProperties::setUserData },
+    { PROP_HREF, &EntityItemProperties::getHref, &EntityItemProperties::setHref },
+    { PROP_DESCRIPTION, &EntityItemProperties::getDescription, &EntityItemProperties::setDescription },
+    { PROP_COLLISION_SOUND_URL, &EntityItemProperties::getCollisionSoundURL, &EntityItemProperties::setCollisionSoundURL },
+    { PROP_MARKETPLACE_ID, &EntityItemProperties::getMarketplaceID, &EntityItemProperties::setMarketplaceID },
+    { PROP_MODEL_URL, &EntityItemProperties::getModelURL, &EntityItemProperties::setModelURL },
+    { PROP_COMPOUND_SHAPE_URL, &EntityItemProperties::getCompoundShapeURL, &EntityItemProperties::setCompoundShapeURL },
+    { PROP_TEXTURES, &EntityItemProperties::getTextures, &EntityItemProperties::setTextures },
+    { PROP_SHAPE, &EntityItemProperties::getShape, &EntityItemProperties::setShape },
+    { PROP_TEXT, &EntityItemProperties::getText, &EntityItemProperties::setText },
+    { PROP_SOURCE_URL, &EntityItemProperties::getSourceUrl, &EntityItemProperties::setSourceUrl },
+    { PROP_MATERIAL_URL, &EntityItemProperties::getMaterialURL, &EntityItemProperties::setMaterialURL },
+    { PROP_MATERIAL_DATA, &EntityItemProperties::getMaterialData, &EntityItemProperties::setMaterialData }
+};
+
+static const int NUM_ENTITY_SNAPSHOT_STRING_COLUMNS =
+    sizeof(ENTITY_SNAPSHOT_STRING_COLUMNS) / sizeof(ENTITY_SNAPSHOT_STRING_COLUMNS[0]);
+
+// persisted properties are edit encoded, into a buffer that grows until the largest entity fits
+static const int INITIAL_PERSIST_ENCODE_BUFFER_SIZE = 64 * 1024;
+static const int MAX_PERSIST_ENCODE_BUFFER_SIZE = 16 * 1024 * 1024;
+
+static OctreeElement::AppendState encodePersistedProperties(const EntityItemPointer& entity, const EntityItemProperties& properties,
+                                                            const EntityPropertyFlags& requestedProperties,
+                                                            QByteArray& buffer, int& bufferSize) {
+    OctreeElement::AppendState appendState;
+    while (true) {
+        buffer.resize(bufferSize);
+        EntityPropertyFlags didntFitProperties;
+        appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entity->getEntityItemID(),
+            properties, buffer, requestedProperties, didntFitProperties);
+        if (appendState != OctreeElement::PARTIAL || bufferSize >= MAX_PERSIST_ENCODE_BUFFER_SIZE) {
+            break;
+        }
+        bufferSize *= 2;
+    }
+
+    if (appendState == OctreeElement::PARTIAL) {
+        qCWarning(entities) << "Some properties of entity" << entity->getEntityItemID() << "are too large to persist";
+    }
+    return appendState;
+}
+
+template <typename T>
+static T* snapshotColumn(QByteArray& data) {
+    return reinterpret_cast<T*>(data.data());
+}
+
+bool EntityTree::writeToSnapshot(OctreeSnapshotWriter& writer, const OctreeElementPointer& element) {
+    withReadLock([&] {
+        std::vector<EntityItemPointer> entities;
+        recurseElementWithOperation(element, [&](const OctreeElementPointer& treeElement, void* extraData) {
+            std::static_pointer_cast<EntityTreeElement>(treeElement)->forEachEntity([&](EntityItemPointer entity) {
+                // as in JSON, entities whose parent can't be found aren't saved
+                if (entity->isParentIDValid()) {
+                    entities.push_back(entity);
+                }
+            });
+            return true;
+        }, nullptr);
+
+        const int numEntities = (int)entities.size();
+
+        QByteArray index(numEntities * (int)sizeof(EntitySnapshotRecord), 0);
+        QByteArray positions(numEntities * 3 * (int)sizeof(float), 0);
+        QByteArray rotations(numEntities * 4 * (int)sizeof(float), 0);
+        QByteArray dimensions(numEntities * 3 * (int)sizeof(float), 0);
+
+        OctreeSnapshotStringTableWriter strings;
+        const int stringColumnsHeaderSize = (1 + NUM_ENTITY_SNAPSHOT_STRING_COLUMNS) * (int)sizeof(uint32_t);
+        QByteArray stringColumns(stringColumnsHeaderSize + NUM_ENTITY_SNAPSHOT_STRING_COLUMNS * numEntities * (int)sizeof(uint32_t), 0);
+        uint32_t* stringColumnsHeader = snapshotColumn<uint32_t>(stringColumns);
+        stringColumnsHeader[0] = NUM_ENTITY_SNAPSHOT_STRING_COLUMNS;
+        for (int column = 0; column < NUM_ENTITY_SNAPSHOT_STRING_COLUMNS; ++column) {
+            stringColumnsHeader[1 + column] = ENTITY_SNAPSHOT_STRING_COLUMNS[column].property;
+        }
+        uint32_t* stringIndices = stringColumnsHeader + 1 + NUM_ENTITY_SNAPSHOT_STRING_COLUMNS;
+
+        // properties that are stored in columns, or not persisted at all
+        EntityPropertyFlags columnProperties;
+        columnProperties += PROP_SIMULATION_OWNER;
+        columnProperties += PROP_POSITION;
+        columnProperties += PROP_ROTATION;
+        columnProperties += PROP_DIMENSIONS;
+        for (auto& column : ENTITY_SNAPSHOT_STRING_COLUMNS) {
+            columnProperties += column.property;
+        }
+
+        std::vector<uint64_t> propertyOffsets { 0 };
+        propertyOffsets.reserve(numEntities + 1);
+        QByteArray propertyData;
+        QByteArray buffer;
+        int bufferSize = INITIAL_PERSIST_ENCODE_BUFFER_SIZE;
+
+        for (int i = 0; i < numEntities; ++i) {
+            auto& entity = entities[i];
+
+            EncodeBitstreamParams params;
+            EntityPropertyFlags entityProperties = entity->getEntityProperties(params);
+            EntityItemProperties properties = entity->getProperties();
+
+            EntitySnapshotRecord record;
+            memcpy(record.id, entity->getEntityItemID().toRfc4122().constData(), NUM_BYTES_RFC4122_UUID);
+            memcpy(record.lastEditedBy, properties.getLastEditedBy().toRfc4122().constData(), NUM_BYTES_RFC4122_UUID);
+            record.type = (uint32_t)properties.getType();
+            record.flags = properties.getClientOnly() ? ENTITY_SNAPSHOT_CLIENT_ONLY : 0;
+            record.created = properties.getCreated();
+            record.lastEdited = properties.getLastEdited();
+            memcpy(index.data() + i * sizeof(EntitySnapshotRecord), &record, sizeof(EntitySnapshotRecord));
+
+            glm::vec3 position = properties.getPosition();
+            glm::quat rotation = properties.getRotation();
+            glm::vec3 dimension = properties.getDimensions();
+            float* positionAt = snapshotColumn<float>(positions) + i * 3;
+            positionAt[0] = position.x;
+            positionAt[1] = position.y;
+            positionAt[2] = position.z;
+            float* rotationAt = snapshotColumn<float>(rotations) + i * 4;
+            rotationAt[0] = rotation.x;
+            rotationAt[1] = rotation.y;
+            rotationAt[2] = rotation.z;
+            rotationAt[3] = rotation.w;
+            float* dimensionAt = snapshotColumn<float>(dimensions) + i * 3;
+            dimensionAt[0] = dimension.x;
+            dimensionAt[1] = dimension.y;
+            dimensionAt[2] = dimension.z;
+
+            for (int column = 0; column < NUM_ENTITY_SNAPSHOT_STRING_COLUMNS; ++column) {
+                auto& stringColumn = ENTITY_SNAPSHOT_STRING_COLUMNS[column];
+                if (entityProperties.getHasProperty(stringColumn.property)) {
+                    stringIndices[column * numEntities + i] = strings.insert((properties.*stringColumn.get)()) + 1;
+                }
+            }
+
+            EntityPropertyFlags requestedProperties = entityProperties;
+            requestedProperties -= columnProperties;
+
+            auto appendState = encodePersistedProperties(entity, properties, requestedProperties, buffer, bufferSize);
+            if (appendState != OctreeElement::NONE) {
+                propertyData.append(buffer);
+            }
+            propertyOffsets.push_back((uint64_t)propertyData.size());
+        }
+
+        QByteArray propertiesSection(reinterpret_cast<const char*>(propertyOffsets.data()),
+                                     (int)(propertyOffsets.size() * sizeof(uint64_t)));
+        propertiesSection.append(propertyData);
+
+        writer.setNumItems(numEntities);
+        writer.addSection(ENTITY_SNAPSHOT_INDEX, index);
+        writer.addSection(ENTITY_SNAPSHOT_POSITIONS, positions);
+        writer.addSection(ENTITY_SNAPSHOT_ROTATIONS, rotations);
+        writer.addSection(ENTITY_SNAPSHOT_DIMENSIONS, dimensions);
+        writer.addSection(ENTITY_SNAPSHOT_STRINGS, strings.toByteArray());
+        writer.addSection(ENTITY_SNAPSHOT_STRING_COLUMNS, stringColumns);
+        writer.addSection(ENTITY_SNAPSHOT_PROPERTIES, propertiesSection);
+    });
+
+    return true;
+}
+
+bool EntityTree::readFromSnapshot(const OctreeSnapshotReader& reader) {
+    const uint64_t numEntities = reader.getNumItems();
+
+    uint64_t indexSize, positionsSize, rotationsSize, dimensionsSize, stringsSize, stringColumnsSize, propertiesSize;
+    const char* index = reader.getSection(ENTITY_SNAPSHOT_INDEX, indexSize);
+    const char* positions = reader.getSection(ENTITY_SNAPSHOT_POSITIONS, positionsSize);
+    const char* rotations = reader.getSection(ENTITY_SNAPSHOT_ROTATIONS, rotationsSize);
+    const char* dimensions = reader.getSection(ENTITY_SNAPSHOT_DIMENSIONS, dimensionsSize);
+    const char* stringsData = reader.getSection(ENTITY_SNAPSHOT_STRINGS, stringsSize);
+    const char* stringColumns = reader.getSection(ENTITY_SNAPSHOT_STRING_COLUMNS, stringColumnsSize);
+    const char* propertiesSection = reader.getSection(ENTITY_SNAPSHOT_PROPERTIES, propertiesSize);
+
+    OctreeSnapshotStringTableReader strings;
+    uint32_t numStringColumns = 0;
+    if (stringColumns && stringColumnsSize >= sizeof(uint32_t)) {
+        memcpy(&numStringColumns, stringColumns, sizeof(uint32_t));
+    }
+    const uint64_t propertyOffsetsSize = (numEntities + 1) * sizeof(uint64_t);
+
+    bool isValid = index && indexSize == numEntities * sizeof(EntitySnapshotRecord) &&
+        positions && positionsSize == numEntities * 3 * sizeof(float) &&
+        rotations && rotationsSize == numEntities * 4 * sizeof(float) &&
+        dimensions && dimensionsSize == numEntities * 3 * sizeof(float) &&
+        strings.init(stringsData, stringsSize) &&
+        stringColumns && stringColumnsSize == (1 + numStringColumns + numStringColumns * numEntities) * sizeof(uint32_t) &&
+        propertiesSection && propertiesSize >= propertyOffsetsSize;
+    if (!isValid) {
+        qCWarning(entities) << "Snapshot is missing entity data";
+        return false;
+    }
+
+    _persistID = reader.getID();
+    _persistDataVersion = reader.getDataVersion();
+    _namedPaths.clear();
+
+    // match the string columns of the snapshot with ours
+    const uint32_t* stringColumnProperties = reinterpret_cast<const uint32_t*>(stringColumns) + 1;
+    const uint32_t* stringIndices = stringColumnProperties + numStringColumns;
+    std::vector<std::pair<const EntitySnapshotStringColumn*, const uint32_t*>> stringColumnsToRead;
+    for (uint32_t columnIndex = 0; columnIndex < numStringColumns; ++columnIndex) {
+        for (auto& column : ENTITY_SNAPSHOT_STRING_COLUMNS) {
+            if ((uint32_t)column.property == stringColumnProperties[columnIndex]) {
+                stringColumnsToRead.emplace_back(&column, stringIndices + columnIndex * numEntities);
+            }
+        }
+    }
+
+    const uint64_t* propertyOffsets = reinterpret_cast<const uint64_t*>(propertiesSection);
+    const unsigned char* propertyData = reinterpret_cast<const unsigned char*>(propertiesSection) + propertyOffsetsSize;
+    const uint64_t propertyDataSize = propertiesSize - propertyOffsetsSize;
+
+    const float* positionAt = reinterpret_cast<const float*>(positions);
+    const float* rotationAt = reinterpret_cast<const float*>(rotations);
+    const float* dimensionAt = reinterpret_cast<const float*>(dimensions);
+
+    QUuid myNodeID;
+    bool success = true;
+    for (uint64_t i = 0; i < numEntities; ++i) {
+        EntitySnapshotRecord record;
+        memcpy(&record, index + i * sizeof(EntitySnapshotRecord), sizeof(EntitySnapshotRecord));
+        EntityItemID entityItemID(QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(record.id),
+                                                                             NUM_BYTES_RFC4122_UUID)));
+
+        EntityItemProperties properties;
+
+        uint64_t propertiesStart = propertyOffsets[i];
+        uint64_t propertiesEnd = propertyOffsets[i + 1];
+        if (propertiesStart > propertiesEnd || propertiesEnd > propertyDataSize) {
+            qCWarning(entities) << "Snapshot has invalid properties for entity" << entityItemID;
+            success = false;
+            continue;
+        }
+        if (propertiesEnd > propertiesStart) {
+            int processedBytes = 0;
+            EntityItemID decodedID;
+            EntityItemProperties::decodeEntityEditPacket(propertyData + propertiesStart, (int)(propertiesEnd - propertiesStart),
+                                                         processedBytes, decodedID, properties);
+        }
+
+        properties.setType((EntityTypes::EntityType)record.type);
+        properties.setCreated(record.created);
+        properties.setLastEdited(record.lastEdited);
+        properties.setLastEditedBy(QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(record.lastEditedBy),
+                                                                              NUM_BYTES_RFC4122_UUID)));
+
+        properties.setPosition(glm::vec3(positionAt[i * 3], positionAt[i * 3 + 1], positionAt[i * 3 + 2]));
+        properties.setRotation(glm::quat(rotationAt[i * 4 + 3], rotationAt[i * 4], rotationAt[i * 4 + 1], rotationAt[i * 4 + 2]));
+        properties.setDimensions(glm::vec3(dimensionAt[i * 3], dimensionAt[i * 3 + 1], dimensionAt[i * 3 + 2]));
+
+        for (auto& stringColumn : stringColumnsToRead) {
+            uint32_t stringIndex = stringColumn.second[i];
+            QString string;
+            if (stringIndex > 0 && strings.getString(stringIndex - 1, string)) {
+                (properties.*stringColumn.first->set)(string);
+            }
+        }
+
+        if (record.flags & ENTITY_SNAPSHOT_CLIENT_ONLY) {
+            properties.setClientOnly(true);
+            if (myNodeID.isNull()) {
+                myNodeID = DependencyManager::get<NodeList>()->getSessionUUID();
+            }
+            properties.setOwningAvatarID(myNodeID);
+        }
+
+        EntityItemPointer entity = addEntity(entityItemID, properties);
+        if (!entity) {
+            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+void EntityTree::trackEditLogChange(const EntityItemID& entityID) {
+    if (_editLogEnabled) {
+        QMutexLocker locker(&_editLogMutex);
+        _editLogChangedEntities.insert(entityID);
+        _editLogErasedEntities.remove(entityID);
+    }
+}
+
+void EntityTree::trackEditLogErase(const EntityItemID& entityID) {
+    if (_editLogEnabled) {
+        QMutexLocker locker(&_editLogMutex);
+        _editLogChangedEntities.remove(entityID);
+        _editLogErasedEntities.insert(entityID);
+    }
+}
+
+void EntityTree::setWantEditLog(bool wantEditLog) {
+    QMutexLocker locker(&_editLogMutex);
+    _editLogEnabled = wantEditLog;
+    _editLogChangedEntities.clear();
+    _editLogErasedEntities.clear();
+}
+
+// An upsert record holds the created time of the entity, then its persisted properties, edit encoded.
+// NOTE: callers must read lock the tree
+void EntityTree::appendEditsToLog(OctreeEditLog& editLog) {
+    // take the tracked edits, so that edits made while they are encoded are tracked for the next append
+    QSet<EntityItemID> changedEntities;
+    QSet<EntityItemID> erasedEntities;
+    {
+        QMutexLocker locker(&_editLogMutex);
+        changedEntities.swap(_editLogChangedEntities);
+        erasedEntities.swap(_editLogErasedEntities);
+    }
+
+    // changes go first: replaying the erase of a former parent would also erase the children it no longer has
+    QByteArray buffer;
+    int bufferSize = INITIAL_PERSIST_ENCODE_BUFFER_SIZE;
+    foreach (const EntityItemID& entityID, changedEntities) {
+        EntityItemPointer entity = findEntityByEntityItemID(entityID);
+        if (!entity) {
+            continue;
+        }
+
+        EncodeBitstreamParams params;
+        EntityPropertyFlags requestedProperties = entity->getEntityProperties(params);
+        requestedProperties -= PROP_SIMULATION_OWNER;
+        EntityItemProperties properties = entity->getProperties();
+
+        quint64 created = properties.getCreated();
+        QByteArray data(reinterpret_cast<const char*>(&created), sizeof(created));
+        if (encodePersistedProperties(entity, properties, requestedProperties, buffer, bufferSize) != OctreeElement::NONE) {
+            data.append(buffer);
+        }
+        editLog.appendRecord(OctreeEditLog::UPSERT_RECORD, entityID, data);
+    }
+
+    foreach (const EntityItemID& entityID, erasedEntities) {
+        editLog.appendRecord(OctreeEditLog::ERASE_RECORD, entityID);
+    }
+}
+
+bool EntityTree::replayEditLogRecord(const OctreeEditLogRecord& record) {
+    EntityItemID entityItemID(record.id);
+
+    if (record.type == OctreeEditLog::ERASE_RECORD) {
+        deleteEntity(entityItemID, true, true);
+        return true;
+    }
+
+    quint64 created;
+    if (record.type != OctreeEditLog::UPSERT_RECORD || record.size < (int)sizeof(created)) {
+        return false;
+    }
+    memcpy(&created, record.data, sizeof(created));
+
+    EntityItemProperties properties;
+    if (record.size > (int)sizeof(created)) {
+        int processedBytes = 0;
+        EntityItemID decodedID;
+        if (!EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(record.data) + sizeof(created),
+                                                          record.size - (int)sizeof(created), processedBytes, decodedID, properties)) {
+            return false;
+        }
+    }
+    properties.setCreated(created);
+
+    EntityItemPointer entity = findEntityByEntityItemID(entityItemID);
+    if (!entity) {
+        return (bool)addEntity(entityItemID, properties);
+    }
+
+    // unlike updateEntity, this restores the entity as it was, locked or not and whoever edited it
+    EntityTreeElementPointer containingElement = entity->getElement();
+    if (!containingElement) {
+        return false;
+    }
+
+    AACube newQueryAACube = properties.queryAACubeChanged() ? properties.getQueryAACube() : entity->getQueryAACube();
+    UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
+    recurseTreeWithOperator(&theOperator);
+    entity->setProperties(properties);
+    updateDescendantsInTree(entity);
+    if (!entity->getParentID().isNull()) {
+        addToNeedsParentFixupList(entity);
+    }
+
+    if (entity->isSimulated() && (entity->getDirtyFlags() & DIRTY_SIMULATION_FLAGS)) {
+        _simulation->changeEntity(entity);
+    }
+    _isDirty = true;
+    return true;
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
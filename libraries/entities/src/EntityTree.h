@@ -12,6 +12,7 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <QMutex>
 #include <QSet>
 #include <QVector>
 
@@ -19,9 +20,11 @@
 #include <SpatialParentFinder.h>
 
 #include "AddEntityOperator.h"
+#include "EntityBulkQuery.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
+#include "ShardedEntityMap.h"
 
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
@@ -159,6 +162,10 @@ public:
     /// \parameter foundEntities[out] vector of EntityItemPointer
     void findEntities(RecurseOctreeOperation& scanOperator, QVector<EntityItemPointer>& foundEntities);
 
+    /// finds the entities of every query of a batch in a single traversal of the tree
+    /// \parameter query[in,out] the queries, which are each given the same entities the findEntities for it would find
+    void findEntities(EntityBulkQuery& query);
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -216,6 +223,12 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
+    virtual bool writeToSnapshot(OctreeSnapshotWriter& writer, const OctreeElementPointer& element) override;
+    virtual bool readFromSnapshot(const OctreeSnapshotReader& reader) override;
+    virtual bool supportsEditLog() const override { return true; }
+    virtual void setWantEditLog(bool wantEditLog) override;
+    virtual void appendEditsToLog(OctreeEditLog& editLog) override;
+    virtual bool replayEditLogRecord(const OctreeEditLogRecord& record) override;
 
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
@@ -309,6 +322,7 @@ protected:
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
             const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
+    void updateDescendantsInTree(const EntityItemPointer& entity);
     static bool findNearPointOperation(const OctreeElementPointer& element, void* extraData);
     static bool findInSphereOperation(const OctreeElementPointer& element, void* extraData);
     static bool findInCubeOperation(const OctreeElementPointer& element, void* extraData);
@@ -340,8 +354,7 @@ protected:
         _deletedEntityItemIDs << id;
     }
 
-    mutable QReadWriteLock _entityMapLock;
-    QHash<EntityItemID, EntityItemPointer> _entityMap;
+    ShardedEntityMap _entityMap;
 
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, EntityItemID> _entityCertificateIDMap;
@@ -410,6 +423,14 @@ private:
     bool _serverlessDomain { false };
 
     std::map<QString, QString> _namedPaths;
+
+    // changes since they were last appended to the edit log, when persisting with one
+    void trackEditLogChange(const EntityItemID& entityID);
+    void trackEditLogErase(const EntityItemID& entityID);
+    bool _editLogEnabled { false };
+    QMutex _editLogMutex; // so that tracked edits can be taken while the tree is only read locked
+    QSet<EntityItemID> _editLogChangedEntities;
+    QSet<EntityItemID> _editLogErasedEntities;
 };
 
 #endif // hifi_EntityTree_h
@@ -301,6 +301,47 @@ EntityItemPointer EntityTreeElement::getClosestEntity(glm::vec3 position) const
     return closestEntity;
 }
 
+bool EntityTreeElement::sphereTouchesEntityShape(const EntityItemPointer& entity, const glm::vec3& searchPosition,
+                                                 float searchRadius) {
+    glm::vec3 penetration;
+    glm::vec3 dimensions = entity->getScaledDimensions();
+
+    // FIXME - consider allowing the entity to determine penetration so that
+    //         entities could presumably dull actuall hull testing if they wanted to
+    // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+    //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+    //         with centered registration points
+    if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
+        (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
+
+        // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
+        //       maximum bounding sphere, which is actually larger than our actual radius
+        float entityTrueRadius = dimensions.x / 2.0f;
+
+        bool success;
+        if (findSphereSpherePenetration(searchPosition, searchRadius,
+                entity->getCenterPosition(success), entityTrueRadius, penetration)) {
+            return success;
+        }
+        return false;
+    }
+
+    // determine the worldToEntityMatrix that doesn't include scale because
+    // we're going to use the registration aware aa box in the entity frame
+    glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
+    glm::mat4 translation = glm::translate(entity->getWorldPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
+    return entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration);
+}
+
 // TODO: change this to use better bounding shape for entity than sphere
 void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searchRadius, QVector<EntityItemPointer>& foundEntities) const {
     forEachEntity([&](EntityItemPointer entity) {
@@ -311,45 +352,8 @@ void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searc
         // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
         glm::vec3 penetration;
         if (!success || entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
-
-            glm::vec3 dimensions = entity->getScaledDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably dull actuall hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
-                (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                if (findSphereSpherePenetration(searchPosition, searchRadius,
-                        entity->getCenterPosition(success), entityTrueRadius, penetration)) {
-                    if (success) {
-                        foundEntities.push_back(entity);
-                    }
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint);
-
-                AABox entityFrameBox(corner, dimensions);
-
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration)) {
-                    foundEntities.push_back(entity);
-                }
+            if (sphereTouchesEntityShape(entity, searchPosition, searchRadius)) {
+                foundEntities.push_back(entity);
             }
         }
     });
@@ -174,6 +174,9 @@ public:
     /// \param entities[out] vector of const EntityItemPointer
     void getEntities(const glm::vec3& position, float radius, QVector<EntityItemPointer>& foundEntities) const;
 
+    /// whether a sphere that touches the world frame AABox of an entity touches its shape too
+    static bool sphereTouchesEntityShape(const EntityItemPointer& entity, const glm::vec3& position, float radius);
+
     /// finds all entities that touch a box
     /// \param box the query box
     /// \param entities[out] vector of non-const EntityItemPointer
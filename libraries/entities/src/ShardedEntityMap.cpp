@@ -0,0 +1,77 @@
+//
+//  ShardedEntityMap.cpp
+//  libraries/entities/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShardedEntityMap.h"
+
+#include <algorithm>
+
+ShardedEntityMap::ShardedEntityMap(int numShards) :
+    _numShards(std::max(1, numShards)),
+    _shards(new Shard[_numShards])
+{
+}
+
+EntityItemPointer ShardedEntityMap::value(const EntityItemID& id) const {
+    Shard& shard = shardFor(id);
+    QReadLocker locker(&shard.lock);
+    return shard.map.value(id);
+}
+
+bool ShardedEntityMap::insert(const EntityItemID& id, const EntityItemPointer& entity) {
+    Shard& shard = shardFor(id);
+    QWriteLocker locker(&shard.lock);
+    if (shard.map.contains(id)) {
+        return false;
+    }
+    shard.map.insert(id, entity);
+    return true;
+}
+
+void ShardedEntityMap::remove(const EntityItemID& id) {
+    Shard& shard = shardFor(id);
+    QWriteLocker locker(&shard.lock);
+    shard.map.remove(id);
+}
+
+QHash<EntityItemID, EntityItemPointer> ShardedEntityMap::takeAll() {
+    QHash<EntityItemID, EntityItemPointer> all;
+    for (int i = 0; i < _numShards; ++i) {
+        QHash<EntityItemID, EntityItemPointer> shardMap;
+        {
+            QWriteLocker locker(&_shards[i].lock);
+            shardMap.swap(_shards[i].map);
+        }
+        if (all.isEmpty()) {
+            all.swap(shardMap);
+        } else {
+            all.unite(shardMap);
+        }
+    }
+    return all;
+}
+
+QHash<EntityItemID, EntityItemPointer> ShardedEntityMap::toHash() const {
+    QHash<EntityItemID, EntityItemPointer> all;
+    for (int i = 0; i < _numShards; ++i) {
+        QReadLocker locker(&_shards[i].lock);
+        all.unite(_shards[i].map);
+    }
+    return all;
+}
+
+int ShardedEntityMap::size() const {
+    int size = 0;
+    for (int i = 0; i < _numShards; ++i) {
+        QReadLocker locker(&_shards[i].lock);
+        size += _shards[i].map.size();
+    }
+    return size;
+}
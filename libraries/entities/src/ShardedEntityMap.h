@@ -0,0 +1,64 @@
+//
+//  ShardedEntityMap.h
+//  libraries/entities/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShardedEntityMap_h
+#define hifi_ShardedEntityMap_h
+
+#include <memory>
+
+#include <QHash>
+#include <QReadWriteLock>
+
+#include "EntityItemID.h"
+#include "EntityTypes.h"
+
+// Map of entities by id that is split into shards, each with its own lock
+//   The entity map is read from the packet processing, send, script and simulation threads, while edits add and
+//   remove entities. With a single lock, every add or remove blocked all of those readers. Here a writer only locks
+//   the shard of its id, so lookups of ids in the other shards go on.
+class ShardedEntityMap {
+public:
+    static const int DEFAULT_NUM_SHARDS = 64;
+
+    ShardedEntityMap(int numShards = DEFAULT_NUM_SHARDS);
+
+    EntityItemPointer value(const EntityItemID& id) const;
+
+    // returns false, leaving the map as it is, if there already is an entity with that id
+    bool insert(const EntityItemID& id, const EntityItemPointer& entity);
+    void remove(const EntityItemID& id);
+
+    // empty the map, returning what was in it
+    QHash<EntityItemID, EntityItemPointer> takeAll();
+
+    // a copy of the map, shard by shard, so it isn't a snapshot of a single moment when there are concurrent writes
+    QHash<EntityItemID, EntityItemPointer> toHash() const;
+
+    int size() const;
+    int getNumShards() const { return _numShards; }
+
+private:
+    static const int CACHE_LINE_SIZE = 64;
+
+    // padded so that the locks of neighbouring shards aren't on the same cache line
+    struct Shard {
+        mutable QReadWriteLock lock;
+        QHash<EntityItemID, EntityItemPointer> map;
+        char padding[CACHE_LINE_SIZE];
+    };
+
+    Shard& shardFor(const EntityItemID& id) const { return _shards[qHash(id) % (uint)_numShards]; }
+
+    int _numShards;
+    std::unique_ptr<Shard[]> _shards;
+};
+
+#endif // hifi_ShardedEntityMap_h
@@ -17,34 +17,146 @@
 #include <QUuid>
 #include "NetworkLogging.h"
 #include <cassert>
+#include <cstring>
+#include <unordered_map>
+
+static const int SIPHASH_KEY_BYTES = 16;
+static const int SIPHASH_HASH_BYTES = 16;
+
+// contexts kept by each thread before they are all dropped, in case many nodes came and went
+static const size_t MAX_THREAD_CONTEXTS = 1024;
+
+static std::atomic<uint64_t> nextKeyGeneration { 1 };
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
-HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(HMAC_CTX_new())
-    , _authMethod(authMethod) { }
+static hmac_ctx_st* newHMACContext() {
+    return HMAC_CTX_new();
+}
 
-HMACAuth::~HMACAuth()
-{
-    HMAC_CTX_free(_hmacContext);
+static void freeHMACContext(hmac_ctx_st* hmacContext) {
+    HMAC_CTX_free(hmacContext);
 }
 
 #else
 
-HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(new HMAC_CTX())
-    , _authMethod(authMethod) {
-    HMAC_CTX_init(_hmacContext);
+static hmac_ctx_st* newHMACContext() {
+    auto hmacContext = new HMAC_CTX();
+    HMAC_CTX_init(hmacContext);
+    return hmacContext;
 }
 
-HMACAuth::~HMACAuth() {
-    HMAC_CTX_cleanup(_hmacContext);
-    delete _hmacContext;
+static void freeHMACContext(hmac_ctx_st* hmacContext) {
+    HMAC_CTX_cleanup(hmacContext);
+    delete hmacContext;
 }
 #endif
 
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t readLittleEndian64(const unsigned char* bytes) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static inline void writeLittleEndian64(unsigned char* bytes, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+#define SIP_ROUND                                                                                  \
+    do {                                                                                           \
+        v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32);                      \
+        v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;                                               \
+        v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;                                               \
+        v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32);                      \
+    } while (0)
+
+// SipHash-2-4 with a 128 bit result
+static void sipHash128(const uint64_t key[2], const char* data, int dataLen, unsigned char* hash) {
+    uint64_t v0 = 0x736f6d6570736575ULL ^ key[0];
+    uint64_t v1 = 0x646f72616e646f6dULL ^ key[1] ^ 0xee;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ key[0];
+    uint64_t v3 = 0x7465646279746573ULL ^ key[1];
+
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    const unsigned char* end = bytes + (dataLen - dataLen % 8);
+    for (; bytes != end; bytes += 8) {
+        uint64_t word = readLittleEndian64(bytes);
+        v3 ^= word;
+        SIP_ROUND;
+        SIP_ROUND;
+        v0 ^= word;
+    }
+
+    uint64_t last = (uint64_t)dataLen << 56;
+    for (int i = dataLen % 8 - 1; i >= 0; --i) {
+        last |= (uint64_t)bytes[i] << (8 * i);
+    }
+    v3 ^= last;
+    SIP_ROUND;
+    SIP_ROUND;
+    v0 ^= last;
+
+    v2 ^= 0xee;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    writeLittleEndian64(hash, v0 ^ v1 ^ v2 ^ v3);
+
+    v1 ^= 0xdd;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    writeLittleEndian64(hash + 8, v0 ^ v1 ^ v2 ^ v3);
+}
+
+#undef SIP_ROUND
+
+struct HMACAuth::ThreadContext {
+    ThreadContext() : hmacContext(newHMACContext()) { }
+    ~ThreadContext() { freeHMACContext(hmacContext); }
+    ThreadContext(const ThreadContext&) = delete;
+    ThreadContext& operator=(const ThreadContext&) = delete;
+
+    uint64_t keyGeneration { 0 };
+    bool isKeyed { false };
+    AuthMethod authMethod { MD5 };
+    hmac_ctx_st* hmacContext;
+    uint64_t sipKey[2] { 0, 0 };
+};
+
+HMACAuth::HMACAuth(AuthMethod authMethod)
+    : _hmacContext(newHMACContext())
+    , _authMethod(authMethod)
+    , _keyedAuthMethod(authMethod) { }
+
+HMACAuth::~HMACAuth() {
+    freeHMACContext(_hmacContext);
+}
+
+void HMACAuth::setAuthMethod(AuthMethod authMethod) {
+    QMutexLocker lock(&_lock);
+    _authMethod = authMethod;
+}
+
+HMACAuth::AuthMethod HMACAuth::getAuthMethod() const {
+    QMutexLocker lock(&_lock);
+    return _authMethod;
+}
+
 bool HMACAuth::setKey(const char* keyValue, int keyLen) {
     const EVP_MD* sslStruct = nullptr;
 
+    QMutexLocker lock(&_lock);
+
     switch (_authMethod) {
     case MD5:
         sslStruct = EVP_md5();
@@ -66,12 +178,28 @@ bool HMACAuth::setKey(const char* keyValue, int keyLen) {
         sslStruct = EVP_ripemd160();
         break;
 
+    case SIPHASH: {
+        // the connection secrets are UUIDs, exactly one key - fold anything longer into it
+        unsigned char sipKey[SIPHASH_KEY_BYTES] = { 0 };
+        for (int i = 0; i < keyLen; ++i) {
+            sipKey[i % SIPHASH_KEY_BYTES] ^= (unsigned char)keyValue[i];
+        }
+        _sipKey[0] = readLittleEndian64(sipKey);
+        _sipKey[1] = readLittleEndian64(sipKey + 8);
+        _sipData.clear();
+        _keyedAuthMethod = SIPHASH;
+        _keyGeneration = nextKeyGeneration++;
+        return true;
+    }
+
     default:
         return false;
     }
 
-    QMutexLocker lock(&_lock);
-    return (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
+    bool isKeyed = (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
+    _keyedAuthMethod = _authMethod;
+    _keyGeneration = nextKeyGeneration++;
+    return isKeyed;
 }
 
 bool HMACAuth::setKey(const QUuid& uidKey) {
@@ -81,6 +209,10 @@ bool HMACAuth::setKey(const QUuid& uidKey) {
 
 bool HMACAuth::addData(const char* data, int dataLen) {
     QMutexLocker lock(&_lock);
+    if (_keyedAuthMethod == SIPHASH) {
+        _sipData.insert(_sipData.end(), data, data + dataLen);
+        return true;
+    }
     return (bool) HMAC_Update(_hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen);
 }
 
@@ -88,6 +220,13 @@ HMACAuth::HMACHash HMACAuth::result() {
     HMACHash hashValue(EVP_MAX_MD_SIZE);
     unsigned int hashLen;
     QMutexLocker lock(&_lock);
+
+    if (_keyedAuthMethod == SIPHASH) {
+        hashValue.resize(SIPHASH_HASH_BYTES);
+        sipHash128(_sipKey, _sipData.data(), (int)_sipData.size(), hashValue.data());
+        _sipData.clear();
+        return hashValue;
+    }
     
     auto hmacResult = HMAC_Final(_hmacContext, &hashValue[0], &hashLen);
     
@@ -104,14 +243,64 @@ HMACAuth::HMACHash HMACAuth::result() {
     return hashValue;
 }
 
-bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
+HMACAuth::ThreadContext& HMACAuth::getThreadContext() {
+    static thread_local std::unordered_map<const HMACAuth*, ThreadContext> threadContexts;
+
+    auto it = threadContexts.find(this);
+    if (it != threadContexts.end() && it->second.keyGeneration == _keyGeneration.load(std::memory_order_acquire)) {
+        return it->second;
+    }
+
+    if (it == threadContexts.end() && threadContexts.size() >= MAX_THREAD_CONTEXTS) {
+        threadContexts.clear();
+    }
+
+    // clone the keyed context, this is the only time a thread takes the lock to hash
+    auto& context = threadContexts[this];
     QMutexLocker lock(&_lock);
-    if (!addData(data, dataLen)) {
-        qCWarning(networking) << "Error occured calling HMACAuth::addData()";
+    context.keyGeneration = _keyGeneration;
+    context.authMethod = _keyedAuthMethod;
+    if (_keyedAuthMethod == SIPHASH) {
+        context.sipKey[0] = _sipKey[0];
+        context.sipKey[1] = _sipKey[1];
+        context.isKeyed = true;
+    } else {
+        // start from a fresh context, older OpenSSL versions do not clean up the destination of a copy
+        freeHMACContext(context.hmacContext);
+        context.hmacContext = newHMACContext();
+        context.isKeyed = (bool) HMAC_CTX_copy(context.hmacContext, _hmacContext);
+    }
+    return context;
+}
+
+bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
+    auto& context = getThreadContext();
+
+    if (context.isKeyed && context.authMethod == SIPHASH) {
+        hashResult.resize(SIPHASH_HASH_BYTES);
+        sipHash128(context.sipKey, data, dataLen, hashResult.data());
+        return true;
+    }
+
+    if (!context.isKeyed || !HMAC_Update(context.hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen)) {
+        qCWarning(networking) << "Error occured calling HMAC_Update";
         assert(false);
         return false;
     }
 
-    hashResult = result();
-    return true;
+    hashResult.resize(EVP_MAX_MD_SIZE);
+    unsigned int hashLen;
+    auto hmacResult = HMAC_Final(context.hmacContext, hashResult.data(), &hashLen);
+
+    if (hmacResult) {
+        hashResult.resize((size_t)hashLen);
+    } else {
+        // the HMAC_FINAL call failed - should not be possible to get into this state
+        qCWarning(networking) << "Error occured calling HMAC_Final";
+        assert(hmacResult);
+    }
+
+    // Clear state for the next hash on this thread.
+    HMAC_Init_ex(context.hmacContext, nullptr, 0, nullptr, nullptr);
+    return (bool) hmacResult;
 }
@@ -12,20 +12,30 @@
 #ifndef hifi_HMACAuth_h
 #define hifi_HMACAuth_h
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <QtCore/QMutex>
 
 class QUuid;
 
+// Keyed hash of packets, for verification of sourced packets
+//   calculateHash does not take the lock. Each thread hashes with its own clone of the keyed context,
+//   taken on first use and again whenever the key changes, so that the mixer slaves can sign and verify
+//   packets for the same node at once.
 class HMACAuth {
 public:
-    enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160 };
+    // SIPHASH is SipHash-2-4 with a 128 bit result, a keyed MAC much cheaper than HMAC that fits the MD5 hash field
+    enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160, SIPHASH };
     using HMACHash = std::vector<unsigned char>;
     
     explicit HMACAuth(AuthMethod authMethod = MD5);
     ~HMACAuth();
 
+    // the method takes effect on the next call to setKey
+    void setAuthMethod(AuthMethod authMethod);
+    AuthMethod getAuthMethod() const;
+
     bool setKey(const char* keyValue, int keyLen);
     bool setKey(const QUuid& uidKey);
     // Calculate complete hash in one.
@@ -39,9 +49,18 @@ public:
     HMACHash result();
 
 private:
-    QMutex _lock { QMutex::Recursive };
+    struct ThreadContext;
+    ThreadContext& getThreadContext();
+
+    mutable QMutex _lock { QMutex::Recursive };
     struct hmac_ctx_st* _hmacContext;
     AuthMethod _authMethod;
+    AuthMethod _keyedAuthMethod; // the method of the current key
+    uint64_t _sipKey[2] { 0, 0 };
+    std::vector<char> _sipData; // data appended with addData, for SIPHASH
+
+    // unique across instances, so that a thread never mistakes the context of a deleted instance for this one
+    std::atomic<uint64_t> _keyGeneration { 0 };
 };
 
 #endif  // hifi_HMACAuth_h
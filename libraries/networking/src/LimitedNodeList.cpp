@@ -55,6 +55,13 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
 {
     qRegisterMetaType<ConnectionStep>("ConnectionStep");
     auto port = (socketListenPort != INVALID_PORT) ? socketListenPort : LIMITED_NODELIST_LOCAL_PORT.get();
+
+    // busy servers can read datagrams in batches on dedicated threads (Linux only)
+    const char* HIFI_RECEIVE_THREADS_ENV = "HIFI_UDT_RECEIVE_THREADS";
+    if (qEnvironmentVariableIsSet(HIFI_RECEIVE_THREADS_ENV)) {
+        _nodeSocket.setNumReceiveThreads(qEnvironmentVariableIntValue(HIFI_RECEIVE_THREADS_ENV));
+    }
+
     _nodeSocket.bind(QHostAddress::AnyIPv4, port);
     qCDebug(networking) << "NodeList socket is listening on" << _nodeSocket.localPort();
 
@@ -181,6 +188,20 @@ void LimitedNodeList::setPermissions(const NodePermissions& newPermissions) {
     }
 }
 
+void LimitedNodeList::setAuthenticationMethod(HMACAuth::AuthMethod authenticationMethod) {
+    if (_authenticationMethod == authenticationMethod) {
+        return;
+    }
+
+    qCDebug(networking) << "Switching packet authentication method to" << authenticationMethod;
+    _authenticationMethod = authenticationMethod;
+
+    // re-key the nodes we already know with the new method
+    eachNode([authenticationMethod](const SharedNodePointer& node) {
+        node->setConnectionSecret(node->getConnectionSecret(), authenticationMethod);
+    });
+}
+
 void LimitedNodeList::setSocketLocalPort(quint16 socketLocalPort) {
     if (QThread::currentThread() != thread()) {
         QMetaObject::invokeMethod(this, "setSocketLocalPort", Qt::QueuedConnection,
@@ -339,7 +360,7 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
                     expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
                 }
 
-                // check if the HMAC-md5 hash in the header matches the hash we would expect
+                // check if the keyed hash in the header matches the hash we would expect
                 if (!sourceNodeHMACAuth || packetHeaderHash != expectedHash) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
@@ -601,6 +622,9 @@ void LimitedNodeList::eraseAllNodes() {
 void LimitedNodeList::reset() {
     eraseAllNodes();
 
+    // the next domain negotiates its own packet authentication
+    _authenticationMethod = HMACAuth::MD5;
+
     // we need to make sure any socket connections are gone so wait on that here
     _nodeSocket.clearConnections();
     _connectionIDs.clear();
@@ -668,7 +692,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         matchingNode->setPublicSocket(publicSocket);
         matchingNode->setLocalSocket(localSocket);
         matchingNode->setPermissions(permissions);
-        matchingNode->setConnectionSecret(connectionSecret);
+        matchingNode->setConnectionSecret(connectionSecret, _authenticationMethod);
         matchingNode->setIsReplicated(isReplicated);
         matchingNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
         matchingNode->setLocalID(localID);
@@ -684,7 +708,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         Node* newNode = new Node(uuid, nodeType, publicSocket, localSocket);
         newNode->setIsReplicated(isReplicated);
         newNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
-        newNode->setConnectionSecret(connectionSecret);
+        newNode->setConnectionSecret(connectionSecret, _authenticationMethod);
         newNode->setPermissions(permissions);
         newNode->setLocalID(localID);
 
@@ -114,6 +114,10 @@ public:
     void setSessionLocalID(Node::LocalID localID);
 
     void setPermissions(const NodePermissions& newPermissions);
+
+    // the keyed hash used to verify packets between nodes, negotiated by the domain
+    HMACAuth::AuthMethod getAuthenticationMethod() const { return _authenticationMethod; }
+    void setAuthenticationMethod(HMACAuth::AuthMethod authenticationMethod);
     bool isAllowedEditor() const { return _permissions.can(NodePermissions::Permission::canAdjustLocks); }
     bool getThisNodeCanRez() const { return _permissions.can(NodePermissions::Permission::canRezPermanentEntities); }
     bool getThisNodeCanRezTmp() const { return _permissions.can(NodePermissions::Permission::canRezTemporaryEntities); }
@@ -140,6 +144,11 @@ public:
     qint64 sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode);
     qint64 sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
 
+    // between beginSendBatch and flushSendBatch, unreliable packets sent from the calling thread are queued
+    // and then sent together when the batch is flushed - they are still accounted for when queued
+    void beginSendBatch() { _nodeSocket.beginDatagramBatch(); }
+    void flushSendBatch() { _nodeSocket.flushDatagramBatch(); }
+
     // use sendPacket to send a moved unreliable or reliable NL packet to a node's active socket or manual sockaddr
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
@@ -301,6 +310,7 @@ public:
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    bool setConnectionCongestionControl(const QString& name) { return _nodeSocket.setCongestionControl(name); }
 
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
@@ -402,6 +412,7 @@ protected:
 
     QElapsedTimer _packetStatTimer;
     NodePermissions _permissions;
+    HMACAuth::AuthMethod _authenticationMethod { HMACAuth::MD5 };
 
     QPointer<QTimer> _initialSTUNTimer;
 
@@ -196,15 +196,17 @@ QDebug operator<<(QDebug debug, const Node& node) {
     return debug.nospace();
 }
 
-void Node::setConnectionSecret(const QUuid& connectionSecret) {
-    if (_connectionSecret == connectionSecret) {
+void Node::setConnectionSecret(const QUuid& connectionSecret, HMACAuth::AuthMethod authMethod) {
+    if (_connectionSecret == connectionSecret && _authenticateHash && _authenticateHash->getAuthMethod() == authMethod) {
         return;
     }
 
     if (!_authenticateHash) {
-        _authenticateHash.reset(new HMACAuth());
+        _authenticateHash.reset(new HMACAuth(authMethod));
     }
 
+    // the hash is re-keyed in place, since other threads may be signing or verifying with it
     _connectionSecret = connectionSecret;
+    _authenticateHash->setAuthMethod(authMethod);
     _authenticateHash->setKey(_connectionSecret);
 }
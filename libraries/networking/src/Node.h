@@ -56,7 +56,7 @@ public:
     void setIsUpstream(bool isUpstream) { _isUpstream = isUpstream; }
 
     const QUuid& getConnectionSecret() const { return _connectionSecret; }
-    void setConnectionSecret(const QUuid& connectionSecret);
+    void setConnectionSecret(const QUuid& connectionSecret, HMACAuth::AuthMethod authMethod = HMACAuth::MD5);
     HMACAuth* getAuthenticateHash() const { return _authenticateHash.get(); }
 
     NodeData* getLinkedData() const { return _linkedData.get(); }
@@ -84,6 +84,12 @@ public:
     void addIgnoredNode(const QUuid& otherNodeID);
     void removeIgnoredNode(const QUuid& otherNodeID);
     bool isIgnoringNodeWithID(const QUuid& nodeID) const { QReadLocker lock { &_ignoredNodeIDSetLock }; return _ignoredNodeIDSet.find(nodeID) != _ignoredNodeIDSet.cend(); }
+    template <typename F> void eachIgnoredNodeID(F functor) const {
+        QReadLocker lock { &_ignoredNodeIDSetLock };
+        for (const QUuid& nodeID : _ignoredNodeIDSet) {
+            functor(nodeID);
+        }
+    }
     void parseIgnoreRadiusRequestMessage(QSharedPointer<ReceivedMessage> message);
 
     friend QDataStream& operator<<(QDataStream& out, const Node& node);
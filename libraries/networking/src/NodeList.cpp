@@ -654,6 +654,11 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
+    // pull the packet authentication method of this domain, before the nodes that will use it
+    quint8 authenticationMethod;
+    packetStream >> authenticationMethod;
+    setAuthenticationMethod(authenticationMethod == HMACAuth::SIPHASH ? HMACAuth::SIPHASH : HMACAuth::MD5);
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
         parseNodeFromPacketStream(packetStream);
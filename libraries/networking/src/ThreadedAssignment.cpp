@@ -20,6 +20,7 @@
 #include <LogHandler.h>
 
 #include "NetworkLogging.h"
+#include "udt/PacketBufferPool.h"
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
@@ -104,6 +105,13 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_bytes_per_s"] = bytesOutPerSecond;
     ioStats["outbound_packets_per_s"] = packetsOutPerSecond;
 
+    // packet buffer allocations since the last stats packet
+    auto bufferStats = udt::PacketBufferPool::getStats();
+    udt::PacketBufferPool::resetStats();
+    ioStats["packet_buffer_pool_hits"] = (double)bufferStats.hits;
+    ioStats["packet_buffer_pool_misses"] = (double)bufferStats.misses;
+    ioStats["packet_buffer_pool_oversized"] = (double)bufferStats.oversized;
+
     statsObject["io_stats"] = ioStats;
 
     nodeList->sendStatsToDomainServer(statsObject);
@@ -0,0 +1,325 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2 / ln(2), the smallest gain that doubles the delivery rate every round trip
+static const double STARTUP_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / STARTUP_GAIN;
+static const double PROBE_BW_CONGESTION_WINDOW_GAIN = 2.0;
+
+static const int NUM_PROBE_BW_PHASES = 8;
+static const double PROBE_BW_GAINS[NUM_PROBE_BW_PHASES] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+static const int BANDWIDTH_FILTER_ROUNDS = 10;
+static const microseconds MIN_RTT_FILTER_WINDOW = seconds(10);
+static const microseconds PROBE_RTT_DURATION = milliseconds(200);
+
+// the pipe is full once the bandwidth grows by less than 25% for 3 round trips in a row
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int MIN_CONGESTION_WINDOW_PACKETS = 4;
+static const int INITIAL_CONGESTION_WINDOW_PACKETS = 10;
+
+BBRCC::BBRCC() :
+    _pacingGain(STARTUP_GAIN),
+    _congestionWindowGain(STARTUP_GAIN)
+{
+    _mss = udt::MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+    // packets go out as fast as the initial window allows, until there is a delivery rate to pace with
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_CONGESTION_WINDOW_PACKETS;
+
+    setAckInterval(1); // every packet produces a delivery rate sample
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    _lastACK = ack;
+
+    // ACKs are cumulative, everything up to and including ack was delivered
+    auto end = _sendRecords.upper_bound(ack);
+    int numAcked = (int)std::distance(_sendRecords.begin(), end);
+
+    if (numAcked == 0) {
+        return false;
+    }
+
+    // the most recently sent of the delivered packets gives the freshest samples
+    SendRecord newest = std::prev(end)->second;
+    _sendRecords.erase(_sendRecords.begin(), end);
+
+    _delivered += numAcked;
+    _deliveredTime = receiveTime;
+
+    // a round trip ends once a packet sent after the previous round trip ended is delivered
+    _isRoundStart = newest.delivered >= _nextRoundDelivered;
+    if (_isRoundStart) {
+        _nextRoundDelivered = _delivered;
+        ++_roundCount;
+    }
+
+    auto interval = duration_cast<microseconds>(receiveTime - newest.deliveredTime).count();
+    if (interval > 0) {
+        updateBottleneckBandwidth((_delivered - newest.delivered) * USECS_PER_SECOND / interval);
+    }
+
+    // we do not allow a zero microsecond RTT, same as TCPVegasCC
+    int rtt = std::max(1, (int)duration_cast<microseconds>(receiveTime - newest.sendTime).count());
+    updateMinRTT(rtt, receiveTime);
+
+    if (_isInRecovery && _roundCount > _recoveryRound) {
+        // a full round trip went by since the loss, the window can grow again
+        _isInRecovery = false;
+    }
+
+    checkFullPipe();
+    updateState(receiveTime);
+    updatePacketSendPeriod();
+    updateCongestionWindow(numAcked);
+
+    // re-send ack + 1 if it has been out for much longer than a round trip, it was most likely lost
+    auto next = _sendRecords.find(ack + 1);
+    if (next != _sendRecords.end() && _minRTT > 0) {
+        auto estimatedTimeout = 2 * std::max(_rtt, _minRTT);
+        auto sinceSend = duration_cast<microseconds>(receiveTime - next->second.sendTime).count();
+
+        if (sinceSend >= estimatedTimeout) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BBRCC::onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) {
+    // loss is not a congestion signal for the model, but we conserve packets for a round trip while the lost ones
+    // are re-sent, so that we do not add to a queue that might have caused it
+    if (!_isInRecovery) {
+        _isInRecovery = true;
+        _recoveryRound = _roundCount;
+
+        int numLost = seqlen(rangeStart, rangeEnd);
+        _congestionWindowSize = std::max(getPacketsInFlight() - numLost, MIN_CONGESTION_WINDOW_PACKETS);
+    }
+}
+
+void BBRCC::onTimeout() {
+    // nothing came back for a whole timeout - start over from the smallest window, it grows back towards the
+    // bandwidth-delay product by the number of packets ACKed
+    _isInRecovery = false;
+    _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sendRecords.find(seqNum) != _sendRecords.end()) {
+        // this is a re-send, rate samples are taken from the first send
+        return;
+    }
+
+    if (_sendRecords.empty()) {
+        // nothing in flight, the delivery rate of this packet must not count the time we were idle
+        _deliveredTime = timePoint;
+    }
+
+    _sendRecords[seqNum] = { timePoint, _delivered, _deliveredTime };
+}
+
+void BBRCC::updateBottleneckBandwidth(double deliveryRate) {
+    // keep the samples decreasing, so that the front is the max of the window
+    while (!_bandwidthSamples.empty() && _bandwidthSamples.back().second <= deliveryRate) {
+        _bandwidthSamples.pop_back();
+    }
+    _bandwidthSamples.emplace_back(_roundCount, deliveryRate);
+
+    while (_bandwidthSamples.front().first <= _roundCount - BANDWIDTH_FILTER_ROUNDS) {
+        _bandwidthSamples.pop_front();
+    }
+}
+
+void BBRCC::updateMinRTT(int rtt, p_high_resolution_clock::time_point now) {
+    _isMinRTTExpired = _minRTT != -1 && now > _minRTTTimestamp + MIN_RTT_FILTER_WINDOW;
+
+    if (_minRTT == -1 || rtt <= _minRTT || _isMinRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTimestamp = now;
+    }
+}
+
+void BBRCC::checkFullPipe() {
+    if (_isPipeFull || !_isRoundStart) {
+        return;
+    }
+
+    double bandwidth = getBottleneckBandwidth();
+    if (bandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+        // still growing, check again in a few round trips
+        _fullBandwidth = bandwidth;
+        _fullBandwidthRounds = 0;
+        return;
+    }
+
+    if (++_fullBandwidthRounds >= FULL_BANDWIDTH_ROUNDS) {
+        _isPipeFull = true;
+    }
+}
+
+void BBRCC::updateState(p_high_resolution_clock::time_point now) {
+    switch (_state) {
+        case State::Startup:
+            if (_isPipeFull) {
+                // drain the queue we built while looking for the bandwidth
+                _state = State::Drain;
+                _pacingGain = DRAIN_GAIN;
+                _congestionWindowGain = STARTUP_GAIN;
+            }
+            break;
+        case State::Drain:
+            if (getPacketsInFlight() <= getBandwidthDelayProduct(1.0)) {
+                enterProbeBW(now);
+            }
+            break;
+        case State::ProbeBW: {
+            double gain = PROBE_BW_GAINS[_cycleIndex];
+            bool shouldAdvance = now - _cycleTimestamp > microseconds(_minRTT);
+
+            if (gain > 1.0) {
+                // keep probing until the extra packets are actually out, unless that already caused loss
+                shouldAdvance = shouldAdvance && (_isInRecovery || getPacketsInFlight() >= getBandwidthDelayProduct(gain));
+            } else if (gain < 1.0) {
+                // stop draining as soon as the queue is gone
+                shouldAdvance = shouldAdvance || getPacketsInFlight() <= getBandwidthDelayProduct(1.0);
+            }
+
+            if (shouldAdvance) {
+                _cycleIndex = (_cycleIndex + 1) % NUM_PROBE_BW_PHASES;
+                _cycleTimestamp = now;
+                _pacingGain = PROBE_BW_GAINS[_cycleIndex];
+            }
+            break;
+        }
+        case State::ProbeRTT:
+            break;
+    }
+
+    if (_state != State::ProbeRTT && _isMinRTTExpired) {
+        _state = State::ProbeRTT;
+        _pacingGain = 1.0;
+        _congestionWindowGain = 1.0;
+        _probeRTTDoneTimestamp = p_high_resolution_clock::time_point();
+    }
+
+    if (_state == State::ProbeRTT) {
+        if (_probeRTTDoneTimestamp == p_high_resolution_clock::time_point()) {
+            // wait for the window to drain before we start the clock
+            if (getPacketsInFlight() <= MIN_CONGESTION_WINDOW_PACKETS) {
+                _probeRTTDoneTimestamp = now + PROBE_RTT_DURATION;
+                _probeRTTRound = _roundCount;
+                _isProbeRTTRoundDone = false;
+            }
+        } else {
+            if (_roundCount > _probeRTTRound) {
+                _isProbeRTTRoundDone = true;
+            }
+
+            if (_isProbeRTTRoundDone && now >= _probeRTTDoneTimestamp) {
+                _minRTTTimestamp = now;
+
+                if (_isPipeFull) {
+                    enterProbeBW(now);
+                } else {
+                    _state = State::Startup;
+                    _pacingGain = STARTUP_GAIN;
+                    _congestionWindowGain = STARTUP_GAIN;
+                }
+            }
+        }
+    }
+}
+
+void BBRCC::enterProbeBW(p_high_resolution_clock::time_point now) {
+    _state = State::ProbeBW;
+    _congestionWindowGain = PROBE_BW_CONGESTION_WINDOW_GAIN;
+
+    // start in a random cruise phase, so that connections that fill the pipe together do not probe together
+    _cycleIndex = 2 + rand() % (NUM_PROBE_BW_PHASES - 2);
+    _cycleTimestamp = now;
+    _pacingGain = PROBE_BW_GAINS[_cycleIndex];
+}
+
+void BBRCC::updatePacketSendPeriod() {
+    double bandwidth = getBottleneckBandwidth();
+    if (bandwidth <= 0.0) {
+        return;
+    }
+
+    double packetSendPeriod = USECS_PER_SECOND / (_pacingGain * bandwidth);
+
+    if (!_isPipeFull && _packetSendPeriod > 0.0 && packetSendPeriod > _packetSendPeriod) {
+        // never slow down while looking for the bandwidth, a low sample only means we have not found it yet
+        return;
+    }
+
+    setPacketSendPeriod(packetSendPeriod);
+}
+
+void BBRCC::updateCongestionWindow(int numAcked) {
+    if (_state == State::ProbeRTT) {
+        _congestionWindowSize = std::min(_congestionWindowSize, MIN_CONGESTION_WINDOW_PACKETS);
+        return;
+    }
+
+    int targetWindowSize = INITIAL_CONGESTION_WINDOW_PACKETS;
+    if (getBottleneckBandwidth() > 0.0 && _minRTT > 0) {
+        targetWindowSize = getBandwidthDelayProduct(_congestionWindowGain);
+    }
+
+    // grow towards the target by the number of packets ACKed, so that the window never jumps up at once
+    if (_isPipeFull) {
+        _congestionWindowSize = std::min(_congestionWindowSize + numAcked, targetWindowSize);
+    } else if (_congestionWindowSize < targetWindowSize || _delivered < INITIAL_CONGESTION_WINDOW_PACKETS) {
+        _congestionWindowSize += numAcked;
+    }
+
+    if (_isInRecovery) {
+        // packet conservation - only send as many packets as were just delivered
+        _congestionWindowSize = std::min(_congestionWindowSize, getPacketsInFlight() + numAcked);
+    }
+
+    if (_congestionWindowSize < MIN_CONGESTION_WINDOW_PACKETS) {
+        _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+    } else if (_congestionWindowSize > udt::MAX_PACKETS_IN_FLIGHT) {
+        _congestionWindowSize = udt::MAX_PACKETS_IN_FLIGHT;
+    }
+}
+
+double BBRCC::getBottleneckBandwidth() const {
+    return _bandwidthSamples.empty() ? 0.0 : _bandwidthSamples.front().second;
+}
+
+int BBRCC::getBandwidthDelayProduct(double gain) const {
+    if (_minRTT <= 0) {
+        return INITIAL_CONGESTION_WINDOW_PACKETS;
+    }
+
+    return (int)std::ceil(gain * getBottleneckBandwidth() * _minRTT / USECS_PER_SECOND);
+}
@@ -0,0 +1,116 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <deque>
+#include <map>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Congestion control that models the path instead of reacting to loss or delay (after BBR)
+//   Every ACK produces a delivery rate sample and an RTT sample. The bottleneck bandwidth is the max delivery rate
+//   over the last few round trips, and the propagation delay is the min RTT over the last few seconds.
+//   Packets are paced at a gain times the bottleneck bandwidth, and the congestion window is a gain times the
+//   bandwidth-delay product. The gains depend on the state:
+//     Startup  - doubles the rate every round trip until the bandwidth stops growing
+//     Drain    - drains the queue built during startup
+//     ProbeBW  - cruises at the bottleneck bandwidth, probing above it and draining below it once every 8 round trips
+//     ProbeRTT - shrinks the window for a moment to refresh a min RTT that has not been seen for a while
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) override;
+    virtual void onTimeout() override;
+
+    virtual bool shouldNAK() override { return false; }
+    virtual bool shouldACK2() override { return false; }
+    virtual bool shouldProbe() override { return false; }
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class State {
+        Startup,
+        Drain,
+        ProbeBW,
+        ProbeRTT
+    };
+
+    struct SendRecord {
+        p_high_resolution_clock::time_point sendTime;
+        int64_t delivered; // packets delivered when this packet was sent
+        p_high_resolution_clock::time_point deliveredTime; // time of the last delivery when this packet was sent
+    };
+
+    void updateBottleneckBandwidth(double deliveryRate);
+    void updateMinRTT(int rtt, p_high_resolution_clock::time_point now);
+    void checkFullPipe();
+    void updateState(p_high_resolution_clock::time_point now);
+    void enterProbeBW(p_high_resolution_clock::time_point now);
+    void updatePacketSendPeriod();
+    void updateCongestionWindow(int numAcked);
+
+    double getBottleneckBandwidth() const; // packets per second
+    int getBandwidthDelayProduct(double gain) const; // packets
+    int getPacketsInFlight() const { return (int)_sendRecords.size(); }
+
+    using SendRecordList = std::map<SequenceNumber, SendRecord>;
+    SendRecordList _sendRecords; // Map of sequence numbers of unacknowledged packets to their send records
+
+    State _state { State::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+
+    int64_t _delivered { 0 }; // Number of packets delivered so far
+    p_high_resolution_clock::time_point _deliveredTime; // Time of the last delivery
+
+    int64_t _roundCount { 0 }; // Number of round trips so far
+    int64_t _nextRoundDelivered { 0 }; // Delivered count that ends the current round trip
+    bool _isRoundStart { false }; // Whether the last ACK started a new round trip
+
+    std::deque<std::pair<int64_t, double>> _bandwidthSamples; // Max filter of (round, packets per second), decreasing
+
+    int _minRTT { -1 }; // Min RTT in the filter window, in microseconds
+    p_high_resolution_clock::time_point _minRTTTimestamp; // Time the min RTT was sampled
+    bool _isMinRTTExpired { false };
+
+    double _fullBandwidth { 0.0 }; // Bandwidth that the full pipe check last saw growing
+    int _fullBandwidthRounds { 0 }; // Round trips without significant growth
+    bool _isPipeFull { false };
+
+    int _cycleIndex { 0 }; // Index of the ProbeBW gain cycle phase
+    p_high_resolution_clock::time_point _cycleTimestamp; // Time the current phase started
+
+    p_high_resolution_clock::time_point _probeRTTDoneTimestamp; // Time ProbeRTT may end, zero until it is drained
+    bool _isProbeRTTRoundDone { false };
+    int64_t _probeRTTRound { 0 };
+
+    bool _isInRecovery { false }; // Whether we hold the window at what is in flight, after a loss
+    int64_t _recoveryRound { 0 }; // Round trip during which the recovery started
+};
+
+}
+
+#endif // hifi_BBRCC_h
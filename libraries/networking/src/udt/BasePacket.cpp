@@ -35,7 +35,7 @@ std::unique_ptr<BasePacket> BasePacket::create(qint64 size) {
     return packet;
 }
 
-std::unique_ptr<BasePacket> BasePacket::fromReceivedPacket(std::unique_ptr<char[]> data,
+std::unique_ptr<BasePacket> BasePacket::fromReceivedPacket(PacketBuffer data,
                                                            qint64 size, const HifiSockAddr& senderSockAddr) {
     // Fail with invalid size
     Q_ASSERT(size >= 0);
@@ -60,13 +60,14 @@ BasePacket::BasePacket(qint64 size) {
     Q_ASSERT(size >= 0 || size < maxPayload);
     
     _packetSize = size;
-    _packet.reset(new char[_packetSize]());
+    _packet = PacketBufferPool::allocate(_packetSize);
+    memset(_packet.get(), 0, _packetSize);
     _payloadCapacity = _packetSize;
     _payloadSize = 0;
     _payloadStart = _packet.get();
 }
 
-BasePacket::BasePacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) :
+BasePacket::BasePacket(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr) :
     _packetSize(size),
     _packet(std::move(data)),
     _payloadStart(_packet.get()),
@@ -85,7 +86,7 @@ BasePacket::BasePacket(const BasePacket& other) :
 
 BasePacket& BasePacket::operator=(const BasePacket& other) {
     _packetSize = other._packetSize;
-    _packet = std::unique_ptr<char[]>(new char[_packetSize]);
+    _packet = PacketBufferPool::allocate(_packetSize);
     memcpy(_packet.get(), other._packet.get(), _packetSize);
     
     _payloadStart = _packet.get() + (other._payloadStart - other._packet.get());
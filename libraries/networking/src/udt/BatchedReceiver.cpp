@@ -0,0 +1,252 @@
+//
+//  BatchedReceiver.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchedReceiver.h"
+
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#endif
+
+#include "../NetworkLogging.h"
+#include "Constants.h"
+
+using namespace udt;
+
+#ifdef Q_OS_LINUX
+
+// number of datagrams pulled by a single recvmmsg call
+static const int DATAGRAMS_PER_BATCH = 32;
+
+// udt never sends datagrams larger than this, so anything truncated to it is not ours and is dropped
+static const int DATAGRAM_BUFFER_SIZE = MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+bool BatchedReceiver::isSupported() {
+    return true;
+}
+
+int BatchedReceiver::createReusePortSocket(const QHostAddress& address, quint16 port) {
+    int socketDescriptor = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+    if (socketDescriptor < 0) {
+        qCWarning(networking) << "BatchedReceiver could not create socket -" << strerror(errno);
+        return -1;
+    }
+
+    int enable = 1;
+    if (setsockopt(socketDescriptor, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+        qCWarning(networking) << "BatchedReceiver could not set SO_REUSEPORT -" << strerror(errno);
+        ::close(socketDescriptor);
+        return -1;
+    }
+
+    // every reader socket gets the same receive buffer as the primary socket
+    int receiveBufferSize = UDP_RECEIVE_BUFFER_SIZE_BYTES;
+    setsockopt(socketDescriptor, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize));
+
+    sockaddr_in bindAddress;
+    memset(&bindAddress, 0, sizeof(bindAddress));
+    bindAddress.sin_family = AF_INET;
+    bindAddress.sin_port = htons(port);
+    bindAddress.sin_addr.s_addr = htonl(address.toIPv4Address());
+
+    if (::bind(socketDescriptor, reinterpret_cast<sockaddr*>(&bindAddress), sizeof(bindAddress)) < 0) {
+        qCWarning(networking) << "BatchedReceiver could not bind socket to port" << port << "-" << strerror(errno);
+        ::close(socketDescriptor);
+        return -1;
+    }
+
+    return socketDescriptor;
+}
+
+BatchedReceiver::BatchedReceiver(DatagramsReadyOperator datagramsReadyOperator) :
+    _datagramsReadyOperator(datagramsReadyOperator)
+{
+}
+
+BatchedReceiver::~BatchedReceiver() {
+    stop();
+}
+
+void BatchedReceiver::start(int socketDescriptor, const QHostAddress& address, quint16 port, int numExtraSockets) {
+    stop();
+
+    _wakeDescriptor = eventfd(0, EFD_NONBLOCK);
+    if (_wakeDescriptor < 0) {
+        qCWarning(networking) << "BatchedReceiver could not create wake descriptor -" << strerror(errno);
+        return;
+    }
+
+    _isStopping = false;
+
+    for (int i = 0; i < numExtraSockets; ++i) {
+        int extraSocket = createReusePortSocket(address, port);
+        if (extraSocket < 0) {
+            break;
+        }
+        _extraSockets.push_back(extraSocket);
+    }
+
+    _readers.emplace_back(&BatchedReceiver::readLoop, this, socketDescriptor);
+    for (int extraSocket : _extraSockets) {
+        _readers.emplace_back(&BatchedReceiver::readLoop, this, extraSocket);
+    }
+
+    qCDebug(networking) << "BatchedReceiver started" << _readers.size() << "reader threads on port" << port;
+}
+
+void BatchedReceiver::stop() {
+    if (_readers.empty()) {
+        return;
+    }
+
+    // wake the readers out of poll so that they see the stop flag
+    _isStopping = true;
+    uint64_t wake = 1;
+    if (::write(_wakeDescriptor, &wake, sizeof(wake)) < 0) {
+        qCWarning(networking) << "BatchedReceiver could not wake reader threads -" << strerror(errno);
+    }
+
+    for (auto& reader : _readers) {
+        reader.join();
+    }
+    _readers.clear();
+
+    for (int extraSocket : _extraSockets) {
+        ::close(extraSocket);
+    }
+    _extraSockets.clear();
+
+    ::close(_wakeDescriptor);
+    _wakeDescriptor = -1;
+
+    // drop anything that was never drained
+    Datagram* datagram;
+    while (_datagrams.try_pop(datagram)) {
+        delete datagram;
+    }
+}
+
+void BatchedReceiver::readLoop(int socketDescriptor) {
+    std::vector<char> buffers(DATAGRAMS_PER_BATCH * DATAGRAM_BUFFER_SIZE);
+    sockaddr_storage senderAddresses[DATAGRAMS_PER_BATCH];
+    iovec vectors[DATAGRAMS_PER_BATCH];
+    mmsghdr messages[DATAGRAMS_PER_BATCH];
+
+    pollfd descriptors[2];
+    descriptors[0] = { socketDescriptor, POLLIN, 0 };
+    descriptors[1] = { _wakeDescriptor, POLLIN, 0 };
+
+    while (!_isStopping) {
+        if (poll(descriptors, 2, -1) < 0) {
+            if (errno != EINTR) {
+                qCWarning(networking) << "BatchedReceiver poll failed -" << strerror(errno);
+                return;
+            }
+            continue;
+        }
+
+        if (_isStopping) {
+            break;
+        }
+
+        // drain the socket completely before going back to poll
+        while (true) {
+            for (int i = 0; i < DATAGRAMS_PER_BATCH; ++i) {
+                vectors[i].iov_base = &buffers[i * DATAGRAM_BUFFER_SIZE];
+                vectors[i].iov_len = DATAGRAM_BUFFER_SIZE;
+
+                memset(&messages[i].msg_hdr, 0, sizeof(msghdr));
+                messages[i].msg_hdr.msg_name = &senderAddresses[i];
+                messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+                messages[i].msg_hdr.msg_iov = &vectors[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int numReceived = recvmmsg(socketDescriptor, messages, DATAGRAMS_PER_BATCH, MSG_DONTWAIT, nullptr);
+            if (numReceived <= 0) {
+                if (numReceived < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    qCWarning(networking) << "BatchedReceiver recvmmsg failed -" << strerror(errno);
+                }
+                break;
+            }
+
+            // all the datagrams of a batch share one receive time
+            auto receiveTime = p_high_resolution_clock::now();
+
+            for (int i = 0; i < numReceived; ++i) {
+                int size = (int)messages[i].msg_len;
+                if (size <= 0 || (messages[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+                    continue;
+                }
+
+                auto datagram = new Datagram {
+                    PacketBufferPool::allocate(size), size,
+                    HifiSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i])), receiveTime
+                };
+                memcpy(datagram->data.get(), &buffers[i * DATAGRAM_BUFFER_SIZE], size);
+
+                _datagrams.push(datagram);
+            }
+
+            // only signal the owner once until it starts draining the queue
+            if (!_isReadySignalled.exchange(true)) {
+                _datagramsReadyOperator();
+            }
+
+            if (numReceived < DATAGRAMS_PER_BATCH) {
+                break;
+            }
+        }
+    }
+}
+
+#else
+
+bool BatchedReceiver::isSupported() {
+    return false;
+}
+
+int BatchedReceiver::createReusePortSocket(const QHostAddress& address, quint16 port) {
+    return -1;
+}
+
+BatchedReceiver::BatchedReceiver(DatagramsReadyOperator datagramsReadyOperator) :
+    _datagramsReadyOperator(datagramsReadyOperator)
+{
+}
+
+BatchedReceiver::~BatchedReceiver() {
+}
+
+void BatchedReceiver::start(int socketDescriptor, const QHostAddress& address, quint16 port, int numExtraSockets) {
+    qCWarning(networking) << "BatchedReceiver is not supported on this platform";
+}
+
+void BatchedReceiver::stop() {
+}
+
+#endif
+
+bool BatchedReceiver::popDatagram(std::unique_ptr<Datagram>& datagram) {
+    Datagram* next;
+    if (!_datagrams.try_pop(next)) {
+        return false;
+    }
+    datagram.reset(next);
+    return true;
+}
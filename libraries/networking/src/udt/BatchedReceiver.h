@@ -0,0 +1,86 @@
+//
+//  BatchedReceiver.h
+//  libraries/networking/src/udt
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BatchedReceiver_h
+#define hifi_BatchedReceiver_h
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <QtNetwork/QHostAddress>
+
+#include <PortableHighResolutionClock.h>
+#include <TBBHelpers.h>
+
+#include "../HifiSockAddr.h"
+#include "PacketBufferPool.h"
+
+namespace udt {
+
+// Receives datagrams in batches with recvmmsg, on dedicated reader threads (Linux only)
+//   Each reader thread drains one socket. Sockets beyond the first are bound to the same port with SO_REUSEPORT,
+//   so that the kernel spreads incoming flows across the readers.
+//   Received datagrams are pushed onto a lock-free queue, and the datagrams ready operator is called
+//   whenever the queue goes from empty to non-empty, so that the owner can drain it on its own thread.
+class BatchedReceiver {
+public:
+    struct Datagram {
+        PacketBuffer data;
+        int size;
+        HifiSockAddr senderSockAddr;
+        p_high_resolution_clock::time_point receiveTime;
+    };
+
+    using DatagramsReadyOperator = std::function<void()>;
+
+    // whether batched receive is available on this platform
+    static bool isSupported();
+
+    // create a UDP socket with SO_REUSEPORT set and bind it, returns -1 on failure
+    static int createReusePortSocket(const QHostAddress& address, quint16 port);
+
+    BatchedReceiver(DatagramsReadyOperator datagramsReadyOperator);
+    ~BatchedReceiver();
+
+    // start a reader on the given bound socket, plus one reader for each extra socket bound to the same port
+    // the given socket remains owned by the caller, the extra sockets are owned by the receiver
+    void start(int socketDescriptor, const QHostAddress& address, quint16 port, int numExtraSockets);
+    void stop();
+
+    // pop the next received datagram, returns false once the queue is empty
+    // the ready flag must be cleared before draining, so that datagrams pushed during the drain are signalled again
+    bool popDatagram(std::unique_ptr<Datagram>& datagram);
+    void clearReadyFlag() { _isReadySignalled = false; }
+
+    int getNumReaders() const { return (int)_readers.size(); }
+
+private:
+    void readLoop(int socketDescriptor);
+
+    DatagramsReadyOperator _datagramsReadyOperator;
+
+    std::vector<std::thread> _readers;
+    std::vector<int> _extraSockets;
+    int _wakeDescriptor { -1 };
+    std::atomic<bool> _isStopping { false };
+
+    tbb::concurrent_queue<Datagram*> _datagrams;
+    std::atomic<bool> _isReadySignalled { false };
+};
+
+} // namespace udt
+
+#endif // hifi_BatchedReceiver_h
@@ -13,7 +13,6 @@
 
 #include <random>
 
-#include <QtCore/QThread>
 
 #include <NumericalConstants.h>
 
@@ -83,21 +82,11 @@ Connection::~Connection() {
 }
 
 void Connection::stopSendQueue() {
-    if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
-        // tell the send queue to stop and be deleted
-        
+    if (auto sendQueue = std::move(_sendQueue)) {
+        // tell the send queue to stop, once it returns no send thread is using it and it can be deleted
         sendQueue->stop();
 
         _lastMessageNumber = sendQueue->getCurrentMessageNumber();
-
-        sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
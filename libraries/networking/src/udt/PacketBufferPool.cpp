@@ -0,0 +1,171 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace udt;
+
+static const int MIN_BUFFER_SIZE_BITS = 6; // 64 bytes
+static const int MAX_BUFFER_SIZE_BITS = 11; // 2048 bytes
+static const int NUM_SIZE_CLASSES = MAX_BUFFER_SIZE_BITS - MIN_BUFFER_SIZE_BITS + 1;
+
+static_assert((1 << MAX_BUFFER_SIZE_BITS) == PacketBufferPool::MAX_BUFFER_SIZE, "size classes must cover the pool");
+
+// buffers kept by each thread, per size class, before spilling half of them to the shared list
+static const size_t MAX_THREAD_CACHED_BUFFERS = 256;
+
+// buffers kept in the shared list, per size class - any more are deleted
+static const size_t MAX_SHARED_BUFFERS = 4096;
+
+// buffers moved at once from the shared list to an empty thread cache
+static const size_t SHARED_REFILL_BUFFERS = 32;
+
+static int sizeOfClass(int sizeClass) {
+    return 1 << (sizeClass + MIN_BUFFER_SIZE_BITS);
+}
+
+static int classForSize(size_t size) {
+    int sizeClass = 0;
+    while ((size_t)sizeOfClass(sizeClass) < size) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+namespace {
+
+struct SharedBuffers {
+    std::mutex mutex;
+    std::array<std::vector<char*>, NUM_SIZE_CLASSES> buffers; // guarded by mutex
+
+    std::atomic<uint64_t> hits { 0 };
+    std::atomic<uint64_t> misses { 0 };
+    std::atomic<uint64_t> oversized { 0 };
+};
+
+// never destroyed, so that packets released during shutdown still have somewhere to go
+SharedBuffers& sharedBuffers() {
+    static SharedBuffers* shared = new SharedBuffers();
+    return *shared;
+}
+
+// set once the cache of this thread is gone, buffers released after that (from other thread_local destructors) are deleted
+thread_local bool isThreadCacheDestroyed { false };
+
+struct ThreadCache {
+    std::array<std::vector<char*>, NUM_SIZE_CLASSES> buffers;
+
+    ~ThreadCache() {
+        isThreadCacheDestroyed = true;
+
+        // hand what is left to the other threads
+        auto& shared = sharedBuffers();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for (int sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass) {
+            for (char* buffer : buffers[sizeClass]) {
+                if (shared.buffers[sizeClass].size() < MAX_SHARED_BUFFERS) {
+                    shared.buffers[sizeClass].push_back(buffer);
+                } else {
+                    delete[] buffer;
+                }
+            }
+        }
+    }
+};
+
+thread_local ThreadCache threadCache;
+
+}
+
+PacketBufferPool::Buffer PacketBufferPool::allocate(size_t size) {
+    auto& shared = sharedBuffers();
+
+    if (size > (size_t)MAX_BUFFER_SIZE) {
+        shared.oversized.fetch_add(1, std::memory_order_relaxed);
+        return Buffer(new char[size]);
+    }
+
+    int sizeClass = classForSize(size);
+    if (isThreadCacheDestroyed) {
+        return Buffer(new char[size]);
+    }
+
+    auto& cached = threadCache.buffers[sizeClass];
+
+    if (cached.empty()) {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        auto& sharedCached = shared.buffers[sizeClass];
+        size_t numRefill = std::min(sharedCached.size(), SHARED_REFILL_BUFFERS);
+        cached.insert(cached.end(), sharedCached.end() - numRefill, sharedCached.end());
+        sharedCached.resize(sharedCached.size() - numRefill);
+    }
+
+    if (cached.empty()) {
+        shared.misses.fetch_add(1, std::memory_order_relaxed);
+        return Buffer(new char[sizeOfClass(sizeClass)], Deleter(sizeClass));
+    }
+
+    shared.hits.fetch_add(1, std::memory_order_relaxed);
+    char* buffer = cached.back();
+    cached.pop_back();
+    return Buffer(buffer, Deleter(sizeClass));
+}
+
+void PacketBufferPool::Deleter::operator()(char* buffer) const {
+    if (sizeClass < 0 || isThreadCacheDestroyed) {
+        delete[] buffer;
+        return;
+    }
+
+    auto& cached = threadCache.buffers[sizeClass];
+    if (cached.size() >= MAX_THREAD_CACHED_BUFFERS) {
+        // this thread releases more than it allocates (e.g. it consumes received packets), share the surplus
+        auto& shared = sharedBuffers();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        auto& sharedCached = shared.buffers[sizeClass];
+
+        size_t numSpilled = cached.size() / 2;
+        for (size_t i = cached.size() - numSpilled; i < cached.size(); ++i) {
+            if (sharedCached.size() < MAX_SHARED_BUFFERS) {
+                sharedCached.push_back(cached[i]);
+            } else {
+                delete[] cached[i];
+            }
+        }
+        cached.resize(cached.size() - numSpilled);
+    }
+
+    cached.push_back(buffer);
+}
+
+PacketBufferPool::Stats PacketBufferPool::getStats() {
+    auto& shared = sharedBuffers();
+
+    Stats stats;
+    stats.hits = shared.hits.load(std::memory_order_relaxed);
+    stats.misses = shared.misses.load(std::memory_order_relaxed);
+    stats.oversized = shared.oversized.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void PacketBufferPool::resetStats() {
+    auto& shared = sharedBuffers();
+
+    shared.hits = 0;
+    shared.misses = 0;
+    shared.oversized = 0;
+}
@@ -0,0 +1,60 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <cstdint>
+#include <memory>
+
+namespace udt {
+
+// Size-class pool for packet buffers, with a cache per thread
+//   Buffers up to MAX_BUFFER_SIZE are rounded up to a power of two size class. A released buffer goes to the cache of
+//   the releasing thread. A full cache spills half of its buffers to a shared list, and an empty cache refills from it,
+//   so buffers allocated on the socket thread and released on another thread still get reused.
+//   Larger buffers are allocated and deleted as usual.
+class PacketBufferPool {
+public:
+    static const int MAX_BUFFER_SIZE = 2048;
+
+    struct Deleter {
+        Deleter() = default;
+        Deleter(const std::default_delete<char[]>&) {} // buffers not from the pool are deleted as usual
+        explicit Deleter(int sizeClass) : sizeClass(sizeClass) {}
+
+        void operator()(char* buffer) const;
+
+        int sizeClass { -1 }; // -1 for buffers that are not from the pool
+    };
+
+    using Buffer = std::unique_ptr<char[], Deleter>;
+
+    struct Stats {
+        uint64_t hits { 0 }; // allocations served by a cached buffer
+        uint64_t misses { 0 }; // allocations of a new pooled buffer
+        uint64_t oversized { 0 }; // allocations too large for the pool
+    };
+
+    // allocate an uninitialized buffer of at least size bytes
+    static Buffer allocate(size_t size);
+
+    static Stats getStats();
+    static void resetStats();
+};
+
+using PacketBuffer = PacketBufferPool::Buffer;
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
@@ -232,7 +232,8 @@ enum class EntityVersion : PacketVersion {
     SoftEntities,
     MaterialEntities,
     ShadowControl,
-    MaterialData
+    MaterialData,
+    TransformDeltas
 };
 
 enum class EntityScriptCallMethodVersion : PacketVersion {
@@ -305,7 +306,8 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    AuthenticationMethod
 };
 
 enum class AudioVersion : PacketVersion {
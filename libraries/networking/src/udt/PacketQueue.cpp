@@ -15,24 +15,97 @@
 
 using namespace udt;
 
-PacketQueue::PacketQueue(MessageNumber messageNumber) : _currentMessageNumber(messageNumber) {
+PacketQueue::PacketQueue(MessageNumber messageNumber) :
+    _currentMessageNumber(messageNumber),
+    _head(&_stub),
+    _tail(&_stub)
+{
     _channels.emplace_back(new std::list<PacketPointer>());
 }
 
+PacketQueue::~PacketQueue() {
+    // release the packets that were never taken
+    drainEntries();
+}
+
 MessageNumber PacketQueue::getNextMessageNumber() {
     static const MessageNumber MAX_MESSAGE_NUMBER = MessageNumber(1) << MESSAGE_NUMBER_SIZE;
-    _currentMessageNumber = (_currentMessageNumber + 1) % MAX_MESSAGE_NUMBER;
-    return _currentMessageNumber;
+
+    MessageNumber currentMessageNumber = _currentMessageNumber;
+    MessageNumber nextMessageNumber;
+    do {
+        nextMessageNumber = (currentMessageNumber + 1) % MAX_MESSAGE_NUMBER;
+    } while (!_currentMessageNumber.compare_exchange_weak(currentMessageNumber, nextMessageNumber));
+
+    return nextMessageNumber;
+}
+
+void PacketQueue::push(Entry* entry) {
+    entry->next.store(nullptr, std::memory_order_relaxed);
+    Entry* previous = _head.exchange(entry, std::memory_order_acq_rel);
+
+    // until this store, the consumer cannot see the entry (or any entry pushed after it)
+    // it is sequentially consistent so that the send thread cannot miss it while deciding to sleep
+    previous->next.store(entry);
+}
+
+PacketQueue::Entry* PacketQueue::pop() {
+    Entry* tail = _tail;
+    Entry* next = tail->next.load();
+
+    if (tail == &_stub) {
+        if (!next) {
+            return nullptr;
+        }
+
+        _tail = next;
+        tail = next;
+        next = next->next.load();
+    }
+
+    if (next) {
+        _tail = next;
+        return tail;
+    }
+
+    if (tail != _head.load(std::memory_order_acquire)) {
+        // a producer is between swapping the head and linking its entry
+        return nullptr;
+    }
+
+    // tail is the last entry - put the stub back behind it, so that it can be taken
+    push(&_stub);
+
+    next = tail->next.load();
+    if (next) {
+        _tail = next;
+        return tail;
+    }
+
+    return nullptr;
 }
 
-bool PacketQueue::isEmpty() const {
-    LockGuard locker(_packetsLock);
+void PacketQueue::drainEntries() {
+    while (Entry* entry = pop()) {
+        if (entry->isPacketList) {
+            _channels.emplace_back(new std::list<PacketPointer>());
+            _channels.back()->swap(entry->packets);
+        } else {
+            _channels.front()->push_back(std::move(entry->packet));
+        }
+
+        delete entry;
+    }
+}
+
+bool PacketQueue::isEmpty() {
+    drainEntries();
+
     // Only the main channel and it is empty
     return (_channels.size() == 1) && _channels.front()->empty();
 }
 
 PacketQueue::PacketPointer PacketQueue::takePacket() {
-    LockGuard locker(_packetsLock);
     if (isEmpty()) {
         return PacketPointer();
     }
@@ -64,8 +137,9 @@ unsigned int PacketQueue::nextIndex() {
 }
 
 void PacketQueue::queuePacket(PacketPointer packet) {
-    LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    auto entry = new Entry();
+    entry->packet = std::move(packet);
+    push(entry);
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -73,7 +147,8 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
         packetList->preparePackets(getNextMessageNumber());
     }
 
-    LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    auto entry = new Entry();
+    entry->isPacketList = true;
+    entry->packets.swap(packetList->_packets);
+    push(entry);
 }
@@ -12,10 +12,10 @@
 #ifndef hifi_PacketQueue_h
 #define hifi_PacketQueue_h
 
+#include <atomic>
 #include <list>
 #include <vector>
 #include <memory>
-#include <mutex>
 
 #include "Packet.h"
 
@@ -25,9 +25,12 @@ class PacketList;
     
 using MessageNumber = uint32_t;
     
+// Queue of packets waiting to be sent by a SendQueue, fed by any number of producer threads without locking
+//   Producers push entries (a packet, or all the packets of a packet list) onto an intrusive MPSC queue.
+//   The consumer (the send thread) drains that queue into its channels before looking at them, and takes
+//   packets round-robin from the channels: one channel per packet list + the main channel.
+//   isEmpty and takePacket must only be called from the consumer thread.
 class PacketQueue {
-    using Mutex = std::recursive_mutex;
-    using LockGuard = std::lock_guard<Mutex>;
     using PacketPointer = std::unique_ptr<Packet>;
     using PacketListPointer = std::unique_ptr<PacketList>;
     using Channel = std::unique_ptr<std::list<PacketPointer>>;
@@ -35,24 +38,39 @@ class PacketQueue {
     
 public:
     PacketQueue(MessageNumber messageNumber = 0);
+    ~PacketQueue();
+
     void queuePacket(PacketPointer packet);
     void queuePacketList(PacketListPointer packetList);
     
-    bool isEmpty() const;
+    bool isEmpty();
     PacketPointer takePacket();
-    
-    Mutex& getLock() { return _packetsLock; }
 
     MessageNumber getCurrentMessageNumber() const { return _currentMessageNumber; }
     
 private:
+    struct Entry {
+        std::atomic<Entry*> next { nullptr };
+        PacketPointer packet; // for the main channel
+        std::list<PacketPointer> packets; // for a new channel, when the entry is a packet list
+        bool isPacketList { false };
+    };
+
     MessageNumber getNextMessageNumber();
     unsigned int nextIndex();
+
+    void push(Entry* entry);
+    Entry* pop(); // returns nullptr if empty, or if the producer of the next entry is still pushing it
+    void drainEntries();
     
-    MessageNumber _currentMessageNumber { 0 };
+    std::atomic<MessageNumber> _currentMessageNumber { 0 };
     
-    mutable Mutex _packetsLock; // Protects the packets to be sent.
-    Channels _channels; // One channel per packet list + Main channel
+    // entries go in at the head and come out at the tail, the stub keeps the queue from ever being empty
+    std::atomic<Entry*> _head;
+    Entry* _tail;
+    Entry _stub;
+
+    Channels _channels; // One channel per packet list + Main channel, consumer only
     unsigned int _currentIndex { 0 };
 };
 
@@ -12,12 +12,9 @@
 #include "SendQueue.h"
 
 #include <algorithm>
-#include <thread>
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -37,29 +34,8 @@
 using namespace udt;
 using namespace std::chrono;
 
-template <typename Mutex1, typename Mutex2>
-class DoubleLock {
-public:
-    using Lock = std::unique_lock<DoubleLock<Mutex1, Mutex2>>;
-    
-    DoubleLock(Mutex1& mutex1, Mutex2& mutex2) : _mutex1(mutex1), _mutex2(mutex2) { }
-    
-    DoubleLock(const DoubleLock&) = delete;
-    DoubleLock& operator=(const DoubleLock&) = delete;
-    
-    // Either locks all the mutexes or none of them
-    bool try_lock() { return (std::try_lock(_mutex1, _mutex2) == -1); }
-    
-    // Locks all the mutexes
-    void lock() { std::lock(_mutex1, _mutex2); }
-    
-     // Undefined behavior if not locked
-    void unlock() { _mutex1.unlock(); _mutex2.unlock(); }
-    
-private:
-    Mutex1& _mutex1;
-    Mutex2& _mutex2;
-};
+static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
 
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination, SequenceNumber currentSequenceNumber,
                                              MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) {
@@ -68,20 +44,9 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
-    // Setup queue private thread
-    QThread* thread = new QThread;
-    thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
-    
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-    
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-    
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-    
-    thread->start();
-    
+    // hand the queue to the shared send threads, its first service starts the handshake
+    queue->_scheduler->add(queue->_schedulerTask);
+
     return queue;
 }
     
@@ -97,40 +62,39 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSe
     _lastACKSequenceNumber = uint32_t(_currentSequenceNumber);
 
     _hasReceivedHandshakeACK = hasReceivedHandshakeACK;
+
+    _schedulerTask.service = [this](bool& isWaiting) { return service(isWaiting); };
 }
 
 SendQueue::~SendQueue() {
+    _scheduler->remove(_schedulerTask);
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    notifyActivity();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
+    notifyActivity();
+}
+
+void SendQueue::notifyActivity() {
+    // the packet queue takes no lock, so producers only touch the scheduler when the queue may be waiting
+    // the scheduler sets the flag before its last look at the queue, so either it sees our packet or we see the flag
+    if (_isWaitingForPackets) {
+        _scheduler->wake(_schedulerTask);
     }
 }
 
 void SendQueue::stop() {
-    
     _state = State::Stopped;
-    
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+
+    // once this returns, no send thread is looking at this queue
+    _scheduler->remove(_schedulerTask);
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -160,8 +124,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is waiting with a full congestion window
+    notifyActivity();
 }
 
 void SendQueue::nak(SequenceNumber start, SequenceNumber end) {    
@@ -170,8 +134,8 @@ void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
         _naks.insert(start, end);
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -180,8 +144,8 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
@@ -202,35 +166,25 @@ void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
         }
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
-    }
+    // we haven't received a handshake ACK from the client, send another now
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
 }
 
 void SendQueue::handshakeACK() {
-    {
-        std::lock_guard<std::mutex> locker { _handshakeMutex };
-        _hasReceivedHandshakeACK = true;
-    }
+    _hasReceivedHandshakeACK = true;
 
-    // Notify on the handshake ACK condition
-    _handshakeACKCondition.notify_one();
+    // the queue waits on the handshake ACK, wake it up whatever it is doing
+    _scheduler->wake(_schedulerTask);
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -276,113 +230,111 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
-    if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
-    }
-    
-    _state = State::Running;
-    
-    // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
+p_high_resolution_clock::time_point SendQueue::service(bool& isWaiting) {
+    auto now = p_high_resolution_clock::now();
 
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+    if (_state == State::Stopped) {
+        // we've been asked to stop, possibly before we even got a chance to start
+        return p_high_resolution_clock::time_point::max();
+    } else if (_state == State::NotStarted) {
+        _state = State::Running;
+        _nextPacketTimestamp = now;
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    // we're looking at the queues again, no need to be woken up
+    _isWaitingForPackets = false;
 
-    while (_state == State::Running) {
-        bool attemptedToSendPacket = maybeResendPacket();
-        
-        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
-        // (this is according to the current flow window size) then we send out a new packet
-        auto newPacketCount = 0;
-        if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
-            attemptedToSendPacket = (newPacketCount > 0);
+    if (!_hasReceivedHandshakeACK) {
+        // we wait for the ACK or the re-send interval to expire, no packets will be sent until we have the ACK
+        if (now >= _nextHandshakeTimestamp) {
+            sendHandshake();
+            _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
         }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+
+        isWaiting = true;
+        return _nextHandshakeTimestamp;
+    }
+
+    if (_waitReason != WaitReason::None) {
+        if (handleWaitTimeout(now)) {
+            return p_high_resolution_clock::time_point::max();
         }
 
-        if (_packetSendPeriod > 0) {
-            // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+        // don't burst out packets to catch up on the time spent waiting
+        _nextPacketTimestamp = now;
+    }
+
+    bool attemptedToSendPacket = maybeResendPacket();
+
+    // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+    // (this is according to the current flow window size) then we send out a new packet
+    auto newPacketCount = 0;
+    if (!attemptedToSendPacket) {
+        newPacketCount = maybeSendNewPacket();
+        attemptedToSendPacket = (newPacketCount > 0);
+    }
 
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
+    if (!attemptedToSendPacket && shouldWait(now)) {
+        isWaiting = true;
+        return _waitDeadline;
+    }
 
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
+    return nextPacketTime(now, newPacketCount);
+}
 
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+p_high_resolution_clock::time_point SendQueue::nextPacketTime(p_high_resolution_clock::time_point now,
+                                                               int newPacketCount) {
+    if (_packetSendPeriod <= 0) {
+        return now;
+    }
 
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
-            }
+    // push the next packet timestamp forwards by the current packet send period
+    auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
+    _nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-                // alright, we're in a weird state
-                // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-                static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-                // setup a json object with the details we want
-                QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-                longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-                longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-                // hopefully send this event using the user activity logger
-                UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
-            }
-            
-            std::this_thread::sleep_for(timeToSleep);
-        }
+    auto timeToSleep = duration_cast<microseconds>(_nextPacketTimestamp - now);
+
+    // we use nextPacketTimestamp so that we don't fall behind, not to force long waits
+    // we'll never allow nextPacketTimestamp to force us to wait for more than nextPacketDelta
+    // so cap it to that value
+    if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
+        // reset the nextPacketTimestamp so that it is correct next time we come around
+        _nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+
+        timeToSleep = std::chrono::microseconds(nextPacketDelta);
     }
+
+    // we're seeing SendQueues wait for a long period of time here,
+    // for now we guard this by capping the time a queue can wait for its next packet
+
+    const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
+    if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
+        qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
+        qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
+        qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
+        << "NPT:" << _nextPacketTimestamp.time_since_epoch().count()
+        << "NOW:" << now.time_since_epoch().count();
+
+        // alright, we're in a weird state
+        // we want to know why this is happening so we can implement a better fix than this guard
+        // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
+        static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
+
+        // setup a json object with the details we want
+        QJsonObject longSleepObject;
+        longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
+        longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
+        longSleepObject["nextPacketDelta"] = nextPacketDelta;
+        longSleepObject["nextPacketTimestamp"] = qint64(_nextPacketTimestamp.time_since_epoch().count());
+        longSleepObject["then"] = qint64(now.time_since_epoch().count());
+
+        // hopefully send this event using the user activity logger
+        UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
+
+        timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+    }
+
+    return now + timeToSleep;
 }
 
 void SendQueue::setProbePacketEnabled(bool enabled) {
@@ -520,76 +472,78 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
+bool SendQueue::shouldWait(p_high_resolution_clock::time_point now) {
+    // flag that we may wait before checking the packets one last time, see notifyActivity
+    _isWaitingForPackets = true;
+
+    std::lock_guard<std::mutex> naksLocker(_naksLock);
+
+    if ((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+        // The packets queue and loss list are both empty, wait for something to happen
+
+        if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+            // we've sent the client as much data as we have (and they've ACKed it)
+            // either wait for new data to send or 5 seconds before cleaning up the queue
+            _waitReason = WaitReason::Inactive;
+            _waitDeadline = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        } else {
+            // We think the client is still waiting for data (based on the sequence number gap)
+            // Let's wait either for a response from the client or until the estimated timeout
+            // (plus the sync interval to allow the client to respond) has elapsed
+            _waitReason = WaitReason::ACKTimeout;
+            _waitDeadline = now + std::chrono::microseconds(_estimatedTimeout + _syncInterval);
+        }
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+        return true;
+    }
+
+    _isWaitingForPackets = false;
+    return false;
+}
+
+bool SendQueue::handleWaitTimeout(p_high_resolution_clock::time_point now) {
+    auto waitReason = _waitReason;
+    _waitReason = WaitReason::None;
+
+    if (now < _waitDeadline) {
+        // something woke us up before the timeout
+        return false;
+    }
+
+    std::unique_lock<std::mutex> naksLocker(_naksLock);
+
+    if (!((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty())) {
+        return false;
+    }
+
+    if (waitReason == WaitReason::Inactive) {
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+        qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+            << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+            << "seconds and receiver has ACKed all packets."
+            << "The queue is now inactive and will be stopped.";
 #endif
 
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
+        naksLocker.unlock();
 
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-                auto waitDuration = std::chrono::microseconds(_estimatedTimeout + _syncInterval);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, waitDuration);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
-        }
+        // Deactivate queue
+        deactivate();
+        return true;
+    } else if (SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+
+        naksLocker.unlock();
+
+        emit timeout();
     }
-    
+
     return false;
 }
 
 void SendQueue::deactivate() {
-    // this queue is inactive - emit that signal and stop the while
+    // this queue is inactive - emit that signal and stop being serviced
     emit queueInactive();
     
     _state = State::Stopped;
@@ -13,7 +13,6 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -29,6 +28,7 @@
 
 #include "Constants.h"
 #include "PacketQueue.h"
+#include "SendScheduler.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
 
@@ -39,7 +39,11 @@ class ControlPacket;
 class Packet;
 class PacketList;
 class Socket;
-    
+
+// Reliable send queue of a Connection
+//   Queues don't have threads of their own, the SendScheduler services them from its send threads.
+//   Each service sends at most one packet (or probe pair), or re-sends one lost packet, and tells the scheduler
+//   when the packet send period allows the next one. Queues with nothing to send wait for packets, ACKs or NAKs.
 class SendQueue : public QObject {
     Q_OBJECT
     
@@ -90,15 +94,23 @@ signals:
     void shortCircuitLoss(quint32 sequenceNumber);
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    enum class WaitReason {
+        None,
+        Inactive, // everything sent was ACKed, the queue goes inactive if nothing comes
+        ACKTimeout // waiting on the receiver, what it didn't ACK is lost if nothing comes
+    };
+
+
     SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
     
+    // called by the scheduler, returns when this queue should be serviced next (max once stopped)
+    // sets isWaiting if the queue waits for packets, ACKs or NAKs - which wake it up - rather than for its send period
+    p_high_resolution_clock::time_point service(bool& isWaiting);
+
     void sendHandshake();
     
     int sendPacket(const Packet& packet);
@@ -107,7 +119,10 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    bool shouldWait(p_high_resolution_clock::time_point now); // starts a wait if there is nothing to send
+    bool handleWaitTimeout(p_high_resolution_clock::time_point now); // returns true if the queue became inactive
+    p_high_resolution_clock::time_point nextPacketTime(p_high_resolution_clock::time_point now, int newPacketCount);
+    void notifyActivity(); // wakes the queue up if it is waiting
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -140,12 +155,17 @@ private:
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
     std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
+    p_high_resolution_clock::time_point _nextHandshakeTimestamp; // When to re-send the handshake
+
+    std::atomic<bool> _isWaitingForPackets { false }; // Set by the scheduler before its last look at the packets
+    WaitReason _waitReason { WaitReason::None };
+    p_high_resolution_clock::time_point _waitDeadline;
+
+    p_high_resolution_clock::time_point _nextPacketTimestamp; // When the next packet should go out
 
+    std::shared_ptr<SendScheduler> _scheduler { SendScheduler::getInstance() };
+    SendScheduler::Task _schedulerTask;
 
     std::atomic<bool> _shouldSendProbes { true };
 };
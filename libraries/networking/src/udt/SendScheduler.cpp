@@ -0,0 +1,250 @@
+//
+//  SendScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QtGlobal>
+
+#include <ThreadHelpers.h>
+
+#include "../NetworkLogging.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+// granularity of the timer wheel - a queue is never serviced before its time, but may be up to a tick late
+static const int64_t TICK_USECS = 100;
+
+// the wheel covers NUM_SLOTS ticks, queues further out go around it
+static const uint64_t NUM_SLOTS = 4096;
+
+static const int DEFAULT_SEND_THREADS = 2;
+static const int MAX_SEND_THREADS = 16;
+
+static uint64_t tickForTime(SendScheduler::time_point time) {
+    return (uint64_t)(duration_cast<microseconds>(time.time_since_epoch()).count() / TICK_USECS);
+}
+
+static int numSendThreads() {
+    const char* HIFI_SEND_THREADS_ENV = "HIFI_UDT_SEND_THREADS";
+    if (qEnvironmentVariableIsSet(HIFI_SEND_THREADS_ENV)) {
+        return std::max(1, std::min(qEnvironmentVariableIntValue(HIFI_SEND_THREADS_ENV), MAX_SEND_THREADS));
+    }
+    return DEFAULT_SEND_THREADS;
+}
+
+std::shared_ptr<SendScheduler> SendScheduler::getInstance() {
+    static std::shared_ptr<SendScheduler> scheduler(new SendScheduler(numSendThreads()));
+    return scheduler;
+}
+
+SendScheduler::SendScheduler(int numThreads) :
+    _slots(NUM_SLOTS),
+    _currentTick(tickForTime(p_high_resolution_clock::now())),
+    _sleepUntil(time_point::max())
+{
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this, i] {
+            setThreadName("Hifi_Networking: SendScheduler " + std::to_string(i));
+            run();
+        });
+    }
+
+    qCDebug(networking) << "SendScheduler started" << numThreads << "send threads";
+}
+
+SendScheduler::~SendScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _condition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void SendScheduler::add(Task& task) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    task.isRemoved = false;
+
+    auto now = p_high_resolution_clock::now();
+    schedule(task, now, false, now);
+}
+
+void SendScheduler::wake(Task& task) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (task.state == Task::State::Busy) {
+        // the send thread reschedules it right away if it decides to wait
+        task.isWakePending = true;
+    } else if (task.state == Task::State::Scheduled && task.isWaiting) {
+        unschedule(task);
+
+        auto now = p_high_resolution_clock::now();
+        schedule(task, now, false, now);
+    }
+}
+
+void SendScheduler::remove(Task& task) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    task.isRemoved = true;
+
+    if (task.state == Task::State::Scheduled || task.state == Task::State::Ready) {
+        unschedule(task);
+    }
+
+    _idleCondition.wait(lock, [&] { return task.state != Task::State::Busy; });
+    task.state = Task::State::Idle;
+}
+
+void SendScheduler::schedule(Task& task, time_point serviceTime, bool isWaiting, time_point now) {
+    task.serviceTime = serviceTime;
+    task.isWaiting = isWaiting;
+
+    if (serviceTime <= now) {
+        task.state = Task::State::Ready;
+        _ready.push_back(&task);
+        _condition.notify_one();
+        return;
+    }
+
+    task.state = Task::State::Scheduled;
+    _slots[tickForTime(serviceTime) % NUM_SLOTS].push_back(&task);
+    ++_numScheduled;
+
+    if (serviceTime < _sleepUntil) {
+        // the sleeping send threads would wake up too late for this one
+        _sleepUntil = serviceTime;
+        _condition.notify_one();
+    }
+}
+
+void SendScheduler::unschedule(Task& task) {
+    if (task.state == Task::State::Scheduled) {
+        auto& slot = _slots[tickForTime(task.serviceTime) % NUM_SLOTS];
+        auto it = std::find(slot.begin(), slot.end(), &task);
+        if (it != slot.end()) {
+            *it = slot.back();
+            slot.pop_back();
+            --_numScheduled;
+        }
+    } else if (task.state == Task::State::Ready) {
+        auto it = std::find(_ready.begin(), _ready.end(), &task);
+        if (it != _ready.end()) {
+            _ready.erase(it);
+        }
+    }
+
+    task.state = Task::State::Idle;
+}
+
+void SendScheduler::advance(time_point now) {
+    uint64_t nowTick = tickForTime(now);
+
+    if (_numScheduled > 0) {
+        // look at every slot once at most, queues that are further out stay where they are
+        uint64_t firstTick = _currentTick;
+        if (nowTick - firstTick >= NUM_SLOTS) {
+            firstTick = nowTick - NUM_SLOTS + 1;
+        }
+
+        for (uint64_t tick = firstTick; tick <= nowTick; ++tick) {
+            auto& slot = _slots[tick % NUM_SLOTS];
+            for (size_t i = 0; i < slot.size();) {
+                Task* task = slot[i];
+                if (task->serviceTime <= now) {
+                    slot[i] = slot.back();
+                    slot.pop_back();
+                    --_numScheduled;
+
+                    task->state = Task::State::Ready;
+                    _ready.push_back(task);
+                } else {
+                    ++i;
+                }
+            }
+        }
+    }
+
+    _currentTick = nowTick;
+}
+
+SendScheduler::time_point SendScheduler::nextServiceTime() const {
+    time_point earliest = time_point::max();
+    if (_numScheduled == 0) {
+        return earliest;
+    }
+
+    // walk the wheel from the current tick until the earliest time found so far is behind us
+    for (uint64_t tick = _currentTick; tick < _currentTick + NUM_SLOTS; ++tick) {
+        for (Task* task : _slots[tick % NUM_SLOTS]) {
+            earliest = std::min(earliest, task->serviceTime);
+        }
+        if (earliest != time_point::max() && tickForTime(earliest) <= tick) {
+            break;
+        }
+    }
+
+    return earliest;
+}
+
+void SendScheduler::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_isStopping) {
+        advance(p_high_resolution_clock::now());
+
+        if (_ready.empty()) {
+            auto serviceTime = nextServiceTime();
+            _sleepUntil = std::min(_sleepUntil, serviceTime);
+
+            if (serviceTime == time_point::max()) {
+                _condition.wait(lock);
+            } else {
+                _condition.wait_until(lock, serviceTime);
+            }
+
+            // other send threads may still be sleeping, so the next queue scheduled wakes one of them up
+            _sleepUntil = time_point::max();
+            continue;
+        }
+
+        Task* task = _ready.front();
+        _ready.pop_front();
+        task->state = Task::State::Busy;
+        task->isWakePending = false;
+
+        lock.unlock();
+
+        bool isWaiting = false;
+        auto serviceTime = task->service(isWaiting);
+
+        lock.lock();
+
+        if (task->isRemoved || serviceTime == time_point::max()) {
+            // the queue was stopped, don't look at it again
+            task->state = Task::State::Idle;
+            _idleCondition.notify_all();
+            continue;
+        }
+
+        auto now = p_high_resolution_clock::now();
+        if (isWaiting && task->isWakePending) {
+            serviceTime = now;
+        }
+
+        schedule(*task, serviceTime, isWaiting, now);
+    }
+}
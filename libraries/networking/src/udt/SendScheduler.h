@@ -0,0 +1,94 @@
+//
+//  SendScheduler.h
+//  libraries/networking/src/udt
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendScheduler_h
+#define hifi_SendScheduler_h
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+// Services every SendQueue from a small fixed pool of send threads
+//   A queue is serviced when its next allowed send time comes, which is set by its packet send period, or as soon as
+//   it is woken up if it was waiting for packets, ACKs or NAKs. Queues waiting for a time sit in a hashed timer wheel
+//   of TICK_USECS slots, and queues that are due are serviced in turn by the first free send thread.
+//   A queue is only ever serviced by one send thread at a time.
+class SendScheduler {
+public:
+    using time_point = p_high_resolution_clock::time_point;
+
+    // bookkeeping of the scheduler for a queue, guarded by the scheduler mutex
+    struct Task {
+        enum class State { Idle, Scheduled, Ready, Busy };
+
+        // services the queue, returns when it should be serviced next (max once stopped) and sets isWaiting
+        std::function<time_point(bool& isWaiting)> service;
+        State state { State::Idle };
+        time_point serviceTime;
+        bool isWaiting { false }; // waiting for an event rather than its send time, any wake up services it now
+        bool isWakePending { false }; // woken up while it was being serviced
+        bool isRemoved { false };
+    };
+
+    // every queue holds on to the scheduler, so that it outlives them even when they are destroyed after static teardown
+    static std::shared_ptr<SendScheduler> getInstance();
+
+    // queues use the shared instance, a scheduler of its own is for tests
+    explicit SendScheduler(int numThreads);
+    ~SendScheduler();
+
+    // start servicing a queue, right away
+    void add(Task& task);
+
+    // service a waiting queue now, does nothing if the queue is paced or already due
+    void wake(Task& task);
+
+    // stop servicing a queue, waits for a send thread that is servicing it to be done
+    void remove(Task& task);
+
+    int getNumThreads() const { return (int)_threads.size(); }
+
+private:
+    void run();
+
+    void schedule(Task& task, time_point serviceTime, bool isWaiting, time_point now);
+    void unschedule(Task& task);
+    void advance(time_point now);
+    time_point nextServiceTime() const;
+
+    std::mutex _mutex;
+    std::condition_variable _condition; // send threads wait on it for due queues
+    std::condition_variable _idleCondition; // remove waits on it for a busy queue
+
+    std::vector<std::vector<Task*>> _slots;
+    std::deque<Task*> _ready;
+    uint64_t _currentTick { 0 }; // the tick of the last advance, its slot is looked at again on the next one
+    time_point _sleepUntil; // when sleeping send threads will wake up on their own
+    size_t _numScheduled { 0 };
+    bool _isStopping { false };
+
+    std::vector<std::thread> _threads;
+};
+
+} // namespace udt
+
+#endif // hifi_SendScheduler_h
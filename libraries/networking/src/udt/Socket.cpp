@@ -15,6 +15,14 @@
 #include <sys/socket.h>
 #endif
 
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -31,6 +39,77 @@
 
 using namespace udt;
 
+#ifdef Q_OS_LINUX
+
+// number of datagrams sent by a single sendmmsg call, a full batch is sent right away
+static const int DATAGRAMS_PER_SEND_BATCH = 64;
+
+// unreliable datagrams written by one thread between beginDatagramBatch and flushDatagramBatch
+struct DatagramBatch {
+    struct Datagram {
+        size_t offset;
+        int size;
+        uint32_t address; // IPv4, host order
+        quint16 port;
+    };
+
+    const Socket* socket { nullptr }; // the socket the batch is open on, null while no batch is open
+    std::vector<char> data;
+    std::vector<Datagram> datagrams;
+};
+
+static thread_local DatagramBatch datagramBatch;
+
+static void sendDatagramBatch(int socketDescriptor) {
+    int numDatagrams = (int)datagramBatch.datagrams.size();
+    if (numDatagrams == 0) {
+        return;
+    }
+
+    sockaddr_in addresses[DATAGRAMS_PER_SEND_BATCH];
+    iovec vectors[DATAGRAMS_PER_SEND_BATCH];
+    mmsghdr messages[DATAGRAMS_PER_SEND_BATCH];
+
+    // data may have moved while the batch was filled, so pointers are only taken now
+    for (int i = 0; i < numDatagrams; ++i) {
+        auto& datagram = datagramBatch.datagrams[i];
+
+        memset(&addresses[i], 0, sizeof(sockaddr_in));
+        addresses[i].sin_family = AF_INET;
+        addresses[i].sin_port = htons(datagram.port);
+        addresses[i].sin_addr.s_addr = htonl(datagram.address);
+
+        vectors[i].iov_base = &datagramBatch.data[datagram.offset];
+        vectors[i].iov_len = datagram.size;
+
+        memset(&messages[i], 0, sizeof(mmsghdr));
+        messages[i].msg_hdr.msg_name = &addresses[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        messages[i].msg_hdr.msg_iov = &vectors[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int numHandled = 0;
+    while (numHandled < numDatagrams) {
+        int numSent = sendmmsg(socketDescriptor, &messages[numHandled], numDatagrams - numHandled, 0);
+        if (numSent > 0) {
+            numHandled += numSent;
+        } else if (numSent < 0 && errno == EINTR) {
+            continue;
+        } else {
+            // the first datagram left could not be sent - drop it, as writeDatagram would have
+            // when saturating a link this isn't an uncommon message - suppress it so it doesn't bomb the debug
+            HIFI_FCDEBUG(networking(), "Socket::flushDatagramBatch" << strerror(errno));
+            ++numHandled;
+        }
+    }
+
+    datagramBatch.data.clear();
+    datagramBatch.datagrams.clear();
+}
+
+#endif
+
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
     _synTimer(new QTimer(this)),
@@ -57,7 +136,24 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
 }
 
 void Socket::bind(const QHostAddress& address, quint16 port) {
-    _udpSocket.bind(address, port);
+    int reusePortSocket = -1;
+    if (_numReceiveThreads > 0 && BatchedReceiver::isSupported()) {
+        // the first reader shares its socket with _udpSocket, which still handles all of the writes
+        reusePortSocket = BatchedReceiver::createReusePortSocket(address, port);
+    }
+
+    if (reusePortSocket >= 0) {
+        _udpSocket.setSocketDescriptor(reusePortSocket, QAbstractSocket::BoundState);
+    } else {
+        _udpSocket.bind(address, port);
+
+        if (_batchedReceiver) {
+            // we could not bind for batched receive again, go back to reading on the socket thread
+            _batchedReceiver.reset();
+            connect(&_udpSocket, &QUdpSocket::readyRead, this, &Socket::readPendingDatagrams, Qt::UniqueConnection);
+            _readyReadBackupTimer->start();
+        }
+    }
 
     if (_shouldChangeSocketOptions) {
         setSystemBufferSizes();
@@ -72,6 +168,25 @@ void Socket::bind(const QHostAddress& address, quint16 port) {
         setsockopt(sd, IPPROTO_IP, IP_DONTFRAGMENT, &val, sizeof(val));
 #endif
     }
+
+    if (reusePortSocket >= 0) {
+        startBatchedReceive(address);
+    }
+}
+
+void Socket::startBatchedReceive(const QHostAddress& address) {
+    // datagrams are now read by the receiver threads and handed back to be processed on the socket thread,
+    // so nothing is left for the readyRead path or its backup timer to do
+    disconnect(&_udpSocket, &QUdpSocket::readyRead, this, &Socket::readPendingDatagrams);
+    _readyReadBackupTimer->stop();
+
+    if (!_batchedReceiver) {
+        _batchedReceiver.reset(new BatchedReceiver([this] {
+            QMetaObject::invokeMethod(this, "readBatchedDatagrams", Qt::QueuedConnection);
+        }));
+    }
+
+    _batchedReceiver->start(_udpSocket.socketDescriptor(), address, _udpSocket.localPort(), _numReceiveThreads - 1);
 }
 
 void Socket::rebind() {
@@ -79,6 +194,11 @@ void Socket::rebind() {
 }
 
 void Socket::rebind(quint16 localPort) {
+    if (_batchedReceiver) {
+        // the readers must be done with the socket before it is closed
+        _batchedReceiver->stop();
+    }
+
     _udpSocket.close();
     bind(QHostAddress::AnyIPv4, localPort);
 }
@@ -220,9 +340,47 @@ void Socket::writeReliablePacketList(PacketList* packetList, const HifiSockAddr&
 }
 
 qint64 Socket::writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr) {
+#ifdef Q_OS_LINUX
+    if (datagramBatch.socket == this && sockAddr.getAddress().protocol() == QAbstractSocket::IPv4Protocol) {
+        // copy the datagram into the batch, the packet it came from is usually gone before the batch is flushed
+        size_t offset = datagramBatch.data.size();
+        datagramBatch.data.insert(datagramBatch.data.end(), data, data + size);
+        datagramBatch.datagrams.push_back({ offset, (int)size, sockAddr.getAddress().toIPv4Address(), sockAddr.getPort() });
+
+        if (datagramBatch.datagrams.size() == DATAGRAMS_PER_SEND_BATCH) {
+            sendDatagramBatch(_udpSocket.socketDescriptor());
+        }
+
+        return size;
+    }
+#endif
+
     return writeDatagram(QByteArray::fromRawData(data, size), sockAddr);
 }
 
+void Socket::beginDatagramBatch() {
+#ifdef Q_OS_LINUX
+    if (datagramBatch.socket && datagramBatch.socket != this) {
+        // this thread left a batch open on another socket, send it before switching
+        sendDatagramBatch(datagramBatch.socket->_udpSocket.socketDescriptor());
+    } else if (datagramBatch.data.capacity() == 0) {
+        datagramBatch.data.reserve(DATAGRAMS_PER_SEND_BATCH * MAX_PACKET_SIZE);
+        datagramBatch.datagrams.reserve(DATAGRAMS_PER_SEND_BATCH);
+    }
+
+    datagramBatch.socket = this;
+#endif
+}
+
+void Socket::flushDatagramBatch() {
+#ifdef Q_OS_LINUX
+    if (datagramBatch.socket == this) {
+        sendDatagramBatch(_udpSocket.socketDescriptor());
+        datagramBatch.socket = nullptr;
+    }
+#endif
+}
+
 qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr) {
 
     qint64 bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
@@ -336,7 +494,7 @@ void Socket::readPendingDatagrams() {
         HifiSockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
@@ -352,69 +510,91 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    }
+}
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+void Socket::readBatchedDatagrams() {
+    if (!_batchedReceiver) {
+        return;
+    }
 
-            continue;
+    // clear the flag first, so that datagrams queued while we drain trigger another call
+    _batchedReceiver->clearReadyFlag();
+
+    std::unique_ptr<BatchedReceiver::Datagram> datagram;
+    while (_batchedReceiver->popDatagram(datagram)) {
+        _lastPacketSizeRead = datagram->size;
+        _lastPacketSockAddr = datagram->senderSockAddr;
+
+        processDatagram(std::move(datagram->data), datagram->size, datagram->senderSockAddr, datagram->receiveTime);
+    }
+}
+
+void Socket::processDatagram(PacketBuffer buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        return;
+    }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr);
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
-            }
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr);
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
-
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
-
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
-                    auto connection = findOrCreateConnection(senderSockAddr);
-
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+                auto connection = findOrCreateConnection(senderSockAddr);
+
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                    qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                        << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
+                    return;
                 }
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
@@ -472,6 +652,19 @@ void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtua
     _synInterval = _ccFactory->synInterval();
 }
 
+bool Socket::setCongestionControl(const QString& name) {
+    if (name == "vegas") {
+        setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<TCPVegasCC>()));
+    } else if (name == "bbr") {
+        setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<BBRCC>()));
+    } else {
+        qCWarning(networking) << "Unknown congestion control" << name << "- keeping the current one";
+        return false;
+    }
+
+    qCDebug(networking) << "Using" << name << "congestion control for new connections";
+    return true;
+}
 
 void Socket::setConnectionMaxBandwidth(int maxBandwidth) {
     qInfo() << "Setting socket's maximum bandwith to" << maxBandwidth << "bps. ("
@@ -23,6 +23,8 @@
 #include <QtNetwork/QUdpSocket>
 
 #include "../HifiSockAddr.h"
+#include "BatchedReceiver.h"
+#include "BBRCC.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
 
@@ -65,11 +67,21 @@ public:
     qint64 writePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
+
+    // unreliable datagrams written by the calling thread are queued until it flushes the batch,
+    // and then sent with as few system calls as possible (sendmmsg on Linux, a no-op elsewhere)
+    void beginDatagramBatch();
+    void flushDatagramBatch();
     
     void bind(const QHostAddress& address, quint16 port = 0);
     void rebind(quint16 port);
     void rebind();
 
+    // read datagrams in batches on this many dedicated threads instead of on the socket thread (Linux only)
+    // each thread beyond the first reads from its own SO_REUSEPORT socket, takes effect on the next bind
+    void setNumReceiveThreads(int numReceiveThreads) { _numReceiveThreads = numReceiveThreads; }
+    int getNumReceiveThreads() const { return _batchedReceiver ? _batchedReceiver->getNumReaders() : 0; }
+
     void setPacketFilterOperator(PacketFilterOperator filterOperator) { _packetFilterOperator = filterOperator; }
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
@@ -81,6 +93,10 @@ public:
         { _unfilteredHandlers[senderSockAddr] = handler; }
     
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
+
+    // pick the congestion control of connections created from now on by name ("vegas" or "bbr")
+    // returns false and keeps the current one for an unknown name
+    bool setCongestionControl(const QString& name);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
     void messageReceived(std::unique_ptr<Packet> packet);
@@ -101,6 +117,7 @@ public slots:
     
 private slots:
     void readPendingDatagrams();
+    void readBatchedDatagrams();
     void checkForReadyReadBackup();
     void rateControlSync();
 
@@ -109,6 +126,9 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void startBatchedReceive(const QHostAddress& address);
+    void processDatagram(PacketBuffer buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr);
     bool socketMatchesNodeOrDomain(const HifiSockAddr& sockAddr);
    
@@ -143,6 +163,9 @@ private:
 
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
 
+    int _numReceiveThreads { 0 };
+    std::unique_ptr<BatchedReceiver> _batchedReceiver; // declared after _udpSocket, so readers stop before it closes
+
     bool _shouldChangeSocketOptions { true };
 
     int _lastPacketSizeRead { 0 };
@@ -48,10 +48,11 @@
 #include "OctreeConstants.h"
 #include "OctreeLogging.h"
 #include "OctreeQueryNode.h"
+#include "OctreeSnapshot.h"
 #include "OctreeUtils.h"
 
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "snapshot"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -731,12 +732,17 @@ OctreeElementPointer Octree::getElementEnclosingPoint(const glm::vec3& point, Oc
 }
 
 bool Octree::readFromFile(const char* fileName) {
+    _isFileUnreadable = false;
     QString qFileName = findMostRecentFileExtension(fileName, PERSIST_EXTENSIONS);
 
     if (qFileName.endsWith(".json.gz")) {
         return readJSONFromGzippedFile(qFileName);
     }
 
+    if (qFileName.endsWith("." + OctreeSnapshot::FILE_TYPE)) {
+        return readSnapshotFromFile(qFileName);
+    }
+
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
@@ -775,6 +781,79 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
     return readJSONFromStream(-1, jsonStream);
 }
 
+bool Octree::readJSONFromFile(const QString& qFileName) {
+    QFile file(qFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open json file for reading: " << qFileName;
+        return false;
+    }
+
+    QByteArray data = file.readAll();
+    QByteArray jsonData;
+    if (!gunzip(data, jsonData)) {
+        jsonData = data;
+    }
+
+    QDataStream jsonStream(jsonData);
+    return readJSONFromStream(-1, jsonStream);
+}
+
+bool Octree::readSnapshotFromFile(const QString& qFileName) {
+    QFile file(qFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open snapshot file for reading: " << qFileName;
+        return false;
+    }
+
+    // replacement data from the domain server and restored backups can be JSON, whatever the extension
+    if (!OctreeSnapshot::isSnapshot(file.peek(sizeof(OctreeSnapshot::Header)))) {
+        qCDebug(octree) << "Loading JSON from snapshot file" << qFileName << "...";
+        return readJSONFromFile(qFileName);
+    }
+
+    qCDebug(octree) << "Loading snapshot file" << qFileName << "...";
+
+    // read the snapshot in place, the entities are decoded straight from the mapped file
+    uint64_t fileSize = file.size();
+    QByteArray fileContents;
+    uchar* mappedFile = file.map(0, fileSize);
+    const char* data = reinterpret_cast<const char*>(mappedFile);
+    if (!mappedFile) {
+        fileContents = file.readAll();
+        data = fileContents.constData();
+    }
+
+    OctreeSnapshotReader reader(data, fileSize);
+    bool success = false;
+    if (!reader.isValid() || reader.getDataPacketType() != expectedDataPacketType()) {
+        qCritical() << "Invalid snapshot file:" << qFileName;
+        _isFileUnreadable = true;
+    } else if (reader.getProtocolVersion() == expectedVersion()) {
+        success = readFromSnapshot(reader);
+    } else {
+        // the item data of another protocol version can't be decoded, but the JSON copy of the octree can
+        qCWarning(octree) << "Snapshot" << qFileName << "was written with protocol version" << (int)reader.getProtocolVersion()
+            << "instead of" << (int)expectedVersion() << ", loading its JSON";
+        uint64_t jsonSize;
+        const char* jsonSection = reader.getSection(OctreeSnapshot::JSON_SECTION, jsonSize);
+        QByteArray jsonData;
+        if (jsonSection && gunzip(QByteArray::fromRawData(jsonSection, (int)jsonSize), jsonData)) {
+            QDataStream jsonStream(jsonData);
+            success = readJSONFromStream(-1, jsonStream);
+            setOctreeVersionInfo(reader.getID(), reader.getDataVersion());
+        } else {
+            qCritical() << "Snapshot" << qFileName << "has no JSON that can be read";
+            _isFileUnreadable = true;
+        }
+    }
+
+    if (mappedFile) {
+        file.unmap(mappedFile);
+    }
+
+    return success;
+}
+
 // hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
 // the entity later, but this helps us move things along for now
 QString getMarketplaceID(const QString& urlString) {
@@ -900,7 +979,8 @@ bool Octree::readJSONFromStream(uint64_t streamLength, QDataStream& inputStream,
     return success;
 }
 
-bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
+bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType,
+                         bool withSnapshotJSON) {
     // make the sure file extension makes sense
     QString qFileName = fileNameWithoutExtension(QString(fileName), PERSIST_EXTENSIONS) + "." + persistAsFileType;
     QByteArray byteArray = qFileName.toUtf8();
@@ -911,6 +991,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == OctreeSnapshot::FILE_TYPE) {
+        success = writeToSnapshotFile(cFileName, element, withSnapshotJSON);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -983,6 +1065,28 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::writeToSnapshotFile(const char* fileName, const OctreeElementPointer& element, bool withJSON) {
+    qCDebug(octree, "Saving snapshot to file %s...", fileName);
+
+    OctreeSnapshotWriter writer(expectedDataPacketType(), _persistID, _persistDataVersion);
+    if (!writeToSnapshot(writer, element ? element : _rootElement)) {
+        qCritical("Failed to write the octree to a snapshot.");
+        return false;
+    }
+
+    // the JSON can be written with the rest, so that a build with another protocol version reads the same data
+    if (withJSON) {
+        QByteArray jsonData;
+        if (!toJSON(&jsonData, element, true)) {
+            qCritical("Failed to write the JSON of the octree to a snapshot.");
+            return false;
+        }
+        writer.addSection(OctreeSnapshot::JSON_SECTION, jsonData);
+    }
+
+    return writer.writeToFile(fileName);
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
@@ -32,9 +32,13 @@
 
 class ReadBitstreamToTreeParams;
 class Octree;
+class OctreeEditLog;
 class OctreeElement;
 class OctreePacketData;
+class OctreeSnapshotReader;
+class OctreeSnapshotWriter;
 class Shape;
+struct OctreeEditLogRecord;
 using OctreePointer = std::shared_ptr<Octree>;
 
 extern QVector<QString> PERSIST_EXTENSIONS;
@@ -207,10 +211,14 @@ public:
     // Octree exporters
     bool toJSONDocument(QJsonDocument* doc, const OctreeElementPointer& element = nullptr);
     bool toJSON(QByteArray* data, const OctreeElementPointer& element = nullptr, bool doGzip = false);
-    bool writeToFile(const char* filename, const OctreeElementPointer& element = nullptr, QString persistAsFileType = "json.gz");
+    // withSnapshotJSON: whether a snapshot also carries the JSON of the octree, for a build with another protocol version
+    bool writeToFile(const char* filename, const OctreeElementPointer& element = nullptr, QString persistAsFileType = "json.gz",
+                     bool withSnapshotJSON = true);
     bool writeToJSONFile(const char* filename, const OctreeElementPointer& element = nullptr, bool doGzip = false);
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
+    bool writeToSnapshotFile(const char* filename, const OctreeElementPointer& element = nullptr, bool withJSON = true);
+    virtual bool writeToSnapshot(OctreeSnapshotWriter& writer, const OctreeElementPointer& element) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -219,7 +227,20 @@ public:
     bool readSVOFromStream(uint64_t streamLength, QDataStream& inputStream);
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="");
     bool readJSONFromGzippedFile(QString qFileName);
+    bool readJSONFromFile(const QString& qFileName); // gzipped or not
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    bool readSnapshotFromFile(const QString& qFileName);
+    virtual bool readFromSnapshot(const OctreeSnapshotReader& reader) { return false; }
+
+    // whether the last file read exists but holds nothing this build can read, so that it mustn't be overwritten
+    bool isFileUnreadable() const { return _isFileUnreadable; }
+
+    // Edit log, for trees that can record the changes to their items between full saves (see OctreeEditLog)
+    //   Callers must lock the tree. Once enabled, the tree tracks its changes, and appends them to the log on request.
+    virtual bool supportsEditLog() const { return false; }
+    virtual void setWantEditLog(bool wantEditLog) { }
+    virtual void appendEditsToLog(OctreeEditLog& editLog) { }
+    virtual bool replayEditLogRecord(const OctreeEditLogRecord& record) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -254,6 +275,8 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    QUuid getPersistID() const { return _persistID; }
+    int64_t getPersistDataVersion() const { return _persistDataVersion; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
@@ -281,6 +304,8 @@ protected:
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
+    bool _isFileUnreadable { false };
+
     bool _isDirty;
     bool _shouldReaverage;
 
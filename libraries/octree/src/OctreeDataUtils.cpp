@@ -18,6 +18,8 @@
 #include <QJsonDocument>
 #include <QFile>
 
+#include "OctreeSnapshot.h"
+
 // Reads octree file and parses it into a QJsonDocument. Handles both gzipped and non-gzipped files.
 // Returns true if the file was successfully opened and parsed, otherwise false.
 // Example failures: file does not exist, gzipped file cannot be unzipped, invalid JSON.
@@ -64,8 +66,16 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromData(QByteArray data) {
 }
 
 // Reads octree file and parses it into a RawOctreeData object.
+// Snapshot files only have their id and version read, from their header.
 // Returns false if readOctreeFile fails.
 bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromFile(QString path) {
+    OctreeSnapshot::Header header;
+    if (OctreeSnapshot::readHeaderFromFile(path, header)) {
+        id = QUuid::fromRfc4122(QByteArray(reinterpret_cast<const char*>(header.id), sizeof(header.id)));
+        version = header.dataVersion;
+        return true;
+    }
+
     QJsonDocument doc;
     if (!readOctreeFile(path, &doc)) {
         return false;
@@ -0,0 +1,202 @@
+//
+//  OctreeEditLog.cpp
+//  libraries/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEditLog.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+
+#include "OctreeLogging.h"
+
+const QString OctreeEditLog::FILE_EXTENSION = "editlog";
+const uint32_t OctreeEditLog::FORMAT_VERSION = 1;
+
+static const char EDIT_LOG_MAGIC[4] = { 'H', 'F', 'E', 'L' };
+
+struct EditLogHeader {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t dataPacketType;
+    uint32_t protocolVersion;
+    uint8_t baseID[NUM_BYTES_RFC4122_UUID];
+    int64_t baseDataVersion;
+};
+
+struct EditLogRecordHeader {
+    uint32_t size; // of the data that follows
+    uint16_t checksum; // of the record, with this field zeroed
+    uint8_t type;
+    uint8_t reserved;
+    uint8_t id[NUM_BYTES_RFC4122_UUID];
+};
+
+static EditLogHeader makeHeader(PacketType dataPacketType, const QUuid& baseID, int64_t baseDataVersion) {
+    EditLogHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EDIT_LOG_MAGIC, sizeof(header.magic));
+    header.formatVersion = OctreeEditLog::FORMAT_VERSION;
+    header.dataPacketType = (uint32_t)dataPacketType;
+    header.protocolVersion = (uint32_t)versionForPacketType(dataPacketType);
+    memcpy(header.baseID, baseID.toRfc4122().constData(), sizeof(header.baseID));
+    header.baseDataVersion = baseDataVersion;
+    return header;
+}
+
+// the checksum of a record is taken in place, once its checksum field is zeroed
+static void clearRecordChecksum(char* record) {
+    memset(record + offsetof(EditLogRecordHeader, checksum), 0, sizeof(uint16_t));
+}
+
+OctreeEditLog::OctreeEditLog(const QString& path, PacketType dataPacketType) :
+    _path(path),
+    _dataPacketType(dataPacketType)
+{
+}
+
+int OctreeEditLog::open(const QUuid& baseID, int64_t baseDataVersion,
+                        const std::function<bool(const OctreeEditLogRecord&)>& replay) {
+    _file.close();
+    _pendingRecords.clear();
+    _numPendingRecords = 0;
+
+    QByteArray log;
+    {
+        QFile file(_path);
+        if (file.open(QIODevice::ReadOnly)) {
+            log = file.readAll();
+        }
+    }
+
+    if (log.isEmpty()) {
+        reset(baseID, baseDataVersion);
+        return 0;
+    }
+
+    EditLogHeader expectedHeader = makeHeader(_dataPacketType, baseID, baseDataVersion);
+    if (log.size() < (int)sizeof(EditLogHeader) || memcmp(log.constData(), &expectedHeader, sizeof(EditLogHeader)) != 0) {
+        // the records can't be replayed, by another protocol version or onto other data, but they aren't thrown away
+        if (log.size() > (int)sizeof(EditLogHeader)) {
+            static const QString FILENAME_TIMESTAMP_FORMAT = "yyyyMMdd-hhmmss";
+            QString backupPath = _path + ".backup." + QDateTime::currentDateTime().toString(FILENAME_TIMESTAMP_FORMAT);
+            if (!QFile::rename(_path, backupPath)) {
+                qCWarning(octree) << "Could not move edit log" << _path << "of other data to" << backupPath
+                    << ", not appending to it";
+                return 0;
+            }
+            qCWarning(octree) << "Moved edit log" << _path << "to" << backupPath << "since it isn't a log of the current data";
+        }
+        reset(baseID, baseDataVersion);
+        return 0;
+    }
+
+    int numRecords = 0;
+    qint64 validSize = sizeof(EditLogHeader);
+    char* logData = log.data();
+    while (validSize + (qint64)sizeof(EditLogRecordHeader) <= log.size()) {
+        char* recordAt = logData + validSize;
+        EditLogRecordHeader recordHeader;
+        memcpy(&recordHeader, recordAt, sizeof(recordHeader));
+        clearRecordChecksum(recordAt);
+
+        qint64 recordSize = (qint64)sizeof(EditLogRecordHeader) + recordHeader.size;
+        if (recordSize > log.size() - validSize || qChecksum(recordAt, (uint)recordSize) != recordHeader.checksum) {
+            break;
+        }
+
+        OctreeEditLogRecord record;
+        record.type = recordHeader.type;
+        record.id = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(recordHeader.id),
+                                                               NUM_BYTES_RFC4122_UUID));
+        record.data = recordAt + sizeof(EditLogRecordHeader);
+        record.size = (int)recordHeader.size;
+        if (!replay(record)) {
+            qCWarning(octree) << "Could not replay edit log record" << numRecords << "for" << record.id;
+        }
+
+        ++numRecords;
+        validSize += recordSize;
+    }
+
+    if (validSize < log.size()) {
+        qCWarning(octree) << "Edit log" << _path << "is incomplete after" << numRecords << "records, truncating it";
+    }
+
+    // keep appending after the last complete record
+    _file.setFileName(_path);
+    if (!_file.open(QIODevice::ReadWrite) || !_file.resize(validSize) || !_file.seek(validSize)) {
+        qCWarning(octree) << "Could not open edit log" << _path << "for appending";
+        _file.close();
+    }
+    _size = validSize;
+
+    return numRecords;
+}
+
+bool OctreeEditLog::reset(const QUuid& baseID, int64_t baseDataVersion) {
+    _file.close();
+    _pendingRecords.clear();
+    _numPendingRecords = 0;
+    _size = 0;
+
+    _file.setFileName(_path);
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(octree) << "Could not open edit log" << _path << "for writing";
+        return false;
+    }
+
+    EditLogHeader header = makeHeader(_dataPacketType, baseID, baseDataVersion);
+    if (_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header) || !_file.flush()) {
+        qCWarning(octree) << "Could not write edit log" << _path;
+        _file.close();
+        return false;
+    }
+
+    _size = sizeof(header);
+    return true;
+}
+
+void OctreeEditLog::appendRecord(RecordType type, const QUuid& id, const QByteArray& data) {
+    EditLogRecordHeader recordHeader;
+    memset(&recordHeader, 0, sizeof(recordHeader));
+    recordHeader.size = (uint32_t)data.size();
+    recordHeader.type = type;
+    memcpy(recordHeader.id, id.toRfc4122().constData(), sizeof(recordHeader.id));
+
+    int recordAt = _pendingRecords.size();
+    _pendingRecords.append(reinterpret_cast<const char*>(&recordHeader), sizeof(recordHeader));
+    _pendingRecords.append(data);
+
+    int recordSize = _pendingRecords.size() - recordAt;
+    // the header was appended with its checksum field zeroed
+    uint16_t checksum = qChecksum(_pendingRecords.constData() + recordAt, (uint)recordSize);
+    memcpy(_pendingRecords.data() + recordAt + offsetof(EditLogRecordHeader, checksum), &checksum, sizeof(checksum));
+
+    _size += recordSize;
+    ++_numPendingRecords;
+}
+
+bool OctreeEditLog::flush() {
+    if (_pendingRecords.isEmpty()) {
+        return _file.isOpen();
+    }
+
+    bool success = _file.isOpen() && _file.write(_pendingRecords) == _pendingRecords.size() && _file.flush();
+    if (!success) {
+        qCWarning(octree) << "Could not append" << _numPendingRecords << "records to edit log" << _path;
+    }
+
+    _pendingRecords.clear();
+    _numPendingRecords = 0;
+    return success;
+}
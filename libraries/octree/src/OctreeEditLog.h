@@ -0,0 +1,79 @@
+//
+//  OctreeEditLog.h
+//  libraries/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreeEditLog_h
+#define hifi_OctreeEditLog_h
+
+#include <functional>
+#include <stdint.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+#include <UUID.h>
+#include <udt/PacketHeaders.h>
+
+struct OctreeEditLogRecord {
+    uint8_t type;
+    QUuid id;
+    const char* data;
+    int size;
+};
+
+// Append-only log of the changes to the items of an octree since it was last saved in full
+//   The log applies to the saved data with a given id and version, which is recorded in its header, so a log that
+//   was left behind by other data is moved aside as a backup rather than replayed. The record data can depend on the
+//   protocol version of the data packet type, which is recorded too, so owners save in full before they shut down.
+//   Each record holds the id of an item and, for upserts, its current state. Records are checksummed, so that a
+//   record torn by a crash while appending ends the replay.
+class OctreeEditLog {
+public:
+    enum RecordType : uint8_t {
+        UPSERT_RECORD = 1, // an item was added or edited, the record holds its state
+        ERASE_RECORD // an item was erased, the record has no data
+    };
+
+    static const QString FILE_EXTENSION;
+    static const uint32_t FORMAT_VERSION;
+
+    OctreeEditLog(const QString& path, PacketType dataPacketType);
+
+    // Replay the log of changes to the data with this id and version, then keep appending to it
+    //   A log of other data is moved aside and a new one started. Returns the number of records replayed.
+    int open(const QUuid& baseID, int64_t baseDataVersion, const std::function<bool(const OctreeEditLogRecord&)>& replay);
+
+    // start a new empty log, once the data has been saved in full with this id and version
+    bool reset(const QUuid& baseID, int64_t baseDataVersion);
+
+    // records are buffered until the next flush
+    void appendRecord(RecordType type, const QUuid& id, const QByteArray& data = QByteArray());
+    bool flush();
+
+    const QString& getPath() const { return _path; }
+    qint64 getSize() const { return _size; } // including the records that aren't flushed yet
+    int getNumPendingRecords() const { return _numPendingRecords; }
+
+private:
+    QString _path;
+    PacketType _dataPacketType;
+
+    QFile _file;
+    qint64 _size { 0 };
+
+    QByteArray _pendingRecords;
+    int _numPendingRecords { 0 };
+};
+
+#endif // hifi_OctreeEditLog_h
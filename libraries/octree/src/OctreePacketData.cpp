@@ -507,10 +507,12 @@ bool OctreePacketData::appendValue(bool value) {
 
 bool OctreePacketData::appendValue(const QString& string) {
     // TODO: make this a ByteCountCoded leading byte
-    uint16_t length = string.size() + 1; // include NULL
+    // the length is that of the UTF-8 bytes, which is longer than the string for non-ASCII characters
+    QByteArray utf8String = string.toUtf8();
+    uint16_t length = utf8String.size() + 1; // include NULL
     bool success = appendValue(length);
     if (success) {
-        success = appendRawData((const unsigned char*)qPrintable(string), length);
+        success = appendRawData((const unsigned char*)utf8String.constData(), length);
     }
     return success;
 }
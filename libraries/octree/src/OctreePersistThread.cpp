@@ -11,6 +11,7 @@
 
 #include "OctreePersistThread.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -27,6 +28,7 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 
+#include <Gzip.h>
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <PathUtils.h>
@@ -34,8 +36,10 @@
 #include "OctreeLogging.h"
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
+#include "OctreeSnapshot.h"
 
 const int OctreePersistThread::DEFAULT_PERSIST_INTERVAL = 1000 * 30; // every 30 seconds
+const int OctreePersistThread::MAX_EDIT_LOG_APPEND_INTERVAL = 1000; // every second
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory, int persistInterval,
                                          bool wantBackup, const QJsonObject& settings, bool debugTimestampNow,
@@ -64,7 +68,7 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == OctreeSnapshot::FILE_TYPE) {
         return "application/zip";
     }
     return "";
@@ -118,6 +122,11 @@ void OctreePersistThread::parseSettings(const QJsonObject& settings) {
     } else {
         qCDebug(octree) << "BACKUP RULES: NONE";
     }
+
+    QJsonValue editLogMaxSizeVal = settings["editLogMaxSize"];
+    int editLogMaxSizeMegabytes = editLogMaxSizeVal.isString() ? editLogMaxSizeVal.toString().toInt() : editLogMaxSizeVal.toInt();
+    _editLogMaxSize = (qint64)std::max(editLogMaxSizeMegabytes, 0) * KILO_PER_MEGA * BYTES_PER_KILOBYTE;
+    qCDebug(octree) << "EDIT LOG MAX SIZE:" << _editLogMaxSize << "bytes";
 }
 
 quint64 OctreePersistThread::getMostRecentBackupTimeInUsecs(const QString& format) {
@@ -184,6 +193,7 @@ bool OctreePersistThread::process() {
         }
 
         bool persistentFileRead;
+        int numEditLogRecords = 0;
 
         _tree->withWriteLock([&] {
             PerformanceWarning warn(true, "Loading Octree File", true);
@@ -202,6 +212,18 @@ bool OctreePersistThread::process() {
             }
 
             persistentFileRead = _tree->readFromFile(qPrintable(_filename.toLocal8Bit()));
+
+            // saving the tree now would replace the data of the file, and its edits, with nothing
+            _isPersistFileUnreadable = _tree->isFileUnreadable();
+            if (_isPersistFileUnreadable) {
+                qCritical() << "The persist file for" << _filename << "can't be read, it won't be saved over";
+            }
+
+            // the edits since the last full save are only in the edit log
+            if (_editLogMaxSize > 0 && _tree->supportsEditLog() && !_isPersistFileUnreadable) {
+                numEditLogRecords = openEditLog();
+            }
+
             _tree->pruneTree();
         });
 
@@ -209,6 +231,9 @@ bool OctreePersistThread::process() {
         _loadTimeUSecs = loadDone - loadStarted;
 
         _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+        if (numEditLogRecords > 0) {
+            _tree->setDirtyBit(); // except for the replayed edits, which still need a full save
+        }
         qCDebug(octree, "DONE loading Octrees from file... fileRead=%s", debug::valueOf(persistentFileRead));
 
         unsigned long nodeCount = OctreeElement::getNodeCount();
@@ -239,7 +264,7 @@ bool OctreePersistThread::process() {
         // want an uninitialized value for this, so we set it to the current time (startup of the server)
         time(&_lastPersistTime);
 
-        if (_replacementData.isNull()) {
+        if (_replacementData.isNull() && !_isPersistFileUnreadable) {
             sendLatestEntityDataToDS();
         }
         _replacementData.clear();
@@ -257,7 +282,9 @@ bool OctreePersistThread::process() {
 
         quint64 now = usecTimestampNow();
         quint64 sinceLastSave = now - _lastCheck;
-        quint64 intervalToCheck = _persistInterval * MSECS_TO_USECS;
+        // appending to the edit log is cheap enough to do more often than saving in full
+        int persistInterval = _editLog ? std::min(_persistInterval, MAX_EDIT_LOG_APPEND_INTERVAL) : _persistInterval;
+        quint64 intervalToCheck = persistInterval * MSECS_TO_USECS;
 
         if (sinceLastSave > intervalToCheck) {
             _lastCheck = now;
@@ -281,13 +308,27 @@ bool OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
-    persist();
+    // save in full, so that the edit log left behind is empty for the next build, which may not be able to replay it
+    persist(true);
     qCDebug(octree) << "Persist thread done with about to finish...";
     _stopThread = true;
 }
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+
+    // snapshots are exported as JSON, which any build can read, and with an edit log the file misses the latest edits
+    if (_persistAsFileType == OctreeSnapshot::FILE_TYPE || _editLog) {
+        fileContents = getLatestJSON();
+        if (_persistAsFileType == "json") {
+            QByteArray gzippedContents = fileContents;
+            if (!gunzip(gzippedContents, fileContents)) {
+                fileContents.clear();
+            }
+        }
+        return fileContents;
+    }
+
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -295,7 +336,24 @@ QByteArray OctreePersistThread::getPersistFileContents() const {
     return fileContents;
 }
 
-void OctreePersistThread::persist() {
+void OctreePersistThread::persist(bool isFullSave) {
+    if (_isPersistFileUnreadable) {
+        return;
+    }
+
+    // with an edit log, changes are appended to it until it has grown enough for a full save to be worthwhile
+    // (the DS is only sent the whole tree with the full saves, since making it costs as much as one)
+    if (_editLog && _initialLoadComplete && !isFullSave) {
+        qint64 editLogSize = _editLog->getSize();
+        bool isAppended = appendEditsToLog();
+        if (_editLog->getSize() > editLogSize) {
+            ++_persistGeneration;
+        }
+        if (isAppended && _editLog->getSize() < _editLogMaxSize && QFile::exists(_filename)) {
+            return;
+        }
+    }
+
     if (_tree->isDirty() && _initialLoadComplete) {
 
         _tree->withWriteLock([&] {
@@ -316,11 +374,19 @@ void OctreePersistThread::persist() {
         if(lockFile.is_open()) {
             qCDebug(octree) << "saving Octree lock file created at:" << lockFileName;
 
-            _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
+            // only the file left on shutdown is read by the next build, which may have another protocol version,
+            // so the periodic saves of snapshots skip their JSON
+            _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType, isFullSave);
             time(&_lastPersistTime);
+            ++_persistGeneration;
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE saving Octree to file...";
 
+            if (_editLog) {
+                // edits since the save began are still tracked by the tree, and go to the new log
+                _editLog->reset(_tree->getPersistID(), _tree->getPersistDataVersion());
+            }
+
             lockFile.close();
             qCDebug(octree) << "saving Octree lock file closed:" << lockFileName;
             remove(qPrintable(lockFileName));
@@ -331,13 +397,36 @@ void OctreePersistThread::persist() {
     }
 }
 
+int OctreePersistThread::openEditLog() {
+    // NOTE: callers must lock the tree, so that no edits are missed between the replay and tracking them
+    QString editLogPath = _filename + "." + OctreeEditLog::FILE_EXTENSION;
+    _editLog.reset(new OctreeEditLog(editLogPath, _tree->expectedDataPacketType()));
+
+    int numRecords = _editLog->open(_tree->getPersistID(), _tree->getPersistDataVersion(),
+                                    [&](const OctreeEditLogRecord& record) {
+        return _tree->replayEditLogRecord(record);
+    });
+    qCDebug(octree) << "Replayed" << numRecords << "records from edit log" << editLogPath;
+
+    _tree->setWantEditLog(true);
+    return numRecords;
+}
+
+bool OctreePersistThread::appendEditsToLog() {
+    _tree->withReadLock([&] {
+        _tree->appendEditsToLog(*_editLog);
+    });
+    return _editLog->flush();
+}
+
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
+
     auto nodeList = DependencyManager::get<NodeList>();
     const DomainHandler& domainHandler = nodeList->getDomainHandler();
 
-    QByteArray data;
-    if (_tree->toJSON(&data, nullptr, true)) {
+    QByteArray data = getLatestJSON();
+    if (!data.isEmpty()) {
         auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
         message->write(data);
         nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
@@ -346,6 +435,19 @@ void OctreePersistThread::sendLatestEntityDataToDS() {
     }
 }
 
+QByteArray OctreePersistThread::getLatestJSON() const {
+    QMutexLocker locker(&_latestJSONMutex);
+    quint64 generation = _persistGeneration;
+    if (generation != _latestJSONGeneration) {
+        _latestJSON.clear();
+        if (!_tree->toJSON(&_latestJSON, nullptr, true)) {
+            _latestJSON.clear();
+        }
+        _latestJSONGeneration = generation;
+    }
+    return _latestJSON;
+}
+
 void OctreePersistThread::restoreFromMostRecentBackup() {
     qCDebug(octree) << "Restoring from most recent backup...";
     
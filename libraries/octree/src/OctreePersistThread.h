@@ -14,9 +14,14 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <atomic>
+#include <memory>
+
+#include <QMutex>
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreeEditLog.h"
 
 class OctreePersistThread : public GenericThread {
     Q_OBJECT
@@ -31,6 +36,7 @@ public:
     };
 
     static const int DEFAULT_PERSIST_INTERVAL;
+    static const int MAX_EDIT_LOG_APPEND_INTERVAL;
 
     OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory,
                         int persistInterval = DEFAULT_PERSIST_INTERVAL, bool wantBackup = false,
@@ -53,7 +59,7 @@ protected:
     /// Implements generic processing behavior for this thread.
     virtual bool process() override;
 
-    void persist();
+    void persist(bool isFullSave = false); // a full save, on shutdown, skips the edit log and writes what any build reads
     void backup();
     void rollOldBackupVersions(const BackupRule& rule);
     void restoreFromMostRecentBackup();
@@ -64,6 +70,10 @@ protected:
 
     void replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
+    QByteArray getLatestJSON() const; // gzipped
+
+    int openEditLog();
+    bool appendEditsToLog();
 
 private:
     OctreePointer _tree;
@@ -71,6 +81,7 @@ private:
     QString _backupDirectory;
     int _persistInterval;
     bool _initialLoadComplete;
+    bool _isPersistFileUnreadable { false };
     QByteArray _replacementData;
 
     quint64 _loadTimeUSecs;
@@ -84,6 +95,15 @@ private:
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
+
+    qint64 _editLogMaxSize { 0 }; // in bytes, 0 to always save in full
+    std::unique_ptr<OctreeEditLog> _editLog;
+
+    // the JSON of the tree is made again only once the tree has been saved or edits appended to the log since
+    std::atomic<quint64> _persistGeneration { 1 };
+    mutable QMutex _latestJSONMutex;
+    mutable QByteArray _latestJSON;
+    mutable quint64 _latestJSONGeneration { 0 };
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -0,0 +1,250 @@
+//
+//  OctreeSnapshot.cpp
+//  libraries/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSnapshot.h"
+
+#include <cstring>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+
+#include "OctreeLogging.h"
+
+const QString OctreeSnapshot::FILE_TYPE = "snapshot";
+const uint32_t OctreeSnapshot::FORMAT_VERSION = 1;
+const uint32_t OctreeSnapshot::JSON_SECTION = 0xFFFFFFFF;
+
+static const char SNAPSHOT_MAGIC[4] = { 'H', 'F', 'S', 'N' };
+
+static uint64_t alignedSize(uint64_t size) {
+    return (size + OctreeSnapshot::SECTION_ALIGNMENT - 1) & ~(uint64_t)(OctreeSnapshot::SECTION_ALIGNMENT - 1);
+}
+
+bool OctreeSnapshot::isSnapshot(const QByteArray& data) {
+    return data.size() >= (int)sizeof(SNAPSHOT_MAGIC) && memcmp(data.constData(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0;
+}
+
+bool OctreeSnapshot::readHeaderFromFile(const QString& path, Header& header) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QByteArray data = file.read(sizeof(Header));
+    if (data.size() != sizeof(Header) || !isSnapshot(data)) {
+        return false;
+    }
+
+    memcpy(&header, data.constData(), sizeof(Header));
+    return true;
+}
+
+bool OctreeSnapshot::writeVersionInfoToFile(const QString& path, const QUuid& id, int64_t dataVersion) {
+    Header header;
+    if (!readHeaderFromFile(path, header)) {
+        return false;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    QByteArray idBytes = id.toRfc4122();
+    memcpy(header.id, idBytes.constData(), sizeof(header.id));
+    header.dataVersion = dataVersion;
+
+    return file.write(reinterpret_cast<const char*>(&header), sizeof(Header)) == sizeof(Header);
+}
+
+OctreeSnapshotWriter::OctreeSnapshotWriter(PacketType dataPacketType, const QUuid& id, int64_t dataVersion) :
+    _dataPacketType(dataPacketType),
+    _id(id),
+    _dataVersion(dataVersion)
+{
+}
+
+void OctreeSnapshotWriter::addSection(uint32_t type, QByteArray data) {
+    _sections.emplace_back(type, std::move(data));
+}
+
+bool OctreeSnapshotWriter::write(QIODevice& device) const {
+    OctreeSnapshot::Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.formatVersion = OctreeSnapshot::FORMAT_VERSION;
+    header.dataPacketType = (uint32_t)_dataPacketType;
+    header.protocolVersion = (uint32_t)versionForPacketType(_dataPacketType);
+    QByteArray idBytes = _id.toRfc4122();
+    memcpy(header.id, idBytes.constData(), sizeof(header.id));
+    header.dataVersion = _dataVersion;
+    header.numItems = _numItems;
+    header.numSections = (uint32_t)_sections.size();
+
+    // the sections follow the section table, each on an aligned offset
+    std::vector<OctreeSnapshot::Section> table;
+    uint64_t offset = alignedSize(sizeof(header) + _sections.size() * sizeof(OctreeSnapshot::Section));
+    for (auto& section : _sections) {
+        table.push_back({ section.first, 0, offset, (uint64_t)section.second.size() });
+        offset = alignedSize(offset + section.second.size());
+    }
+
+    static const char PADDING[OctreeSnapshot::SECTION_ALIGNMENT] = { 0 };
+    uint64_t position = 0;
+    auto writeBytes = [&](const char* data, uint64_t size) {
+        if (device.write(data, size) != (qint64)size) {
+            return false;
+        }
+        position += size;
+        return true;
+    };
+    auto writePadding = [&] {
+        return writeBytes(PADDING, alignedSize(position) - position);
+    };
+
+    if (!writeBytes(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+        !writeBytes(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(OctreeSnapshot::Section)) ||
+        !writePadding()) {
+        return false;
+    }
+
+    for (auto& section : _sections) {
+        if (!writeBytes(section.second.constData(), section.second.size()) || !writePadding()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool OctreeSnapshotWriter::writeToFile(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << "Could not open snapshot file for writing:" << path;
+        return false;
+    }
+
+    bool success = write(file);
+    if (!success) {
+        qCritical() << "Could not write snapshot file:" << path;
+    }
+    return success;
+}
+
+OctreeSnapshotReader::OctreeSnapshotReader(const char* data, uint64_t size) :
+    _data(data)
+{
+    if (size < sizeof(OctreeSnapshot::Header) || memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        return;
+    }
+
+    memcpy(&_header, data, sizeof(_header));
+    if (_header.formatVersion != OctreeSnapshot::FORMAT_VERSION) {
+        qCWarning(octree) << "Unsupported snapshot format version" << _header.formatVersion;
+        return;
+    }
+
+    uint64_t tableSize = (uint64_t)_header.numSections * sizeof(OctreeSnapshot::Section);
+    if (sizeof(OctreeSnapshot::Header) + tableSize > size) {
+        return;
+    }
+
+    _sections.resize(_header.numSections);
+    memcpy(_sections.data(), data + sizeof(OctreeSnapshot::Header), tableSize);
+
+    for (auto& section : _sections) {
+        if (section.offset > size || section.size > size - section.offset) {
+            qCWarning(octree) << "Snapshot section" << section.type << "is out of bounds";
+            return;
+        }
+    }
+
+    _isValid = true;
+}
+
+QUuid OctreeSnapshotReader::getID() const {
+    return QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(_header.id), sizeof(_header.id)));
+}
+
+const char* OctreeSnapshotReader::getSection(uint32_t type, uint64_t& size) const {
+    for (auto& section : _sections) {
+        if (section.type == type) {
+            size = section.size;
+            return _data + section.offset;
+        }
+    }
+    size = 0;
+    return nullptr;
+}
+
+OctreeSnapshotStringTableWriter::OctreeSnapshotStringTableWriter() {
+    _offsets.push_back(0);
+    insert(QString());
+}
+
+uint32_t OctreeSnapshotStringTableWriter::insert(const QString& string) {
+    auto it = _indices.find(string);
+    if (it != _indices.end()) {
+        return it.value();
+    }
+
+    uint32_t index = (uint32_t)_offsets.size() - 1;
+    _strings.append(string.toUtf8());
+    _offsets.push_back((uint32_t)_strings.size());
+    _indices.insert(string, index);
+    return index;
+}
+
+QByteArray OctreeSnapshotStringTableWriter::toByteArray() const {
+    uint32_t numStrings = (uint32_t)_offsets.size() - 1;
+
+    QByteArray data;
+    data.reserve(sizeof(numStrings) + _offsets.size() * sizeof(uint32_t) + _strings.size());
+    data.append(reinterpret_cast<const char*>(&numStrings), sizeof(numStrings));
+    data.append(reinterpret_cast<const char*>(_offsets.data()), _offsets.size() * sizeof(uint32_t));
+    data.append(_strings);
+    return data;
+}
+
+bool OctreeSnapshotStringTableReader::init(const char* data, uint64_t size) {
+    if (!data || size < sizeof(uint32_t)) {
+        return false;
+    }
+
+    uint32_t numStrings;
+    memcpy(&numStrings, data, sizeof(numStrings));
+
+    uint64_t offsetsSize = ((uint64_t)numStrings + 1) * sizeof(uint32_t);
+    if (sizeof(uint32_t) + offsetsSize > size) {
+        return false;
+    }
+
+    _numStrings = numStrings;
+    _offsets = reinterpret_cast<const uint32_t*>(data + sizeof(uint32_t));
+    _strings = data + sizeof(uint32_t) + offsetsSize;
+    _stringsSize = size - sizeof(uint32_t) - offsetsSize;
+    return true;
+}
+
+bool OctreeSnapshotStringTableReader::getString(uint32_t index, QString& string) const {
+    if (index >= _numStrings) {
+        return false;
+    }
+
+    uint32_t start = _offsets[index];
+    uint32_t end = _offsets[index + 1];
+    if (start > end || end > _stringsSize) {
+        return false;
+    }
+
+    string = QString::fromUtf8(_strings + start, end - start);
+    return true;
+}
@@ -0,0 +1,151 @@
+//
+//  OctreeSnapshot.h
+//  libraries/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreeSnapshot_h
+#define hifi_OctreeSnapshot_h
+
+#include <stdint.h>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+#include <UUID.h>
+#include <udt/PacketHeaders.h>
+
+class QIODevice;
+
+// Versioned binary snapshot of the items of an octree, laid out to be memory-mapped and read in place
+//   The file starts with a header and a table of sections. Each section holds one column of item data, in the
+//   order of the item index, and its layout is up to the octree subclass that writes it.
+//   Sections start on 8 byte boundaries, so that columns of numbers can be read straight from the mapped file.
+//   Numbers are stored in native (little endian) byte order, as they are in packets.
+//   The item data can depend on the protocol version of the data packet type, which is recorded in the header,
+//   so it is only read back by a build with the same protocol version. The snapshot saved on shutdown also carries
+//   the whole octree as gzipped JSON in its JSON_SECTION, which is what a build with another protocol version reads.
+class OctreeSnapshot {
+public:
+    static const QString FILE_TYPE;
+    static const uint32_t FORMAT_VERSION;
+    static const int SECTION_ALIGNMENT = 8;
+
+    // section type reserved for the gzipped JSON of the octree, the subclass sections use other types
+    static const uint32_t JSON_SECTION;
+
+    struct Header {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t dataPacketType;
+        uint32_t protocolVersion;
+        uint8_t id[NUM_BYTES_RFC4122_UUID];
+        int64_t dataVersion;
+        uint32_t numItems;
+        uint32_t numSections;
+    };
+
+    struct Section {
+        uint32_t type;
+        uint32_t reserved;
+        uint64_t offset; // from the start of the file
+        uint64_t size;
+    };
+
+    // whether the data starts like a snapshot, which can be the first few bytes of a file
+    static bool isSnapshot(const QByteArray& data);
+
+    static bool readHeaderFromFile(const QString& path, Header& header);
+
+    // rewrite the id and data version of an existing snapshot file in place
+    static bool writeVersionInfoToFile(const QString& path, const QUuid& id, int64_t dataVersion);
+};
+
+class OctreeSnapshotWriter {
+public:
+    OctreeSnapshotWriter(PacketType dataPacketType, const QUuid& id, int64_t dataVersion);
+
+    void setNumItems(uint32_t numItems) { _numItems = numItems; }
+    void addSection(uint32_t type, QByteArray data);
+
+    bool write(QIODevice& device) const;
+    bool writeToFile(const QString& path) const;
+
+private:
+    PacketType _dataPacketType;
+    QUuid _id;
+    int64_t _dataVersion;
+    uint32_t _numItems { 0 };
+
+    std::vector<std::pair<uint32_t, QByteArray>> _sections;
+};
+
+class OctreeSnapshotReader {
+public:
+    // the data must outlive the reader, typically a mapped file
+    OctreeSnapshotReader(const char* data, uint64_t size);
+
+    bool isValid() const { return _isValid; }
+
+    uint32_t getFormatVersion() const { return _header.formatVersion; }
+    PacketType getDataPacketType() const { return (PacketType)_header.dataPacketType; }
+    PacketVersion getProtocolVersion() const { return (PacketVersion)_header.protocolVersion; }
+    QUuid getID() const;
+    int64_t getDataVersion() const { return _header.dataVersion; }
+    uint32_t getNumItems() const { return _header.numItems; }
+
+    // returns nullptr if the snapshot has no section of that type
+    const char* getSection(uint32_t type, uint64_t& size) const;
+
+private:
+    const char* _data;
+    bool _isValid { false };
+
+    OctreeSnapshot::Header _header;
+    std::vector<OctreeSnapshot::Section> _sections;
+};
+
+// Section of deduplicated UTF-8 strings, referenced by index from other sections
+//   Layout: uint32 count, uint32 offsets[count + 1] into the string bytes, then the string bytes.
+//   Index 0 is always the empty string.
+class OctreeSnapshotStringTableWriter {
+public:
+    OctreeSnapshotStringTableWriter();
+
+    uint32_t insert(const QString& string);
+
+    QByteArray toByteArray() const;
+
+private:
+    QHash<QString, uint32_t> _indices;
+    std::vector<uint32_t> _offsets;
+    QByteArray _strings;
+};
+
+class OctreeSnapshotStringTableReader {
+public:
+    bool init(const char* data, uint64_t size);
+
+    uint32_t getNumStrings() const { return _numStrings; }
+
+    // returns false if the index or its offsets are out of range
+    bool getString(uint32_t index, QString& string) const;
+
+private:
+    uint32_t _numStrings { 0 };
+    const uint32_t* _offsets { nullptr };
+    const char* _strings { nullptr };
+    uint64_t _stringsSize { 0 };
+};
+
+#endif // hifi_OctreeSnapshot_h
@@ -316,7 +316,7 @@ const btCollisionShape* EntityMotionState::computeNewShape() {
     ShapeInfo shapeInfo;
     assert(entityTreeIsLocked());
     _entity->computeShapeInfo(shapeInfo);
-    return getShapeManager()->getShape(shapeInfo);
+    return requestShape(shapeInfo);
 }
 
 void EntityMotionState::setShape(const btCollisionShape* shape) {
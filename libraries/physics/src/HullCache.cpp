@@ -0,0 +1,218 @@
+//
+//  HullCache.cpp
+//  libraries/physics/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HullCache.h"
+
+#include <cstring>
+#include <vector>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
+#include <NumericalConstants.h>
+
+#include "PhysicsLogging.h"
+
+const uint32_t HullCache::CURRENT_VERSION = 1;
+
+static const std::string HULL_EXT { "hull" };
+static const size_t MAX_HULL_CACHE_SIZE { MB_TO_BYTES(512) };
+
+//    version [4 bytes]
+//    hash of the ShapeInfo [8 bytes]
+//    whether the hulls are in a compound [1 byte]
+//    number of hulls [4 bytes]
+static const size_t HEADER_SIZE = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint32_t);
+
+//    margin [4 bytes]
+//    number of points [4 bytes]
+//    points [12 bytes each]
+static const size_t HULL_HEADER_SIZE = sizeof(float) + sizeof(uint32_t);
+static const size_t POINT_SIZE = 3 * sizeof(float);
+
+class HullData {
+public:
+    float margin;
+    std::vector<float> points;
+};
+
+// the hash of a compound covers its url and number of hulls rather than its points, which change with the model at
+// that url, so the key has a digest of the points too
+static cache::FileCache::Key getKey(const ShapeInfo& info) {
+    QCryptographicHash digest(QCryptographicHash::Sha1);
+    for (const auto& points : info.getPointCollection()) {
+        digest.addData(reinterpret_cast<const char*>(points.constData()), points.size() * (int)sizeof(glm::vec3));
+    }
+    return (QString::number(info.getHash().getHash64(), 16) + "-" + digest.result().toHex()).toStdString();
+}
+
+// find the hulls of a shape as built by the ShapeFactory, without any offset, returning false if it has something else
+static bool getHulls(const btCollisionShape* shape, std::vector<const btConvexHullShape*>& hulls, bool& isCompound) {
+    if (shape->getShapeType() == (int)CONVEX_HULL_SHAPE_PROXYTYPE) {
+        isCompound = false;
+        hulls.push_back(static_cast<const btConvexHullShape*>(shape));
+        return true;
+    }
+    if (shape->getShapeType() != (int)COMPOUND_SHAPE_PROXYTYPE) {
+        return false;
+    }
+    isCompound = true;
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    int32_t numChildShapes = compound->getNumChildShapes();
+    hulls.reserve(numChildShapes);
+    for (int32_t i = 0; i < numChildShapes; ++i) {
+        const btCollisionShape* child = compound->getChildShape(i);
+        const btTransform& transform = compound->getChildTransform(i);
+        if (!child || child->getShapeType() != (int)CONVEX_HULL_SHAPE_PROXYTYPE
+                || transform.getOrigin() != btVector3(0.0f, 0.0f, 0.0f)
+                || transform.getRotation() != btQuaternion::getIdentity()) {
+            return false;
+        }
+        hulls.push_back(static_cast<const btConvexHullShape*>(child));
+    }
+    return true;
+}
+
+HullCache::HullCache(const std::string& dirname) :
+    FileCache(dirname, HULL_EXT) {
+    setMaxSize(MAX_HULL_CACHE_SIZE);
+}
+
+bool HullCache::isCacheable(ShapeType type) {
+    return type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_HULL || type == SHAPE_TYPE_SIMPLE_COMPOUND;
+}
+
+btCollisionShape* HullCache::loadShape(const ShapeInfo& info) {
+    if (!isCacheable(info.getType())) {
+        return nullptr;
+    }
+    auto file = getFile(getKey(info));
+    if (!file) {
+        return nullptr;
+    }
+    QFile hullFile(QString::fromStdString(file->getFilepath()));
+    if (!hullFile.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    QByteArray data = hullFile.readAll();
+    if ((size_t)data.size() < HEADER_SIZE) {
+        return nullptr;
+    }
+    const char* dataAt = data.constData();
+    const char* dataEnd = dataAt + data.size();
+
+    uint32_t version;
+    memcpy(&version, dataAt, sizeof(version));
+    dataAt += sizeof(version);
+    uint64_t hash;
+    memcpy(&hash, dataAt, sizeof(hash));
+    dataAt += sizeof(hash);
+    bool isCompound = *dataAt++ != 0;
+    uint32_t numHulls;
+    memcpy(&numHulls, dataAt, sizeof(numHulls));
+    dataAt += sizeof(numHulls);
+    if (version != CURRENT_VERSION || hash != info.getHash().getHash64() || (!isCompound && numHulls != 1)) {
+        return nullptr;
+    }
+
+    // read all of the hulls before building any, so that nothing is left to delete if the file is bad
+    std::vector<HullData> hulls;
+    for (uint32_t i = 0; i < numHulls; ++i) {
+        if ((size_t)(dataEnd - dataAt) < HULL_HEADER_SIZE) {
+            return nullptr;
+        }
+        HullData hull;
+        memcpy(&hull.margin, dataAt, sizeof(hull.margin));
+        dataAt += sizeof(hull.margin);
+        uint32_t numPoints;
+        memcpy(&numPoints, dataAt, sizeof(numPoints));
+        dataAt += sizeof(numPoints);
+        if (numPoints == 0 || (size_t)(dataEnd - dataAt) / POINT_SIZE < numPoints) {
+            return nullptr;
+        }
+        hull.points.resize(3 * numPoints);
+        memcpy(hull.points.data(), dataAt, numPoints * POINT_SIZE);
+        dataAt += numPoints * POINT_SIZE;
+        hulls.push_back(std::move(hull));
+    }
+    if (dataAt != dataEnd) {
+        return nullptr;
+    }
+
+    btCompoundShape* compound = isCompound ? new btCompoundShape() : nullptr;
+    btConvexHullShape* hullShape = nullptr;
+    btTransform identity;
+    identity.setIdentity();
+    for (const auto& hull : hulls) {
+        hullShape = new btConvexHullShape();
+        hullShape->setMargin(hull.margin);
+        for (size_t j = 0; j < hull.points.size(); j += 3) {
+            hullShape->addPoint(btVector3(hull.points[j], hull.points[j + 1], hull.points[j + 2]), false);
+        }
+        hullShape->recalcLocalAabb();
+        if (compound) {
+            compound->addChildShape(identity, hullShape);
+        }
+    }
+    if (compound) {
+        return compound;
+    }
+    return hullShape;
+}
+
+void HullCache::saveShape(const ShapeInfo& info, const btCollisionShape* shape) {
+    if (!shape || !isCacheable(info.getType())) {
+        return;
+    }
+    std::vector<const btConvexHullShape*> hulls;
+    bool isCompound = false;
+    if (!getHulls(shape, hulls, isCompound)) {
+        return;
+    }
+
+    size_t length = HEADER_SIZE;
+    for (auto hull : hulls) {
+        length += HULL_HEADER_SIZE + (size_t)hull->getNumPoints() * POINT_SIZE;
+    }
+    std::vector<char> data(length);
+    char* dataAt = data.data();
+
+    uint32_t version = CURRENT_VERSION;
+    memcpy(dataAt, &version, sizeof(version));
+    dataAt += sizeof(version);
+    uint64_t hash = info.getHash().getHash64();
+    memcpy(dataAt, &hash, sizeof(hash));
+    dataAt += sizeof(hash);
+    *dataAt++ = isCompound ? 1 : 0;
+    uint32_t numHulls = (uint32_t)hulls.size();
+    memcpy(dataAt, &numHulls, sizeof(numHulls));
+    dataAt += sizeof(numHulls);
+
+    for (auto hull : hulls) {
+        float margin = (float)hull->getMargin();
+        memcpy(dataAt, &margin, sizeof(margin));
+        dataAt += sizeof(margin);
+        uint32_t numPoints = (uint32_t)hull->getNumPoints();
+        memcpy(dataAt, &numPoints, sizeof(numPoints));
+        dataAt += sizeof(numPoints);
+        const btVector3* points = hull->getUnscaledPoints();
+        for (uint32_t j = 0; j < numPoints; ++j) {
+            float point[3] = { (float)points[j].getX(), (float)points[j].getY(), (float)points[j].getZ() };
+            memcpy(dataAt, point, sizeof(point));
+            dataAt += sizeof(point);
+        }
+    }
+
+    // a file from an older version is overwritten, one of the current version is the same hulls
+    if (!writeFile(data.data(), Metadata(getKey(info), length), true)) {
+        qCDebug(physics) << "HullCache failed to save the hulls of a shape of type" << info.getType();
+    }
+}
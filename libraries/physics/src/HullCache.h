@@ -0,0 +1,42 @@
+//
+//  HullCache.h
+//  libraries/physics/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HullCache_h
+#define hifi_HullCache_h
+
+#include <btBulletDynamicsCommon.h>
+
+#include <ShapeInfo.h>
+#include <shared/FileCache.h>
+
+// The HullCache keeps the convex hulls built for shapes on disk, keyed by the hash of their ShapeInfo and a digest of
+// its points, so that the hulls of a model are built once rather than in every session.  Only the hull shapes are
+// cached, as they are built before any offset is applied, and each file carries its own version so that stale files
+// are rebuilt and overwritten.
+class HullCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to how hulls are built or serialized, this value should be incremented.
+    static const uint32_t CURRENT_VERSION;
+
+    HullCache(const std::string& dirname);
+
+    static bool isCacheable(ShapeType type);
+
+    // \return the hull or compound of hulls saved for the info, or nullptr if there isn't one
+    btCollisionShape* loadShape(const ShapeInfo& info);
+
+    // save a hull or compound of hulls built for the info
+    void saveShape(const ShapeInfo& info, const btCollisionShape* shape);
+};
+
+#endif // hifi_HullCache_h
@@ -71,6 +71,9 @@ ObjectMotionState::ObjectMotionState(const btCollisionShape* shape) :
 
 ObjectMotionState::~ObjectMotionState() {
     assert(!_body);
+    if (!_pendingShapeKey.isNull()) {
+        getShapeManager()->releasePendingShape(_pendingShapeKey);
+    }
     setShape(nullptr);
 }
 
@@ -202,6 +205,22 @@ void ObjectMotionState::setShape(const btCollisionShape* shape) {
     }
 }
 
+// protected
+const btCollisionShape* ObjectMotionState::requestShape(const ShapeInfo& info) {
+    HashKey key = info.getHash();
+    if (!_pendingShapeKey.isNull() && !_pendingShapeKey.equals(key)) {
+        // the shape changed again before the last one was done
+        getShapeManager()->releasePendingShape(_pendingShapeKey);
+    }
+    const btCollisionShape* shape = getShapeManager()->getShape(info, _pendingShapeKey.equals(key));
+    if (!shape && getShapeManager()->isShapePending(key)) {
+        _pendingShapeKey = key;
+    } else {
+        _pendingShapeKey.clear();
+    }
+    return shape;
+}
+
 void ObjectMotionState::handleEasyChanges(uint32_t& flags) {
     assert(_body && _shape);
     if (flags & Simulation::DIRTY_POSITION) {
@@ -291,6 +310,10 @@ bool ObjectMotionState::handleHardAndEasyChanges(uint32_t& flags, PhysicsEngine*
             return false;
         }
         const btCollisionShape* newShape = computeNewShape();
+        if (!newShape && !_pendingShapeKey.isNull()) {
+            // the new shape is still being built --> keep the old one and all the flags, and try again later
+            return false;
+        }
         if (!newShape) {
             qCDebug(physics) << "Warning: failed to generate new shape!";
             // failed to generate new shape! --> keep old shape and remove shape-change flag
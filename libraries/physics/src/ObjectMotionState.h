@@ -171,6 +171,7 @@ public:
 protected:
     virtual bool isReadyToComputeShape() const = 0;
     virtual const btCollisionShape* computeNewShape() = 0;
+    const btCollisionShape* requestShape(const ShapeInfo& info); // for computeNewShape(), remembers a pending shape
     virtual void setMotionType(PhysicsMotionType motionType);
     void updateCCDConfiguration();
 
@@ -181,6 +182,7 @@ protected:
     PhysicsMotionType _motionType { MOTION_TYPE_STATIC }; // type of motion: KINEMATIC, DYNAMIC, or STATIC
 
     const btCollisionShape* _shape;
+    HashKey _pendingShapeKey; // of the new shape while it is built in the background
     btRigidBody* _body { nullptr };
     float _density { 1.0f };
 
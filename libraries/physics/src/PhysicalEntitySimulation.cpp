@@ -61,7 +61,9 @@ void PhysicalEntitySimulation::addEntityInternal(EntityItemPointer entity) {
 void PhysicalEntitySimulation::removeEntityInternal(EntityItemPointer entity) {
     if (entity->isSimulated()) {
         EntitySimulation::removeEntityInternal(entity);
-        _entitiesToAddToPhysics.remove(entity);
+        if (_entitiesToAddToPhysics.remove(entity)) {
+            releasePendingShape(entity);
+        }
 
         EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
         if (motionState) {
@@ -169,6 +171,8 @@ void PhysicalEntitySimulation::clearEntitiesInternal() {
     // clear all other lists specific to this derived class
     _entitiesToRemoveFromPhysics.clear();
     _entitiesToAddToPhysics.clear();
+    _pendingShapeKeys.clear();
+    _pendingShapeKeysToRelease.clear();
     _incomingChanges.clear();
 }
 
@@ -215,23 +219,47 @@ void PhysicalEntitySimulation::deleteObjectsRemovedFromPhysics() {
     _objectsToDelete.clear();
 }
 
+// give up on any shape still being built for an entity that won't be added to physics after all
+void PhysicalEntitySimulation::releasePendingShape(const EntityItemPointer& entity) {
+    auto itr = _pendingShapeKeys.find(entity);
+    if (itr != _pendingShapeKeys.end()) {
+        // released with the next entities added, on the thread that asks for shapes
+        _pendingShapeKeysToRelease.push_back(itr.value());
+        _pendingShapeKeys.erase(itr);
+    }
+}
+
 void PhysicalEntitySimulation::getObjectsToAddToPhysics(VectorOfMotionStates& result) {
     result.clear();
     QMutexLocker lock(&_mutex);
+    PROFILE_RANGE_EX(simulation_physics, "AddEntities", 0x00000000, (uint64_t)_entitiesToAddToPhysics.size());
+    ShapeManager* shapeManager = ObjectMotionState::getShapeManager();
+    for (auto& key : _pendingShapeKeysToRelease) {
+        shapeManager->releasePendingShape(key);
+    }
+    _pendingShapeKeysToRelease.clear();
+
+    uint64_t deadline = usecTimestampNow() + _addToPhysicsBudget;
     SetOfEntities::iterator entityItr = _entitiesToAddToPhysics.begin();
     while (entityItr != _entitiesToAddToPhysics.end()) {
         EntityItemPointer entity = (*entityItr);
         assert(!entity->getPhysicsInfo());
         if (entity->isDead()) {
+            releasePendingShape(entity);
             prepareEntityForDelete(entity);
             entityItr = _entitiesToAddToPhysics.erase(entityItr);
         } else if (!entity->shouldBePhysical()) {
             // this entity should no longer be on the internal _entitiesToAddToPhysics
+            releasePendingShape(entity);
             entityItr = _entitiesToAddToPhysics.erase(entityItr);
             if (entity->isMovingRelativeToParent()) {
                 _simpleKinematicEntities.insert(entity);
             }
         } else if (entity->isReadyToComputeShape()) {
+            if (!result.empty() && usecTimestampNow() > deadline) {
+                // the rest wait for the next frame, rather than make this one hitch while a domain is loading
+                break;
+            }
             ShapeInfo shapeInfo;
             entity->computeShapeInfo(shapeInfo);
             int numPoints = shapeInfo.getLargestSubshapePointCount();
@@ -242,7 +270,23 @@ void PhysicalEntitySimulation::getObjectsToAddToPhysics(VectorOfMotionStates& re
                         << "at" << entity->getWorldPosition() << " will be reduced";
                 }
             }
-            btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+
+            // as in ObjectMotionState::requestShape(), the entity waits for the shape it asked for last
+            HashKey key = shapeInfo.getHash();
+            auto pendingItr = _pendingShapeKeys.find(entity);
+            bool isWaiting = false;
+            if (pendingItr != _pendingShapeKeys.end()) {
+                isWaiting = pendingItr.value().equals(key);
+                if (!isWaiting) {
+                    // the shape changed before the last one was done
+                    shapeManager->releasePendingShape(pendingItr.value());
+                }
+                _pendingShapeKeys.erase(pendingItr);
+            }
+            btCollisionShape* shape = const_cast<btCollisionShape*>(shapeManager->getShape(shapeInfo, isWaiting));
+            if (!shape && shapeManager->isShapePending(key)) {
+                _pendingShapeKeys[entity] = key;
+            }
             if (shape) {
                 EntityMotionState* motionState = new EntityMotionState(shape, entity);
                 entity->setPhysicsInfo(static_cast<void*>(motionState));
@@ -269,6 +313,7 @@ void PhysicalEntitySimulation::setObjectsToChange(const VectorOfMotionStates& ob
 void PhysicalEntitySimulation::getObjectsToChange(VectorOfMotionStates& result) {
     result.clear();
     QMutexLocker lock(&_mutex);
+    result.reserve(_incomingChanges.size());
     for (auto stateItr : _incomingChanges) {
         EntityMotionState* motionState = &(*stateItr);
         result.push_back(motionState);
@@ -276,6 +321,16 @@ void PhysicalEntitySimulation::getObjectsToChange(VectorOfMotionStates& result)
     _incomingChanges.clear();
 }
 
+int PhysicalEntitySimulation::getNumEntitiesToAddToPhysics() {
+    QMutexLocker lock(&_mutex);
+    return _entitiesToAddToPhysics.size();
+}
+
+int PhysicalEntitySimulation::getNumObjectsToChange() {
+    QMutexLocker lock(&_mutex);
+    return _incomingChanges.size();
+}
+
 void PhysicalEntitySimulation::handleDeactivatedMotionStates(const VectorOfMotionStates& motionStates) {
     for (auto stateItr : motionStates) {
         ObjectMotionState* state = &(*stateItr);
@@ -293,6 +348,7 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
     PROFILE_RANGE_EX(simulation_physics, "ChangedEntities", 0x00000000, (uint64_t)motionStates.size());
     QMutexLocker lock(&_mutex);
 
+    _entitiesToSort.reserve(_entitiesToSort.size() + (int)motionStates.size());
     for (auto stateItr : motionStates) {
         ObjectMotionState* state = &(*stateItr);
         assert(state);
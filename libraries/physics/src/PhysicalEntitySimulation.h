@@ -13,12 +13,15 @@
 #define hifi_PhysicalEntitySimulation_h
 
 #include <stdint.h>
+#include <vector>
 
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 #include <EntityItem.h>
 #include <EntitySimulation.h>
+#include <HashKey.h>
+#include <NumericalConstants.h>
 
 #include "PhysicsEngine.h"
 #include "EntityMotionState.h"
@@ -27,6 +30,9 @@ class PhysicalEntitySimulation;
 using PhysicalEntitySimulationPointer = std::shared_ptr<PhysicalEntitySimulation>;
 using SetOfEntityMotionStates = QSet<EntityMotionState*>;
 
+// the longest getObjectsToAddToPhysics spends making the shapes of the entities waiting for them, by default
+const uint64_t DEFAULT_ADD_TO_PHYSICS_BUDGET = 2 * USECS_PER_MSEC;
+
 class VectorOfEntityMotionStates: public std::vector<EntityMotionState*> {
 public:
     void remove(uint32_t index) {
@@ -64,6 +70,7 @@ protected: // only called by EntitySimulation
 
     void removeOwnershipData(EntityMotionState* motionState);
     void clearOwnershipData();
+    void releasePendingShape(const EntityItemPointer& entity);
 
 public:
     virtual void prepareEntityForDelete(EntityItemPointer entity) override;
@@ -71,10 +78,18 @@ public:
     const VectorOfMotionStates& getObjectsToRemoveFromPhysics();
     void deleteObjectsRemovedFromPhysics();
 
+    // Make the motion states of the entities waiting to be added to physics, until their shapes have taken longer than
+    // the budget to make, leaving the rest for the next frame.  At least one is made each time if any can be.
     void getObjectsToAddToPhysics(VectorOfMotionStates& result);
     void setObjectsToChange(const VectorOfMotionStates& objectsToChange);
     void getObjectsToChange(VectorOfMotionStates& result);
 
+    void setAddToPhysicsBudget(uint64_t usecs) { _addToPhysicsBudget = usecs; }
+
+    // the depths of the queues of entities waiting to be added to physics and of motion states waiting for changes
+    int getNumEntitiesToAddToPhysics();
+    int getNumObjectsToChange();
+
     void handleDeactivatedMotionStates(const VectorOfMotionStates& motionStates);
     void handleChangedMotionStates(const VectorOfMotionStates& motionStates);
     void handleCollisionEvents(const CollisionEvents& collisionEvents);
@@ -89,6 +104,8 @@ public:
 private:
     SetOfEntities _entitiesToAddToPhysics;
     SetOfEntities _entitiesToRemoveFromPhysics;
+    QHash<EntityItemPointer, HashKey> _pendingShapeKeys; // of the shapes built for the entities waiting to be added
+    std::vector<HashKey> _pendingShapeKeysToRelease; // of entities no longer waiting, released with the shapes
 
     VectorOfMotionStates _objectsToDelete;
 
@@ -104,6 +121,7 @@ private:
     VectorOfEntityMotionStates _bids;
     uint64_t _nextBidExpiry;
     uint32_t _lastStepSendPackets { 0 };
+    uint64_t _addToPhysicsBudget { DEFAULT_ADD_TO_PHYSICS_BUDGET };
 };
 
 
@@ -12,6 +12,7 @@
 #include "PhysicsEngine.h"
 
 #include <functional>
+#include <unordered_set>
 
 #include <QFile>
 
@@ -50,6 +51,7 @@ void PhysicsEngine::init() {
         _broadphaseFilter = new btDbvtBroadphase();
         _constraintSolver = new btSequentialImpulseConstraintSolver;
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        _dynamicsWorld->setNumSolverThreads(_numSolverThreads);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -177,9 +179,7 @@ QList<EntityDynamicPointer> PhysicsEngine::removeDynamicsForBody(btRigidBody* bo
 
 void PhysicsEngine::removeObjects(const VectorOfMotionStates& objects) {
     // bump and prune contacts for all objects in the list
-    for (auto object : objects) {
-        bumpAndPruneContacts(object);
-    }
+    bumpAndPruneContacts(objects);
 
     if (_activeStaticBodies.size() > 0) {
         // _activeStaticBodies was not cleared last frame.
@@ -286,7 +286,9 @@ void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
 }
 
 void PhysicsEngine::stepSimulation() {
+#ifndef BT_NO_PROFILE
     CProfileManager::Reset();
+#endif
     BT_PROFILE("stepSimulation");
     // NOTE: the grand order of operations is:
     // (1) pull incoming changes
@@ -344,6 +346,9 @@ void PhysicsEngine::stepSimulation() {
     }
 }
 
+// Bullet can be built without its profiler (BULLET_NO_PROFILE) for the island solver threads, in which case its timings
+// aren't kept and there are none to harvest, print or dump: only the stepPhysics timer of the caller remains
+#ifndef BT_NO_PROFILE
 class CProfileOperator {
 public:
     CProfileOperator() {}
@@ -409,7 +414,10 @@ protected:
     QFile _file;
 };
 
+#endif // BT_NO_PROFILE
+
 void PhysicsEngine::harvestPerformanceStats() {
+#ifndef BT_NO_PROFILE
     // unfortunately the full context names get too long for our stats presentation format
     //QString contextName = PerformanceTimer::getContextName(); // TODO: how to show full context name?
     QString contextName("...");
@@ -428,9 +436,13 @@ void PhysicsEngine::harvestPerformanceStats() {
             itr->Next();
         }
     }
+#endif // BT_NO_PROFILE
 }
 
 void PhysicsEngine::printPerformanceStatsToFile(const QString& filename) {
+#ifdef BT_NO_PROFILE
+    qCDebug(physics) << "unable to save stepSimulation() stats to" << filename << "since Bullet is built without its profiler";
+#else
     CProfileIterator* itr = CProfileManager::Get_Iterator();
     if (itr) {
         // hunt for stepSimulation context
@@ -445,6 +457,7 @@ void PhysicsEngine::printPerformanceStatsToFile(const QString& filename) {
             itr->Next();
         }
     }
+#endif // BT_NO_PROFILE
 }
 
 void PhysicsEngine::doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB) {
@@ -642,12 +655,16 @@ const VectorOfMotionStates& PhysicsEngine::getChangedMotionStates() {
 void PhysicsEngine::dumpStatsIfNecessary() {
     if (_dumpNextStats) {
         _dumpNextStats = false;
+#ifndef BT_NO_PROFILE
         CProfileManager::Increment_Frame_Counter();
+#endif
         if (_saveNextStats) {
             _saveNextStats = false;
             printPerformanceStatsToFile(_statsFilename);
         }
+#ifndef BT_NO_PROFILE
         CProfileManager::dumpAll();
+#endif
     }
 }
 
@@ -666,6 +683,17 @@ void PhysicsEngine::saveNextPhysicsStats(QString filename) {
 // CF_DISABLE_VISUALIZE_OBJECT = 32, //disable debug drawing
 // CF_DISABLE_SPU_COLLISION_PROCESSING = 64//disable parallel/SPU processing
 
+// wake an object that touched one being removed, and flag it for simulation ownership by the local simulation
+static void bumpTouchingObject(const btCollisionObject* object) {
+    if (!object->isStaticOrKinematicObject()) {
+        ObjectMotionState* motionState = static_cast<ObjectMotionState*>(object->getUserPointer());
+        if (motionState) {
+            motionState->bump(VOLUNTEER_SIMULATION_PRIORITY);
+            object->setActivationState(ACTIVE_TAG);
+        }
+    }
+}
+
 void PhysicsEngine::bumpAndPruneContacts(ObjectMotionState* motionState) {
     // Find all objects that touch the object corresponding to motionState and flag the other objects
     // for simulation ownership by the local simulation.
@@ -680,27 +708,62 @@ void PhysicsEngine::bumpAndPruneContacts(ObjectMotionState* motionState) {
             const btCollisionObject* objectA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
             const btCollisionObject* objectB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
             if (objectB == object) {
-                if (!objectA->isStaticOrKinematicObject()) {
-                    ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(objectA->getUserPointer());
-                    if (motionStateA) {
-                        motionStateA->bump(VOLUNTEER_SIMULATION_PRIORITY);
-                        objectA->setActivationState(ACTIVE_TAG);
-                    }
-                }
+                bumpTouchingObject(objectA);
             } else if (objectA == object) {
-                if (!objectB->isStaticOrKinematicObject()) {
-                    ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(objectB->getUserPointer());
-                    if (motionStateB) {
-                        motionStateB->bump(VOLUNTEER_SIMULATION_PRIORITY);
-                        objectB->setActivationState(ACTIVE_TAG);
-                    }
-                }
+                bumpTouchingObject(objectB);
             }
         }
     }
     removeContacts(motionState);
 }
 
+void PhysicsEngine::bumpAndPruneContacts(const VectorOfMotionStates& motionStates) {
+    if (motionStates.size() < 2) {
+        for (auto motionState : motionStates) {
+            bumpAndPruneContacts(motionState);
+        }
+        return;
+    }
+
+    // as above, but in one pass over the manifolds and contacts for all of the objects rather than one for each,
+    // for when many are removed at once
+    std::unordered_set<const btCollisionObject*> objects;
+    std::unordered_set<void*> states;
+    objects.reserve(motionStates.size());
+    states.reserve(motionStates.size());
+    for (auto motionState : motionStates) {
+        assert(motionState);
+        if (motionState->getRigidBody()) {
+            objects.insert(motionState->getRigidBody());
+        }
+        states.insert(motionState);
+    }
+
+    int numManifolds = _collisionDispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; ++i) {
+        btPersistentManifold* contactManifold =  _collisionDispatcher->getManifoldByIndexInternal(i);
+        if (contactManifold->getNumContacts() > 0) {
+            const btCollisionObject* objectA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
+            const btCollisionObject* objectB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
+            if (objects.find(objectB) != objects.end()) {
+                bumpTouchingObject(objectA);
+            }
+            if (objects.find(objectA) != objects.end()) {
+                bumpTouchingObject(objectB);
+            }
+        }
+    }
+
+    ContactMap::iterator contactItr = _contactMap.begin();
+    while (contactItr != _contactMap.end()) {
+        if (states.find(contactItr->first._a) != states.end() || states.find(contactItr->first._b) != states.end()) {
+            contactItr = _contactMap.erase(contactItr);
+        } else {
+            ++contactItr;
+        }
+    }
+}
+
 void PhysicsEngine::setCharacterController(CharacterController* character) {
     if (_myAvatarController != character) {
         if (_myAvatarController) {
@@ -840,3 +903,9 @@ void PhysicsEngine::setShowBulletConstraintLimits(bool value) {
     }
 }
 
+void PhysicsEngine::setNumSolverThreads(int numThreads) {
+    _numSolverThreads = numThreads;
+    if (_dynamicsWorld) {
+        _dynamicsWorld->setNumSolverThreads(numThreads);
+    }
+}
@@ -103,12 +103,16 @@ public:
     void setShowBulletConstraints(bool value);
     void setShowBulletConstraintLimits(bool value);
 
+    /// \brief solve the simulation islands on up to this many threads, where Bullet allows it
+    void setNumSolverThreads(int numThreads);
+
 private:
     QList<EntityDynamicPointer> removeDynamicsForBody(btRigidBody* body);
     void addObjectToDynamicsWorld(ObjectMotionState* motionState);
 
     /// \brief bump any objects that touch this one, then remove contact info
     void bumpAndPruneContacts(ObjectMotionState* motionState);
+    void bumpAndPruneContacts(const VectorOfMotionStates& motionStates);
 
     void removeContacts(ObjectMotionState* motionState);
 
@@ -136,6 +140,7 @@ private:
 
     uint32_t _numContactFrames = 0;
     uint32_t _numSubsteps;
+    int _numSolverThreads { 1 };
 
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
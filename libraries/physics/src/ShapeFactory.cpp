@@ -16,6 +16,7 @@
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "HullCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -270,9 +271,14 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, HullCache* hullCache) {
     btCollisionShape* shape = nullptr;
-    int type = info.getType();
+    bool isCacheable = hullCache && HullCache::isCacheable(info.getType());
+    if (isCacheable) {
+        shape = hullCache->loadShape(info);
+    }
+    bool isLoaded = shape != nullptr;
+    int type = isLoaded ? SHAPE_TYPE_NONE : info.getType(); // nothing to build if the hulls were loaded
     switch(type) {
         case SHAPE_TYPE_BOX: {
             shape = new btBoxShape(glmToBullet(info.getHalfExtents()));
@@ -424,6 +430,10 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         break;
     }
     if (shape) {
+        if (isCacheable && !isLoaded) {
+            // the hulls are saved before the offset is applied, as the offset is cheap to apply again
+            hullCache->saveShape(info, shape);
+        }
         if (glm::length2(info.getOffset()) > MIN_SHAPE_OFFSET * MIN_SHAPE_OFFSET) {
             // we need to apply an offset
             btTransform offset;
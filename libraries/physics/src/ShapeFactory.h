@@ -17,10 +17,14 @@
 
 #include <ShapeInfo.h>
 
+class HullCache;
+
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
+// It is safe to create shapes on several threads at once.
 
 namespace ShapeFactory {
-    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
+    // the hulls of hull shapes are loaded from the hullCache when they are in it, and saved to it when they are built
+    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info, HullCache* hullCache = nullptr);
     void deleteShape(const btCollisionShape* shape);
 };
 
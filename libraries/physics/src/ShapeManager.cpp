@@ -11,16 +11,62 @@
 
 #include "ShapeManager.h"
 
+#include <algorithm>
+
 #include <glm/gtx/norm.hpp>
 
 #include <QDebug>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 
+#include "HullCache.h"
 #include "ShapeFactory.h"
 
+// shapes are built in the background on at most this many threads, to leave the rest to rendering and simulation
+static const int MAX_SHAPE_BUILD_THREADS = 2;
+
+// a shape that is done but not asked for in this long is deleted, in case whoever waited for it forgot to release it
+static const uint64_t MAX_UNCLAIMED_PENDING_SHAPE_USECS = 10 * USECS_PER_SECOND;
+
+static bool isExpensiveToBuild(ShapeType type) {
+    return type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_HULL || type == SHAPE_TYPE_SIMPLE_COMPOUND
+        || type == SHAPE_TYPE_STATIC_MESH;
+}
+
+class ShapeManager::BuildShapeTask : public QRunnable {
+public:
+    BuildShapeTask(const PendingShapePointer& pendingShape, const std::shared_ptr<HullCache>& hullCache) :
+        _pendingShape(pendingShape), _hullCache(hullCache) {}
+
+    void run() override {
+        _pendingShape->shape = ShapeFactory::createShapeFromInfo(_pendingShape->info, _hullCache.get());
+        _pendingShape->doneTime = usecTimestampNow();
+        _pendingShape->done = true;
+    }
+
+private:
+    PendingShapePointer _pendingShape;
+    std::shared_ptr<HullCache> _hullCache;
+};
+
 ShapeManager::ShapeManager() {
 }
 
 ShapeManager::~ShapeManager() {
+    if (_threadPool) {
+        _threadPool->waitForDone();
+    }
+    for (auto& entry : _pendingShapes) {
+        if (entry.second->shape) {
+            ShapeFactory::deleteShape(entry.second->shape);
+        }
+    }
+    _pendingShapes.clear();
+
     int numShapes = _shapeMap.size();
     for (int i = 0; i < numShapes; ++i) {
         ShapeReference* shapeRef = _shapeMap.getAtIndex(i);
@@ -29,7 +75,7 @@ ShapeManager::~ShapeManager() {
     _shapeMap.clear();
 }
 
-const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info, bool isWaiting) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
     }
@@ -39,13 +85,50 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         shapeRef->refCount++;
         return shapeRef->shape;
     }
-    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    if (_buildShapesInBackground && isExpensiveToBuild(info.getType())) {
+        return getShapeInBackground(info, key, isWaiting);
+    }
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info, _hullCache.get());
     if (shape) {
-        ShapeReference newRef;
-        newRef.refCount = 1;
-        newRef.shape = shape;
-        newRef.key = key;
-        _shapeMap.insert(key, newRef);
+        addShape(key, shape);
+    }
+    return shape;
+}
+
+// private helper method
+void ShapeManager::addShape(const HashKey& key, const btCollisionShape* shape) {
+    ShapeReference newRef;
+    newRef.refCount = 1;
+    newRef.shape = shape;
+    newRef.key = key;
+    _shapeMap.insert(key, newRef);
+}
+
+// private helper method
+const btCollisionShape* ShapeManager::getShapeInBackground(const ShapeInfo& info, const HashKey& key, bool isWaiting) {
+    auto itr = _pendingShapes.find(key.getHash64());
+    if (itr == _pendingShapes.end()) {
+        // new shapes are requested as the old ones are abandoned, so this is a good time to drop those
+        collectPendingShapes();
+        if (!_threadPool) {
+            _threadPool.reset(new QThreadPool());
+            _threadPool->setMaxThreadCount(std::max(1, std::min(MAX_SHAPE_BUILD_THREADS, QThread::idealThreadCount() - 1)));
+        }
+        auto pendingShape = std::make_shared<PendingShape>(info);
+        _pendingShapes[key.getHash64()] = pendingShape;
+        _threadPool->start(new BuildShapeTask(pendingShape, _hullCache));
+        return nullptr;
+    }
+    if (!isWaiting) {
+        ++itr->second->numWaiting;
+    }
+    if (!itr->second->done) {
+        return nullptr;
+    }
+    const btCollisionShape* shape = itr->second->shape;
+    _pendingShapes.erase(itr);
+    if (shape) {
+        addShape(key, shape);
     }
     return shape;
 }
@@ -86,7 +169,41 @@ bool ShapeManager::releaseShape(const btCollisionShape* shape) {
     return false;
 }
 
+void ShapeManager::releasePendingShape(const HashKey& key) {
+    auto itr = _pendingShapes.find(key.getHash64());
+    if (itr == _pendingShapes.end() || --itr->second->numWaiting > 0) {
+        return;
+    }
+    if (itr->second->done) {
+        if (itr->second->shape) {
+            ShapeFactory::deleteShape(itr->second->shape);
+        }
+        _pendingShapes.erase(itr);
+    }
+    // else the task still owns it, so it is deleted with the garbage once it is done
+}
+
+// private helper method
+void ShapeManager::collectPendingShapes() {
+    uint64_t now = usecTimestampNow();
+    auto itr = _pendingShapes.begin();
+    while (itr != _pendingShapes.end()) {
+        const PendingShapePointer& pendingShape = itr->second;
+        if (pendingShape->done && (pendingShape->numWaiting <= 0
+                || now - pendingShape->doneTime > MAX_UNCLAIMED_PENDING_SHAPE_USECS)) {
+            if (pendingShape->shape) {
+                ShapeFactory::deleteShape(pendingShape->shape);
+            }
+            itr = _pendingShapes.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
+
 void ShapeManager::collectGarbage() {
+    collectPendingShapes();
+
     int numShapes = _pendingGarbage.size();
     for (int i = 0; i < numShapes; ++i) {
         HashKey& key = _pendingGarbage[i];
@@ -12,6 +12,10 @@
 #ifndef hifi_ShapeManager_h
 #define hifi_ShapeManager_h
 
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
@@ -40,6 +44,17 @@
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
 // later.  When that list grows big enough the ShapeManager will remove any matching
 // entries that still have zero ref-count.
+//
+// Hulls and meshes can take long enough to build to stall a frame, so when building in the background is enabled
+// the ShapeManager hands those to worker threads instead, and returns nullptr for the shape until it is ready.  The
+// bodies that need it already try again later, as they do when a shape can't be made yet.  Each of them is counted
+// as waiting for the shape until it gets it or gives up with releasePendingShape().  A shape that is done is kept
+// until it is asked for again or nobody waits for it, or for a short while if those who wait never come back for it.
+//
+// A HullCache can be set for the hulls to be loaded from disk rather than built again in every session.
+
+class HullCache;
+class QThreadPool;
 
 class ShapeManager {
 public:
@@ -47,23 +62,54 @@ public:
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
-    const btCollisionShape* getShape(const ShapeInfo& info);
+    /// \return pointer to shape, or nullptr while it is being built in the background
+    /// isWaiting: true when the caller asks again for a shape it is already waiting for
+    const btCollisionShape* getShape(const ShapeInfo& info, bool isWaiting = false);
+
+    /// build the hull and mesh shapes on worker threads
+    void setBuildShapesInBackground(bool enabled) { _buildShapesInBackground = enabled; }
+    bool getBuildShapesInBackground() const { return _buildShapesInBackground; }
+
+    void setHullCache(std::shared_ptr<HullCache> hullCache) { _hullCache = hullCache; }
 
     /// \return true if shape was found and released
     bool releaseShape(const btCollisionShape* shape);
 
-    /// delete shapes that have zero references
+    /// \return true if the shape is being built in the background, or is done and waiting to be asked for again
+    bool isShapePending(const HashKey& key) const { return _pendingShapes.find(key.getHash64()) != _pendingShapes.end(); }
+
+    /// stop waiting for a shape being built in the background, which is deleted once it is done if nobody else waits
+    void releasePendingShape(const HashKey& key);
+
+    /// delete shapes that have zero references, and shapes built in the background that nobody waits for
     void collectGarbage();
 
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
+    int getNumPendingShapes() const { return (int)_pendingShapes.size(); }
     int getNumReferences(const ShapeInfo& info) const;
     int getNumReferences(const btCollisionShape* shape) const;
     bool hasShape(const btCollisionShape* shape) const;
 
 private:
+    class BuildShapeTask;
+
+    // a shape being built in the background
+    class PendingShape {
+    public:
+        PendingShape(const ShapeInfo& info) : info(info) {}
+        ShapeInfo info;
+        const btCollisionShape* shape { nullptr };
+        uint64_t doneTime { 0 };
+        std::atomic<bool> done { false };
+        int numWaiting { 1 }; // only touched by the thread that asks for shapes
+    };
+    using PendingShapePointer = std::shared_ptr<PendingShape>;
+
     bool releaseShapeByKey(const HashKey& key);
+    void addShape(const HashKey& key, const btCollisionShape* shape);
+    const btCollisionShape* getShapeInBackground(const ShapeInfo& info, const HashKey& key, bool isWaiting);
+    void collectPendingShapes();
 
     class ShapeReference {
     public:
@@ -76,6 +122,11 @@ private:
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     btAlignedObjectArray<HashKey> _pendingGarbage;
+
+    std::unordered_map<uint64_t, PendingShapePointer> _pendingShapes; // by the 64-bit hash of their keys
+    std::unique_ptr<QThreadPool> _threadPool; // created for the first shape built in the background
+    std::shared_ptr<HullCache> _hullCache;
+    bool _buildShapesInBackground { false };
 };
 
 #endif // hifi_ShapeManager_h
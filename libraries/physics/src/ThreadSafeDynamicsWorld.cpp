@@ -17,10 +17,73 @@
 
 #include "ThreadSafeDynamicsWorld.h"
 
+#include <algorithm>
+
+#include <QThreadPool>
+
+#include <BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
 #include <LinearMath/btQuickprof.h>
 
+#include "PhysicsLogging.h"
 #include "Profile.h"
 
+// the island of a constraint, as btDiscreteDynamicsWorld finds it
+static int getConstraintIslandId(const btTypedConstraint* constraint) {
+    const btCollisionObject& objectA = constraint->getRigidBodyA();
+    const btCollisionObject& objectB = constraint->getRigidBodyB();
+    return objectA.getIslandTag() >= 0 ? objectA.getIslandTag() : objectB.getIslandTag();
+}
+
+static bool lessConstraintIslandId(const btTypedConstraint* constraint, int islandId) {
+    return getConstraintIslandId(constraint) < islandId;
+}
+
+static bool lessIslandIdConstraint(int islandId, const btTypedConstraint* constraint) {
+    return islandId < getConstraintIslandId(constraint);
+}
+
+class SortConstraintsOnIsland {
+public:
+    bool operator()(const btTypedConstraint* lhs, const btTypedConstraint* rhs) const {
+        return getConstraintIslandId(lhs) < getConstraintIslandId(rhs);
+    }
+};
+
+// whether the solver would write to a body that is in another island than this one: a kinematic body, which
+// doesn't join the islands of what touches it
+static bool isSharedBody(const btCollisionObject* object, int islandId) {
+    return !object->isStaticObject() && object->getIslandTag() != islandId;
+}
+
+// Hands the awake islands to the world as the island manager finds them
+class ThreadSafeDynamicsWorld::IslandGatherer : public btSimulationIslandManager::IslandCallback {
+public:
+    IslandGatherer(ThreadSafeDynamicsWorld& world) : _world(world) {}
+
+    void processIsland(btCollisionObject** bodies, int numBodies, btPersistentManifold** manifolds, int numManifolds,
+                       int islandId) override {
+        _world.gatherIsland(bodies, numBodies, manifolds, numManifolds, islandId);
+    }
+
+private:
+    ThreadSafeDynamicsWorld& _world;
+};
+
+// Solves the parallel batches of islands on a thread of the pool, with a solver of its own
+class ThreadSafeDynamicsWorld::SolverTask : public QRunnable {
+public:
+    SolverTask(ThreadSafeDynamicsWorld& world) : _world(world), _solver(new btSequentialImpulseConstraintSolver()) {
+        setAutoDelete(false);
+    }
+
+    void run() override { _world.solveParallelIslandBatches(_solver.get(), *_world._solverInfo); }
+
+private:
+    ThreadSafeDynamicsWorld& _world;
+    std::unique_ptr<btSequentialImpulseConstraintSolver> _solver;
+};
+
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
@@ -29,6 +92,9 @@ ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
     :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
 }
 
+ThreadSafeDynamicsWorld::~ThreadSafeDynamicsWorld() {
+}
+
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
                                                                btScalar fixedTimeStep, SubStepCallback onSubStep) {
     DETAILED_PROFILE_RANGE(simulation_physics, "stepWithCB");
@@ -184,4 +250,158 @@ void ThreadSafeDynamicsWorld::saveKinematicState(btScalar timeStep) {
     }
 }
 
+bool ThreadSafeDynamicsWorld::isParallelSolverSupported() {
+    // BT_QUICKPROF_MAX_THREAD_COUNT is defined by the versions of Bullet whose profiler keeps a tree of timings per thread;
+    // the profiler of the others is a single tree that the solver of each thread would walk at once
+#if defined(BT_NO_PROFILE) || defined(BT_QUICKPROF_MAX_THREAD_COUNT)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ThreadSafeDynamicsWorld::setNumSolverThreads(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+    if (numThreads > 1 && !isParallelSolverSupported()) {
+        qCWarning(physics) << "ThreadSafeDynamicsWorld: this build of Bullet can't solve islands on several threads";
+        numThreads = 1;
+    }
+    if (numThreads == _numSolverThreads) {
+        return;
+    }
+    _numSolverThreads = numThreads;
+
+    if (!_solverThreadPool) {
+        _solverThreadPool.reset(new QThreadPool());
+    }
+    _solverThreadPool->setMaxThreadCount(std::max(numThreads - 1, 1));
+    while ((int)_solverTasks.size() < numThreads - 1) {
+        _solverTasks.emplace_back(new SolverTask(*this));
+    }
+    _solverTasks.resize(numThreads - 1);
+}
+
+void ThreadSafeDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo) {
+    if (_numSolverThreads < 2) {
+        btDiscreteDynamicsWorld::solveConstraints(solverInfo);
+        return;
+    }
+    BT_PROFILE("solveConstraints");
+
+    // sort the constraints by island, for gatherIsland to find those of each
+    m_sortedConstraints.resize(m_constraints.size());
+    for (int i = 0; i < m_constraints.size(); ++i) {
+        m_sortedConstraints[i] = m_constraints[i];
+    }
+    m_sortedConstraints.quickSort(SortConstraintsOnIsland());
+
+    _solverInfo = &solverInfo;
+    _parallelIslands.clear();
+    _serialIslands.clear();
+    {
+        BT_PROFILE("gatherIslands");
+        IslandGatherer gatherer(*this);
+        m_islandManager->buildAndProcessIslands(getCollisionWorld()->getDispatcher(), getCollisionWorld(), &gatherer);
+    }
+
+    m_constraintSolver->prepareSolve(getCollisionWorld()->getNumCollisionObjects(),
+                                     getCollisionWorld()->getDispatcher()->getNumManifolds());
+
+    // Each island is solved in the same batch whichever thread takes it, and the batches touch none of the same bodies,
+    // so the result doesn't depend on the number of threads or on which of them finishes first.  The manifolds are left
+    // in the order of the dispatcher, for the contacts to be harvested from in that order after the substep.
+    _nextParallelBatch = 0;
+    int numTasks = std::min((int)_solverTasks.size(), (int)_parallelIslands.batches.size() - 1);
+    for (int i = 0; i < numTasks; ++i) {
+        _solverThreadPool->start(_solverTasks[i].get());
+    }
+    solveParallelIslandBatches(m_constraintSolver, solverInfo);
+    if (numTasks > 0) {
+        _solverThreadPool->waitForDone();
+    }
+
+    for (const auto& batch : _serialIslands.batches) {
+        solveIslandBatch(m_constraintSolver, _serialIslands, batch, solverInfo, m_debugDrawer);
+    }
+
+    m_constraintSolver->allSolved(solverInfo, m_debugDrawer);
+    _solverInfo = nullptr;
+}
+
+void ThreadSafeDynamicsWorld::gatherIsland(btCollisionObject** bodies, int numBodies, btPersistentManifold** manifolds,
+                                           int numManifolds, int islandId) {
+    btTypedConstraint** constraints = nullptr;
+    int numConstraints = 0;
+    if (m_sortedConstraints.size() > 0 && islandId < 0) {
+        // the islands aren't split, so this is every body
+        constraints = &m_sortedConstraints[0];
+        numConstraints = m_sortedConstraints.size();
+    } else if (m_sortedConstraints.size() > 0) {
+        btTypedConstraint** sortedConstraints = &m_sortedConstraints[0];
+        btTypedConstraint** sortedConstraintsEnd = sortedConstraints + m_sortedConstraints.size();
+        constraints = std::lower_bound(sortedConstraints, sortedConstraintsEnd, islandId, lessConstraintIslandId);
+        numConstraints = (int)(std::upper_bound(constraints, sortedConstraintsEnd, islandId, lessIslandIdConstraint) -
+                               constraints);
+    }
 
+    bool shared = false;
+    for (int i = 0; i < numManifolds && !shared; ++i) {
+        shared = isSharedBody(manifolds[i]->getBody0(), islandId) || isSharedBody(manifolds[i]->getBody1(), islandId);
+    }
+    for (int i = 0; i < numConstraints && !shared; ++i) {
+        shared = isSharedBody(&constraints[i]->getRigidBodyA(), islandId) ||
+                 isSharedBody(&constraints[i]->getRigidBodyB(), islandId);
+    }
+
+    IslandBatches& islands = shared ? _serialIslands : _parallelIslands;
+    islands.addIsland(bodies, numBodies, manifolds, numManifolds, constraints, numConstraints,
+                      _solverInfo->m_minimumSolverBatchSize);
+}
+
+void ThreadSafeDynamicsWorld::IslandBatches::clear() {
+    bodies.clear();
+    manifolds.clear();
+    constraints.clear();
+    batches.clear();
+    _lastBatchFull = true;
+}
+
+void ThreadSafeDynamicsWorld::IslandBatches::addIsland(btCollisionObject** islandBodies, int numBodies,
+                                                       btPersistentManifold** islandManifolds, int numManifolds,
+                                                       btTypedConstraint** islandConstraints, int numConstraints,
+                                                       int minBatchSize) {
+    if (_lastBatchFull) {
+        batches.push_back({ (int)bodies.size(), 0, (int)manifolds.size(), 0, (int)constraints.size(), 0 });
+    }
+    // the island manager reuses its list of the bodies of an island for the next, so they are copied
+    bodies.insert(bodies.end(), islandBodies, islandBodies + numBodies);
+    manifolds.insert(manifolds.end(), islandManifolds, islandManifolds + numManifolds);
+    constraints.insert(constraints.end(), islandConstraints, islandConstraints + numConstraints);
+
+    IslandBatch& batch = batches.back();
+    batch.numBodies += numBodies;
+    batch.numManifolds += numManifolds;
+    batch.numConstraints += numConstraints;
+    _lastBatchFull = minBatchSize <= 1 || batch.numManifolds + batch.numConstraints > minBatchSize;
+}
+
+void ThreadSafeDynamicsWorld::solveIslandBatch(btConstraintSolver* solver, const IslandBatches& islands,
+                                               const IslandBatch& batch, const btContactSolverInfo& solverInfo,
+                                               btIDebugDraw* debugDrawer) {
+    btCollisionObject** bodies = batch.numBodies > 0 ?
+        const_cast<btCollisionObject**>(&islands.bodies[batch.firstBody]) : nullptr;
+    btPersistentManifold** manifolds = batch.numManifolds > 0 ?
+        const_cast<btPersistentManifold**>(&islands.manifolds[batch.firstManifold]) : nullptr;
+    btTypedConstraint** constraints = batch.numConstraints > 0 ?
+        const_cast<btTypedConstraint**>(&islands.constraints[batch.firstConstraint]) : nullptr;
+    solver->solveGroup(bodies, batch.numBodies, manifolds, batch.numManifolds, constraints, batch.numConstraints,
+                       solverInfo, debugDrawer, getCollisionWorld()->getDispatcher());
+}
+
+void ThreadSafeDynamicsWorld::solveParallelIslandBatches(btConstraintSolver* solver,
+                                                         const btContactSolverInfo& solverInfo) {
+    int numBatches = (int)_parallelIslands.batches.size();
+    for (int i = _nextParallelBatch++; i < numBatches; i = _nextParallelBatch++) {
+        solveIslandBatch(solver, _parallelIslands, _parallelIslands.batches[i], solverInfo, nullptr);
+    }
+}
@@ -23,7 +23,12 @@
 
 #include "ObjectMotionState.h"
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <vector>
+
+class QThreadPool;
 
 using SubStepCallback = std::function<void()>;
 
@@ -36,6 +41,7 @@ public:
             btBroadphaseInterface* pairCache,
             btConstraintSolver* constraintSolver,
             btCollisionConfiguration* collisionConfiguration);
+    ~ThreadSafeDynamicsWorld();
 
     int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
                                           btScalar fixedTimeStep = btScalar(1.)/btScalar(60.),
@@ -53,7 +59,57 @@ public:
 
     void addChangedMotionState(ObjectMotionState* motionState) { _changedMotionStates.push_back(motionState); }
 
+    // Solve the simulation islands on up to this many threads, the calling thread being one of them.  The islands are
+    // only split across threads where Bullet can be entered from several threads at once (see isParallelSolverSupported).
+    void setNumSolverThreads(int numThreads);
+    int getNumSolverThreads() const { return _numSolverThreads; }
+
+    // Bullet's profiler must be compiled out, or keep its timings per thread, for the solver to run on several threads.
+    //   The Bullet that cmake/externals builds keeps its profiler unless the BULLET_NO_PROFILE option is on.
+    static bool isParallelSolverSupported();
+
+protected:
+    virtual void solveConstraints(btContactSolverInfo& solverInfo) override;
+
 private:
+    class IslandGatherer;
+    class SolverTask;
+
+    // a run of islands that are solved together, as Bullet does with islands smaller than m_minimumSolverBatchSize
+    class IslandBatch {
+    public:
+        int firstBody;
+        int numBodies;
+        int firstManifold;
+        int numManifolds;
+        int firstConstraint;
+        int numConstraints;
+    };
+
+    // the bodies, manifolds and constraints of islands, with those of each batch together
+    class IslandBatches {
+    public:
+        void clear();
+        void addIsland(btCollisionObject** bodies, int numBodies, btPersistentManifold** manifolds, int numManifolds,
+                       btTypedConstraint** constraints, int numConstraints, int minBatchSize);
+
+        std::vector<btCollisionObject*> bodies;
+        std::vector<btPersistentManifold*> manifolds;
+        std::vector<btTypedConstraint*> constraints;
+        std::vector<IslandBatch> batches;
+
+    private:
+        bool _lastBatchFull { true };
+    };
+
+    void gatherIsland(btCollisionObject** bodies, int numBodies, btPersistentManifold** manifolds, int numManifolds,
+                      int islandId);
+    void solveIslandBatch(btConstraintSolver* solver, const IslandBatches& islands, const IslandBatch& batch,
+                          const btContactSolverInfo& solverInfo, btIDebugDraw* debugDrawer);
+
+    // solve the parallel batches not yet taken by another thread
+    void solveParallelIslandBatches(btConstraintSolver* solver, const btContactSolverInfo& solverInfo);
+
     // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
     void synchronizeMotionState(btRigidBody* body);
 
@@ -61,6 +117,16 @@ private:
     VectorOfMotionStates _deactivatedStates;
     SetOfMotionStates _activeStates;
     SetOfMotionStates _lastActiveStates;
+
+    // the awake islands of the substep, for the parallel solver
+    btContactSolverInfo* _solverInfo { nullptr };
+    IslandBatches _parallelIslands; // islands that touch no body of another island
+    IslandBatches _serialIslands; // islands that share kinematic bodies, solved on the calling thread
+    std::atomic<int> _nextParallelBatch { 0 };
+
+    int _numSolverThreads { 1 };
+    std::vector<std::unique_ptr<SolverTask>> _solverTasks; // one for each thread but the calling one
+    std::unique_ptr<QThreadPool> _solverThreadPool;
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
@@ -13,6 +13,7 @@
 
 #include <exception>
 #include <functional>
+#include <string>
 
 #include <QtCore/QMutex>
 #include <QtCore/QMutexLocker>
@@ -32,6 +33,9 @@ void withLock(QMutex& lock, F function) {
     function();
 }
 
+// name the calling thread, for debuggers
+void setThreadName(const std::string& name);
+
 void moveToNewNamedThread(QObject* object, const QString& name, 
     std::function<void(QThread*)> preStartCallback, 
     std::function<void()> startCallback, 
@@ -0,0 +1,66 @@
+//
+//  Space_avx2.cpp
+//  libraries/workload/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../workload/Space.h"
+
+#if defined(__GNUC__) && !defined(__clang__)
+// keep the distances rounded exactly as the SSE and reference code rounds them, rather than fused into FMAs
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+using namespace workload;
+
+void classifyProxies_AVX2(const float* centerX, const float* centerY, const float* centerZ, const float* radiuses,
+                          uint32_t numProxies, const Space::View* views, uint32_t numViews, uint8_t* regions) {
+
+    assert(numProxies % 8 == 0);
+
+    const __m256 unknown = _mm256_set1_ps((float)Space::REGION_UNKNOWN);
+
+    for (uint32_t i = 0; i < numProxies; i += 8) {
+
+        __m256 x = _mm256_loadu_ps(&centerX[i]);
+        __m256 y = _mm256_loadu_ps(&centerY[i]);
+        __m256 z = _mm256_loadu_ps(&centerZ[i]);
+        __m256 r = _mm256_loadu_ps(&radiuses[i]);
+        __m256 region = unknown;
+
+        for (uint32_t j = 0; j < numViews; ++j) {
+            const Space::View& view = views[j];
+            __m256 dx = _mm256_sub_ps(x, _mm256_set1_ps(view.center.x));
+            __m256 dy = _mm256_sub_ps(y, _mm256_set1_ps(view.center.y));
+            __m256 dz = _mm256_sub_ps(z, _mm256_set1_ps(view.center.z));
+            __m256 distance2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                             _mm256_mul_ps(dz, dz));
+
+            for (int c = 0; c < 3; ++c) {
+                __m256 touchDistance = _mm256_add_ps(_mm256_set1_ps(view.radiuses[c]), r);
+                __m256 touches = _mm256_cmp_ps(distance2, _mm256_mul_ps(touchDistance, touchDistance), _CMP_LT_OQ);
+                region = _mm256_blendv_ps(region, _mm256_min_ps(region, _mm256_set1_ps((float)c)), touches);
+            }
+        }
+
+        // convert to bytes
+        __m256i converted = _mm256_cvttps_epi32(region);
+        __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(converted), _mm256_extracti128_si256(converted, 1));
+        packed = _mm_packus_epi16(packed, packed);
+        _mm_storel_epi64((__m128i*)&regions[i], packed);
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -0,0 +1,63 @@
+//
+//  Space_avx512.cpp
+//  libraries/workload/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX512F__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../workload/Space.h"
+
+#if defined(__GNUC__) && !defined(__clang__)
+// keep the distances rounded exactly as the SSE and reference code rounds them, rather than fused into FMAs
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+using namespace workload;
+
+void classifyProxies_AVX512(const float* centerX, const float* centerY, const float* centerZ, const float* radiuses,
+                            uint32_t numProxies, const Space::View* views, uint32_t numViews, uint8_t* regions) {
+
+    assert(numProxies % 16 == 0);
+
+    const __m512 unknown = _mm512_set1_ps((float)Space::REGION_UNKNOWN);
+
+    for (uint32_t i = 0; i < numProxies; i += 16) {
+
+        __m512 x = _mm512_loadu_ps(&centerX[i]);
+        __m512 y = _mm512_loadu_ps(&centerY[i]);
+        __m512 z = _mm512_loadu_ps(&centerZ[i]);
+        __m512 r = _mm512_loadu_ps(&radiuses[i]);
+        __m512 region = unknown;
+
+        for (uint32_t j = 0; j < numViews; ++j) {
+            const Space::View& view = views[j];
+            __m512 dx = _mm512_sub_ps(x, _mm512_set1_ps(view.center.x));
+            __m512 dy = _mm512_sub_ps(y, _mm512_set1_ps(view.center.y));
+            __m512 dz = _mm512_sub_ps(z, _mm512_set1_ps(view.center.z));
+            __m512 distance2 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)),
+                                             _mm512_mul_ps(dz, dz));
+
+            for (int c = 0; c < 3; ++c) {
+                __m512 touchDistance = _mm512_add_ps(_mm512_set1_ps(view.radiuses[c]), r);
+                __mmask16 touches = _mm512_cmp_ps_mask(distance2, _mm512_mul_ps(touchDistance, touchDistance), _CMP_LT_OQ);
+                region = _mm512_mask_min_ps(region, touches, region, _mm512_set1_ps((float)c));
+            }
+        }
+
+        // convert to bytes
+        _mm_storeu_si128((__m128i*)&regions[i], _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(region)));
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
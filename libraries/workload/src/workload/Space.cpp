@@ -15,80 +15,611 @@
 #include "Space.h"
 
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
 
-#include <glm/gtx/quaternion.hpp>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 using namespace workload;
 
+// proxies are classified a block at a time, into a buffer on the stack
+static const uint32_t CATEGORIZE_BLOCK_SIZE = 256;
+
+static uint32_t roundUp(uint32_t value, uint32_t multiple) {
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+
+//
+// Classify the proxies into the nearest region of any view that they touch
+// numProxies must be a multiple of Space::PROXY_PADDING
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void classifyProxies_SSE(const float* centerX, const float* centerY, const float* centerZ, const float* radiuses,
+                                uint32_t numProxies, const Space::View* views, uint32_t numViews, uint8_t* regions) {
+
+    const __m128 unknown = _mm_set1_ps((float)Space::REGION_UNKNOWN);
+
+    for (uint32_t i = 0; i < numProxies; i += 4) {
+
+        __m128 x = _mm_loadu_ps(&centerX[i]);
+        __m128 y = _mm_loadu_ps(&centerY[i]);
+        __m128 z = _mm_loadu_ps(&centerZ[i]);
+        __m128 r = _mm_loadu_ps(&radiuses[i]);
+        __m128 region = unknown;
+
+        for (uint32_t j = 0; j < numViews; ++j) {
+            const Space::View& view = views[j];
+            __m128 dx = _mm_sub_ps(x, _mm_set1_ps(view.center.x));
+            __m128 dy = _mm_sub_ps(y, _mm_set1_ps(view.center.y));
+            __m128 dz = _mm_sub_ps(z, _mm_set1_ps(view.center.z));
+            __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            for (int c = 0; c < 3; ++c) {
+                __m128 touchDistance = _mm_add_ps(_mm_set1_ps(view.radiuses[c]), r);
+                __m128 touches = _mm_cmplt_ps(distance2, _mm_mul_ps(touchDistance, touchDistance));
+                __m128 nearer = _mm_min_ps(region, _mm_set1_ps((float)c));
+                region = _mm_or_ps(_mm_and_ps(touches, nearer), _mm_andnot_ps(touches, region));
+            }
+        }
+
+        // convert to bytes
+        __m128i packed = _mm_cvttps_epi32(region);
+        packed = _mm_packs_epi32(packed, packed);
+        packed = _mm_packus_epi16(packed, packed);
+        int32_t bytes = _mm_cvtsi128_si32(packed);
+        memcpy(&regions[i], &bytes, sizeof(bytes));
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void classifyProxies_AVX2(const float* centerX, const float* centerY, const float* centerZ, const float* radiuses,
+                          uint32_t numProxies, const Space::View* views, uint32_t numViews, uint8_t* regions);
+void classifyProxies_AVX512(const float* centerX, const float* centerY, const float* centerZ, const float* radiuses,
+                            uint32_t numProxies, const Space::View* views, uint32_t numViews, uint8_t* regions);
+
+static void classifyProxies(const float* centerX, const float* centerY, const float* centerZ, const float* radiuses,
+                            uint32_t numProxies, const Space::View* views, uint32_t numViews, uint8_t* regions) {
+
+    static auto f = cpuSupportsAVX512() ? classifyProxies_AVX512 :
+        (cpuSupportsAVX2() ? classifyProxies_AVX2 : classifyProxies_SSE);
+    (*f)(centerX, centerY, centerZ, radiuses, numProxies, views, numViews, regions); // dispatch
+}
+
+#else   // portable reference code
+
+static void classifyProxies(const float* centerX, const float* centerY, const float* centerZ, const float* radiuses,
+                            uint32_t numProxies, const Space::View* views, uint32_t numViews, uint8_t* regions) {
+
+    for (uint32_t i = 0; i < numProxies; ++i) {
+        uint8_t region = Space::REGION_UNKNOWN;
+        for (uint32_t j = 0; j < numViews; ++j) {
+            const Space::View& view = views[j];
+            float dx = centerX[i] - view.center.x;
+            float dy = centerY[i] - view.center.y;
+            float dz = centerZ[i] - view.center.z;
+            float distance2 = dx * dx + dy * dy + dz * dz;
+            for (uint8_t c = 0; c < region; ++c) {
+                float touchDistance = view.radiuses[c] + radiuses[i];
+                if (distance2 < touchDistance * touchDistance) {
+                    region = c;
+                    break;
+                }
+            }
+        }
+        regions[i] = region;
+    }
+}
+
+#endif
+
+// Categorizes a range of the proxies on a thread of the pool, keeping its changes for
+// categorizeEveryProxyAndGetChanges to append to the others, in order
+class Space::CategorizeTask : public QRunnable {
+public:
+    CategorizeTask(Space& space, uint32_t begin, uint32_t end) : _space(space), _begin(begin), _end(end) {
+        setAutoDelete(false);
+    }
+
+    void run() override { _space.categorizeAndGetChanges(_begin, _end, changes); }
+
+    std::vector<Space::Change> changes;
+
+private:
+    Space& _space;
+    uint32_t _begin;
+    uint32_t _end;
+};
+
+// bounds are compared to the views with a little slop, so that the rounding of the distances of the proxies
+// themselves never puts one in a region other than the one found for all of them
+static const float BOUNDS_REGION_SLOP = 1.0e-4f;
+
+void Space::Bounds::clear() {
+    minCenter = glm::vec3(FLT_MAX);
+    maxCenter = glm::vec3(-FLT_MAX);
+    minRadius = FLT_MAX;
+    maxRadius = -FLT_MAX;
+    region = Space::REGION_INVALID;
+}
+
+bool Space::Bounds::expand(const Space::Sphere& sphere) {
+    if (sphere.x >= minCenter.x && sphere.y >= minCenter.y && sphere.z >= minCenter.z &&
+            sphere.x <= maxCenter.x && sphere.y <= maxCenter.y && sphere.z <= maxCenter.z &&
+            sphere.w >= minRadius && sphere.w <= maxRadius) {
+        return false;
+    }
+    minCenter = glm::min(minCenter, glm::vec3(sphere));
+    maxCenter = glm::max(maxCenter, glm::vec3(sphere));
+    minRadius = std::min(minRadius, sphere.w);
+    maxRadius = std::max(maxRadius, sphere.w);
+    return true;
+}
+
+void Space::Bounds::expand(const Space::Bounds& bounds) {
+    minCenter = glm::min(minCenter, bounds.minCenter);
+    maxCenter = glm::max(maxCenter, bounds.maxCenter);
+    minRadius = std::min(minRadius, bounds.minRadius);
+    maxRadius = std::max(maxRadius, bounds.maxRadius);
+}
+
+uint8_t Space::Bounds::findRegion(const std::vector<Space::View>& views) const {
+    uint8_t region = Space::REGION_UNKNOWN;
+    for (const auto& view : views) {
+        glm::vec3 nearest = glm::clamp(view.center, minCenter, maxCenter);
+        glm::vec3 farthest = glm::max(glm::abs(view.center - minCenter), glm::abs(view.center - maxCenter));
+        float minDistance = glm::length(view.center - nearest) * (1.0f - BOUNDS_REGION_SLOP) - BOUNDS_REGION_SLOP;
+        float maxDistance = glm::length(farthest) * (1.0f + BOUNDS_REGION_SLOP) + BOUNDS_REGION_SLOP;
+        for (uint8_t c = 0; c < 3; ++c) {
+            // the touch distances are squared, so a negative one touches as much as a positive one
+            float minTouchDistance = view.radiuses[c] + minRadius;
+            float maxTouchDistance = view.radiuses[c] + maxRadius;
+            if (maxDistance < minTouchDistance) {
+                region = std::min(region, c);
+            } else if (!(minDistance > std::max(fabsf(minTouchDistance), fabsf(maxTouchDistance)))) {
+                return Space::REGION_INVALID;
+            }
+        }
+    }
+    return region;
+}
+
+static const uint32_t NO_CELL = (uint32_t)-1;
+
+// 21 bits per coordinate, offset to be positive
+static const int COORD_BITS = 21;
+static const uint32_t COORD_OFFSET = 1 << (COORD_BITS - 1);
+
+static uint64_t cellKey(float x, float y, float z) {
+    // the cells at the edges stretch to infinity
+    const float MAX_COORD = (float)(COORD_OFFSET - 1);
+    float coords[3] = { x, y, z };
+    uint64_t key = 0;
+    for (int i = 0; i < 3; ++i) {
+        float coord = floorf(coords[i] / Space::CELL_SIZE);
+        coord = coord > MAX_COORD ? MAX_COORD : (coord >= -MAX_COORD ? coord : -MAX_COORD); // NaN too
+        key = (key << COORD_BITS) | (uint64_t)((int32_t)coord + (int32_t)COORD_OFFSET);
+    }
+    return key;
+}
+
+static uint64_t cellBlockKey(uint64_t cellKey) {
+    const uint64_t COORD_MASK = (1 << COORD_BITS) - 1;
+    uint64_t key = 0;
+    for (int i = 2; i >= 0; --i) {
+        key = (key << COORD_BITS) | (((cellKey >> (i * COORD_BITS)) & COORD_MASK) / Space::BLOCK_WIDTH);
+    }
+    return key;
+}
+
+static bool sameViews(const std::vector<Space::View>& views, const std::vector<Space::View>& otherViews) {
+    if (views.size() != otherViews.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < views.size(); ++i) {
+        if (views[i].center != otherViews[i].center || memcmp(views[i].radiuses, otherViews[i].radiuses,
+                                                              sizeof(views[i].radiuses)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const float Space::CELL_SIZE = 64.0f;
+
+Space::Space() {
+}
+
+Space::~Space() {
+}
+
+void Space::resizeProxies(uint32_t numProxies) {
+    // the padding is classified but never categorized, so it doesn't matter what it holds
+    uint32_t paddedSize = roundUp(numProxies, PROXY_PADDING);
+    _centerX.resize(paddedSize);
+    _centerY.resize(paddedSize);
+    _centerZ.resize(paddedSize);
+    _radiuses.resize(paddedSize);
+    _regions.resize(numProxies);
+    _prevRegions.resize(numProxies);
+    _proxyCells.resize(numProxies, NO_CELL);
+    _proxyCellSlots.resize(numProxies);
+    _dirtyFlags.resize(numProxies);
+}
+
+void Space::setSphere(int32_t proxyId, const Space::Sphere& sphere) {
+    _centerX[proxyId] = sphere.x;
+    _centerY[proxyId] = sphere.y;
+    _centerZ[proxyId] = sphere.z;
+    _radiuses[proxyId] = sphere.w;
+}
+
+Space::Sphere Space::getSphere(int32_t proxyId) const {
+    return Space::Sphere(_centerX[proxyId], _centerY[proxyId], _centerZ[proxyId], _radiuses[proxyId]);
+}
+
+void Space::markDirty(int32_t proxyId) {
+    if (!_dirtyFlags[proxyId]) {
+        _dirtyFlags[proxyId] = 1;
+        _dirtyProxies.push_back(proxyId);
+    }
+}
+
 int32_t Space::createProxy(const Space::Sphere& newSphere) {
+    int32_t index;
     if (_freeIndices.empty()) {
-        _proxies.emplace_back(Space::Proxy(newSphere));
-        return (int32_t)_proxies.size() - 1;
+        index = (int32_t)_regions.size();
+        resizeProxies((uint32_t)index + 1);
     } else {
-        int32_t index = _freeIndices.back();
+        index = _freeIndices.back();
         _freeIndices.pop_back();
-        _proxies[index].sphere = newSphere;
-        _proxies[index].region = Space::REGION_UNKNOWN;
-        _proxies[index].prevRegion = Space::REGION_UNKNOWN;
-        return index;
     }
+    setSphere(index, newSphere);
+    _regions[index] = Space::REGION_UNKNOWN;
+    _prevRegions[index] = Space::REGION_UNKNOWN;
+    markDirty(index);
+    return index;
 }
 
 void Space::deleteProxy(int32_t proxyId) {
-    if (proxyId >= (int32_t)_proxies.size() || _proxies.empty()) {
+    uint32_t numProxies = (uint32_t)_regions.size();
+    if (proxyId >= (int32_t)numProxies || numProxies == 0) {
         return;
     }
-    if (proxyId == (int32_t)_proxies.size() - 1) {
+    removeFromCell(proxyId);
+    if (proxyId == (int32_t)numProxies - 1) {
         // remove proxy on back
-        _proxies.pop_back();
+        --numProxies;
         if (!_freeIndices.empty()) {
             // remove any freeIndices on back
             std::sort(_freeIndices.begin(), _freeIndices.end());
-            while(!_freeIndices.empty() && _freeIndices.back() == (int32_t)_proxies.size() - 1) {
+            while(!_freeIndices.empty() && _freeIndices.back() == (int32_t)numProxies - 1) {
                 _freeIndices.pop_back();
-                _proxies.pop_back();
+                --numProxies;
             }
         }
+        resizeProxies(numProxies);
     } else {
-        _proxies[proxyId].region = Space::REGION_INVALID;
+        _regions[proxyId] = Space::REGION_INVALID;
         _freeIndices.push_back(proxyId);
     }
 }
 
 void Space::updateProxy(int32_t proxyId, const Space::Sphere& newSphere) {
-    if (proxyId >= (int32_t)_proxies.size()) {
+    if (proxyId >= (int32_t)_regions.size()) {
         return;
     }
-    _proxies[proxyId].sphere = newSphere;
+    setSphere(proxyId, newSphere);
+    markDirty(proxyId);
 }
 
 void Space::setViews(const std::vector<Space::View>& views) {
     _views = views;
+    _viewsChanged = !sameViews(_views, _categorizedViews);
 }
 
-void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
-    uint32_t numProxies = (uint32_t)_proxies.size();
-    uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
-        if (proxy.region < Space::REGION_INVALID) {
-            uint8_t region = Space::REGION_UNKNOWN;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                float distance2 = glm::distance2(_views[j].center, glm::vec3(_proxies[i].sphere));
-                for (uint8_t c = 0; c < region; ++c) {
-                    float touchDistance = _views[j].radiuses[c] + _proxies[i].sphere.w;
-                    if (distance2 < touchDistance * touchDistance) {
-                        region = c;
-                        break;
+uint32_t Space::findOrCreateCell(uint64_t key) {
+    auto cellIndex = _cellIndices.find(key);
+    if (cellIndex != _cellIndices.end()) {
+        return cellIndex->second;
+    }
+
+    uint64_t blockKey = cellBlockKey(key);
+    auto blockIndex = _blockIndices.find(blockKey);
+    if (blockIndex == _blockIndices.end()) {
+        blockIndex = _blockIndices.insert(std::make_pair(blockKey, (uint32_t)_blocks.size())).first;
+        _blocks.push_back(Block());
+        _blocks.back().bounds.clear();
+    }
+
+    uint32_t index = (uint32_t)_cells.size();
+    _cellIndices.insert(std::make_pair(key, index));
+    _cells.push_back(Cell());
+    Cell& cell = _cells.back();
+    cell.key = key;
+    cell.block = blockIndex->second;
+    cell.bounds.clear();
+    _blocks[cell.block].cells.push_back(index);
+    return index;
+}
+
+void Space::moveToCell(int32_t proxyId) {
+    uint64_t key = cellKey(_centerX[proxyId], _centerY[proxyId], _centerZ[proxyId]);
+    uint32_t cellIndex = _proxyCells[proxyId];
+    if (cellIndex == NO_CELL || _cells[cellIndex].key != key) {
+        cellIndex = findOrCreateCell(key);
+        removeFromCell(proxyId);
+        Cell& cell = _cells[cellIndex];
+        _proxyCells[proxyId] = cellIndex;
+        _proxyCellSlots[proxyId] = (uint32_t)cell.proxies.size();
+        cell.proxies.push_back(proxyId);
+    }
+
+    // the regions of the cell and its block were found for the proxies that were in them then, and still hold for the
+    // proxy if it is within their bounds, or they still hold for the bounds it grows them to
+    Cell& cell = _cells[cellIndex];
+    Block& block = _blocks[cell.block];
+    Space::Sphere sphere = getSphere(proxyId);
+    if (cell.bounds.expand(sphere) && _gridRegionsFound && cell.bounds.region != Space::REGION_INVALID &&
+            cell.bounds.findRegion(_categorizedViews) != cell.bounds.region) {
+        cell.bounds.region = Space::REGION_INVALID;
+    }
+    if (block.bounds.expand(sphere) && _gridRegionsFound && block.bounds.region != Space::REGION_INVALID &&
+            block.bounds.findRegion(_categorizedViews) != block.bounds.region) {
+        block.bounds.region = Space::REGION_INVALID;
+    }
+}
+
+void Space::removeFromCell(int32_t proxyId) {
+    uint32_t cellIndex = _proxyCells[proxyId];
+    if (cellIndex == NO_CELL) {
+        return;
+    }
+    // the bounds of the cell aren't shrunk until its proxies are all categorized again
+    Cell& cell = _cells[cellIndex];
+    uint32_t slot = _proxyCellSlots[proxyId];
+    int32_t lastProxyId = cell.proxies.back();
+    cell.proxies[slot] = lastProxyId;
+    _proxyCellSlots[lastProxyId] = slot;
+    cell.proxies.pop_back();
+    if (cell.proxies.empty()) {
+        cell.bounds.clear();
+        cell.loose = false;
+    } else {
+        cell.loose = true;
+    }
+    _proxyCells[proxyId] = NO_CELL;
+}
+
+void Space::updateCells(std::vector<int32_t>& movedProxies) {
+    uint32_t numProxies = (uint32_t)_regions.size();
+    for (int32_t proxyId : _dirtyProxies) {
+        // proxies deleted since they were marked may be gone
+        if (proxyId < (int32_t)numProxies && _dirtyFlags[proxyId]) {
+            _dirtyFlags[proxyId] = 0;
+            if (_regions[proxyId] < Space::REGION_INVALID) {
+                moveToCell(proxyId);
+                movedProxies.push_back(proxyId);
+            }
+        }
+    }
+    _dirtyProxies.clear();
+}
+
+bool Space::findProxiesInChangedCells(std::vector<int32_t>& proxyIds, uint32_t maxProxyIds) {
+    // a proxy that didn't move is only in another region if the views moved the edge of a region through its cell, and
+    // so through its block
+    for (auto& block : _blocks) {
+        if (block.bounds.isEmpty()) {
+            continue;
+        }
+        uint8_t blockRegion = block.bounds.findRegion(_views);
+        if (blockRegion != Space::REGION_INVALID && blockRegion == block.bounds.region) {
+            continue;
+        }
+
+        block.bounds.clear();
+        for (uint32_t cellIndex : block.cells) {
+            Cell& cell = _cells[cellIndex];
+            if (cell.proxies.empty()) {
+                continue;
+            }
+            uint8_t region = cell.bounds.findRegion(_views);
+            if (region == Space::REGION_INVALID || region != cell.bounds.region) {
+                proxyIds.insert(proxyIds.end(), cell.proxies.begin(), cell.proxies.end());
+                if (cell.loose) {
+                    cell.bounds.clear();
+                    for (int32_t proxyId : cell.proxies) {
+                        cell.bounds.expand(getSphere(proxyId));
                     }
+                    cell.loose = false;
+                    region = cell.bounds.findRegion(_views);
                 }
             }
-            proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+            cell.bounds.region = region;
+            block.bounds.expand(cell.bounds);
+        }
+        block.bounds.region = block.bounds.findRegion(_views);
+
+        if (proxyIds.size() > maxProxyIds) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Space::findGridRegions() {
+    for (auto& block : _blocks) {
+        block.bounds.clear();
+        for (uint32_t cellIndex : block.cells) {
+            Cell& cell = _cells[cellIndex];
+            if (cell.proxies.empty()) {
+                continue;
             }
+            cell.bounds.region = cell.bounds.findRegion(_categorizedViews);
+            block.bounds.expand(cell.bounds);
         }
+        block.bounds.region = block.bounds.findRegion(_categorizedViews);
     }
+    _gridRegionsFound = true;
 }
 
+void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
+    _numCategorized = 0;
+    std::vector<int32_t> proxyIds;
+    updateCells(proxyIds);
+
+    // it's quicker to categorize every proxy, on as many threads as there are, than to gather many of them
+    uint32_t numProxies = (uint32_t)_regions.size();
+    uint32_t maxProxyIds = numProxies / 8;
+
+    if (_viewsChanged) {
+        bool found = _gridRegionsFound && findProxiesInChangedCells(proxyIds, maxProxyIds);
+        _categorizedViews = _views;
+        _viewsChanged = false;
+        if (!found) {
+            // when the views move through many proxies every proxy is categorized, and the regions of the grid are found
+            // again so that the next small move of the views is incremental
+            categorizeEveryProxyAndGetChanges(changes);
+            findGridRegions();
+            return;
+        }
+    }
+    if (proxyIds.size() > maxProxyIds) {
+        categorizeEveryProxyAndGetChanges(changes);
+    } else {
+        // put the proxies in order, sorting a few of them or flagging many of them
+        if (proxyIds.size() < numProxies / 64) {
+            std::sort(proxyIds.begin(), proxyIds.end());
+            proxyIds.erase(std::unique(proxyIds.begin(), proxyIds.end()), proxyIds.end());
+        } else {
+            _categorizeFlags.assign(numProxies, 0);
+            for (int32_t proxyId : proxyIds) {
+                _categorizeFlags[proxyId] = 1;
+            }
+            proxyIds.clear();
+            for (uint32_t i = 0; i < numProxies; ++i) {
+                if (_categorizeFlags[i]) {
+                    proxyIds.push_back((int32_t)i);
+                }
+            }
+        }
+        categorizeProxiesAndGetChanges(proxyIds, changes);
+    }
+}
+
+void Space::categorizeAllAndGetChanges(std::vector<Space::Change>& changes) {
+    _numCategorized = 0;
+    std::vector<int32_t> movedProxies;
+    updateCells(movedProxies);
+    bool viewsChanged = _viewsChanged;
+    if (viewsChanged) {
+        // the regions of the grid were found for the views before
+        _gridRegionsFound = false;
+        _categorizedViews = _views;
+        _viewsChanged = false;
+    }
+    categorizeEveryProxyAndGetChanges(changes);
+    if (viewsChanged) {
+        findGridRegions();
+    }
+}
+
+void Space::categorizeEveryProxyAndGetChanges(std::vector<Space::Change>& changes) {
+    uint32_t numProxies = (uint32_t)_regions.size();
+    _numCategorized = numProxies;
+    uint32_t numThreads = std::min((uint32_t)std::max(QThread::idealThreadCount(), 1), numProxies / MIN_PROXIES_PER_THREAD);
+    if (numThreads < 2) {
+        categorizeAndGetChanges(0, numProxies, changes);
+        return;
+    }
+
+    if (!_threadPool) {
+        _threadPool.reset(new QThreadPool());
+    }
+    _threadPool->setMaxThreadCount(numThreads - 1);
+
+    // the first range is categorized on this thread, and the rest on the pool
+    uint32_t rangeSize = roundUp((numProxies + numThreads - 1) / numThreads, CATEGORIZE_BLOCK_SIZE);
+    std::vector<std::unique_ptr<CategorizeTask>> tasks;
+    for (uint32_t begin = rangeSize; begin < numProxies; begin += rangeSize) {
+        tasks.emplace_back(new CategorizeTask(*this, begin, std::min(begin + rangeSize, numProxies)));
+        _threadPool->start(tasks.back().get());
+    }
+    categorizeAndGetChanges(0, std::min(rangeSize, numProxies), changes);
+    _threadPool->waitForDone();
+
+    for (auto& task : tasks) {
+        changes.insert(changes.end(), task->changes.begin(), task->changes.end());
+    }
+}
+
+void Space::categorizeAndGetChanges(uint32_t begin, uint32_t end, std::vector<Space::Change>& changes) {
+    uint32_t numViews = (uint32_t)_views.size();
+    uint8_t regions[CATEGORIZE_BLOCK_SIZE];
+    for (uint32_t blockBegin = begin; blockBegin < end; blockBegin += CATEGORIZE_BLOCK_SIZE) {
+        uint32_t blockEnd = std::min(blockBegin + CATEGORIZE_BLOCK_SIZE, end);
+
+        // the ranges start at multiples of the block size, so the padding of the last one is within the arrays
+        uint32_t numClassified = roundUp(blockEnd - blockBegin, PROXY_PADDING);
+        classifyProxies(&_centerX[blockBegin], &_centerY[blockBegin], &_centerZ[blockBegin], &_radiuses[blockBegin],
+                        numClassified, _views.data(), numViews, regions);
+
+        for (uint32_t i = blockBegin; i < blockEnd; ++i) {
+            if (_regions[i] < Space::REGION_INVALID) {
+                uint8_t region = regions[i - blockBegin];
+                _prevRegions[i] = _regions[i];
+                _regions[i] = region;
+                if (region != _prevRegions[i]) {
+                    changes.emplace_back(Space::Change((int32_t)i, region, _prevRegions[i]));
+                }
+            }
+        }
+    }
+}
+
+void Space::categorizeProxiesAndGetChanges(const std::vector<int32_t>& proxyIds, std::vector<Space::Change>& changes) {
+    _numCategorized += (uint32_t)proxyIds.size();
+    uint32_t numViews = (uint32_t)_views.size();
+    float centerX[CATEGORIZE_BLOCK_SIZE];
+    float centerY[CATEGORIZE_BLOCK_SIZE];
+    float centerZ[CATEGORIZE_BLOCK_SIZE];
+    float radiuses[CATEGORIZE_BLOCK_SIZE];
+    uint8_t regions[CATEGORIZE_BLOCK_SIZE];
+    uint32_t numProxyIds = (uint32_t)proxyIds.size();
+    for (uint32_t blockBegin = 0; blockBegin < numProxyIds; blockBegin += CATEGORIZE_BLOCK_SIZE) {
+        uint32_t blockSize = std::min(CATEGORIZE_BLOCK_SIZE, numProxyIds - blockBegin);
+        uint32_t numClassified = roundUp(blockSize, PROXY_PADDING);
+        for (uint32_t i = 0; i < numClassified; ++i) {
+            int32_t proxyId = i < blockSize ? proxyIds[blockBegin + i] : proxyIds[blockBegin];
+            centerX[i] = _centerX[proxyId];
+            centerY[i] = _centerY[proxyId];
+            centerZ[i] = _centerZ[proxyId];
+            radiuses[i] = _radiuses[proxyId];
+        }
+        classifyProxies(centerX, centerY, centerZ, radiuses, numClassified, _views.data(), numViews, regions);
+
+        for (uint32_t i = 0; i < blockSize; ++i) {
+            int32_t proxyId = proxyIds[blockBegin + i];
+            if (_regions[proxyId] < Space::REGION_INVALID) {
+                uint8_t region = regions[i];
+                _prevRegions[proxyId] = _regions[proxyId];
+                _regions[proxyId] = region;
+                if (region != _prevRegions[proxyId]) {
+                    changes.emplace_back(Space::Change(proxyId, region, _prevRegions[proxyId]));
+                }
+            }
+        }
+    }
+}
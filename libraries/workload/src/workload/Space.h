@@ -15,9 +15,13 @@
 #ifndef hifi_workload_Space_h
 #define hifi_workload_Space_h
 
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <glm/glm.hpp>
 
+class QThreadPool;
+
 namespace workload {
 
 class Space {
@@ -28,15 +32,19 @@ public:
     static const uint8_t REGION_UNKNOWN = 3;
     static const uint8_t REGION_INVALID = 4;
 
-    using Sphere = glm::vec4; // <x,y,z> = center, w = radius
+    // the proxy arrays are padded to a multiple of this, the most that are classified at a time (by AVX512)
+    static const uint32_t PROXY_PADDING = 16;
 
-    class Proxy {
-    public:
-        Proxy(const Sphere& s) : sphere(s) {}
-        Sphere sphere;
-        uint8_t region { REGION_UNKNOWN };
-        uint8_t prevRegion { REGION_UNKNOWN };
-    };
+    // categorizeAllAndGetChanges is split across threads when there are at least this many proxies per thread
+    static const uint32_t MIN_PROXIES_PER_THREAD = 32 * 1024;
+
+    // the width of the cells of the grid the proxies are sorted into, by their centers
+    static const float CELL_SIZE;
+
+    // the width of the blocks of cells of the grid, in cells
+    static const uint32_t BLOCK_WIDTH = 4;
+
+    using Sphere = glm::vec4; // <x,y,z> = center, w = radius
 
     class View {
     public:
@@ -57,21 +65,123 @@ public:
         uint8_t prevRegion { 0 };
     };
 
-    Space() {}
+    Space();
+    ~Space();
 
     int32_t createProxy(const Sphere& sphere);
     void deleteProxy(int32_t proxyId);
     void updateProxy(int32_t proxyId, const Sphere& sphere);
     void setViews(const std::vector<View>& views);
 
-    uint32_t getNumObjects() const { return (uint32_t)(_proxies.size() - _freeIndices.size()); }
+    uint32_t getNumObjects() const { return (uint32_t)(_regions.size() - _freeIndices.size()); }
 
+    // Only the proxies that moved, and those in the cells of the grid that the views moved the edge of a region through,
+    // are categorized again, unless that is many of them. The changes are the same as those of
+    // categorizeAllAndGetChanges, and in order of proxyId.
     void categorizeAndGetChanges(std::vector<Change>& changes);
 
+    // Categorize every proxy, as a reference for categorizeAndGetChanges. The changes are in order of proxyId, however
+    // many threads the proxies are categorized on.
+    void categorizeAllAndGetChanges(std::vector<Change>& changes);
+
+    // the number of proxies the last categorization looked at, including deleted ones when it looked at every proxy
+    uint32_t getNumCategorized() const { return _numCategorized; }
+
 private:
-    std::vector<Proxy> _proxies;
+    class CategorizeTask;
+
+    // the bounds of the spheres of the proxies in a cell or a block of the grid, which only grow until the proxies are
+    // all categorized again
+    class Bounds {
+    public:
+        void clear();
+        bool expand(const Sphere& sphere); // returns whether the bounds grew
+        void expand(const Bounds& bounds);
+        bool isEmpty() const { return minRadius > maxRadius; }
+
+        // the region of every proxy within the bounds if the views put them all in the same one, else REGION_INVALID
+        uint8_t findRegion(const std::vector<View>& views) const;
+
+        glm::vec3 minCenter;
+        glm::vec3 maxCenter;
+        float minRadius;
+        float maxRadius;
+        uint8_t region; // as found for the views of the last categorization
+    };
+
+    // the proxies whose centers are in a cell of the grid
+    class Cell {
+    public:
+        uint64_t key;
+        uint32_t block;
+        std::vector<int32_t> proxies;
+        Bounds bounds;
+        bool loose { false }; // proxies have left since the bounds were found
+    };
+
+    // the cells of the grid are in blocks of BLOCK_WIDTH^3, so that only the blocks that the edges of the regions of the
+    // views pass through are looked into
+    class Block {
+    public:
+        std::vector<uint32_t> cells;
+        Bounds bounds;
+    };
+
+    void categorizeEveryProxyAndGetChanges(std::vector<Change>& changes);
+
+    // categorize the proxies in [begin, end) and append their changes, in order
+    void categorizeAndGetChanges(uint32_t begin, uint32_t end, std::vector<Change>& changes);
+
+    // categorize the proxies, in the order given, and append their changes
+    void categorizeProxiesAndGetChanges(const std::vector<int32_t>& proxyIds, std::vector<Change>& changes);
+
+    void resizeProxies(uint32_t numProxies);
+    void setSphere(int32_t proxyId, const Sphere& sphere);
+    Sphere getSphere(int32_t proxyId) const;
+    void markDirty(int32_t proxyId);
+
+    // move the proxies created or updated since the last categorization to the cells their centers are in now, and
+    // append them to movedProxies
+    void updateCells(std::vector<int32_t>& movedProxies);
+    uint32_t findOrCreateCell(uint64_t key);
+    void moveToCell(int32_t proxyId);
+    void removeFromCell(int32_t proxyId);
+
+    // append the proxies that the change of views could have moved to another region to proxyIds, and find the regions
+    // of the grid for the views, giving up and returning false once there are more than maxProxyIds
+    bool findProxiesInChangedCells(std::vector<int32_t>& proxyIds, uint32_t maxProxyIds);
+
+    // find the regions of every cell and block of the grid, once the proxies are all categorized for the views
+    void findGridRegions();
+
+    // the proxies, a component per array so that they can be classified several at a time
+    std::vector<float> _centerX;
+    std::vector<float> _centerY;
+    std::vector<float> _centerZ;
+    std::vector<float> _radiuses;
+    std::vector<uint8_t> _regions;
+    std::vector<uint8_t> _prevRegions;
+
     std::vector<View> _views;
     std::vector<int32_t> _freeIndices;
+
+    // the grid, of only the cells proxies have been in
+    std::vector<Cell> _cells;
+    std::vector<Block> _blocks;
+    std::unordered_map<uint64_t, uint32_t> _cellIndices; // by the coordinates of the cell
+    std::unordered_map<uint64_t, uint32_t> _blockIndices; // by the coordinates of the block
+    std::vector<uint32_t> _proxyCells; // the index of the cell of each proxy, if it has one yet
+    std::vector<uint32_t> _proxyCellSlots; // where each proxy is in the list of its cell
+
+    std::vector<int32_t> _dirtyProxies; // created or updated since the last categorization
+    std::vector<uint8_t> _dirtyFlags;
+    std::vector<uint8_t> _categorizeFlags; // for putting the proxies to categorize in order
+    std::vector<View> _categorizedViews; // the views as of the last categorization
+    bool _viewsChanged { false };
+    bool _gridRegionsFound { true }; // the regions of the cells and blocks are of _categorizedViews
+    uint32_t _numCategorized { 0 };
+
+    std::unique_ptr<QThreadPool> _threadPool; // created for the first categorizeAllAndGetChanges that is split
 };
 
 } // namespace workload
@@ -0,0 +1,58 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <AudioHRTF.h>
+
+QTEST_MAIN(AudioHRTFTests)
+
+static const int HRTF_INDEX = 1;
+
+void AudioHRTFTests::fadeOutFromLastParameters() {
+    AudioHRTF hrtf;
+    AudioHRTF otherHRTF;
+    float azimuth = 1.0f;
+    float distance = 2.5f;
+    float gain = 0.8f;
+
+    std::vector<int16_t> input(HRTF_BLOCK);
+    for (int i = 0; i < HRTF_BLOCK; ++i) {
+        input[i] = (int16_t)(8000.0f * sinf(0.1f * (float)i));
+    }
+    float output[2 * HRTF_BLOCK] = {};
+    hrtf.render(input.data(), output, HRTF_INDEX, azimuth, distance, gain, HRTF_BLOCK);
+    otherHRTF.render(input.data(), output, HRTF_INDEX, azimuth, distance, gain, HRTF_BLOCK);
+
+    // a fade out is a silent block crossfaded to zero gain, at the last azimuth and distance
+    std::vector<int16_t> silentInput(HRTF_BLOCK, 0);
+    float fadeOutput[2 * HRTF_BLOCK] = {};
+    float silentOutput[2 * HRTF_BLOCK] = {};
+    hrtf.renderFadeOut(fadeOutput, HRTF_INDEX, HRTF_BLOCK);
+    otherHRTF.renderSilent(silentInput.data(), silentOutput, HRTF_INDEX, azimuth, distance, 0.0f, HRTF_BLOCK);
+    float maxOutput = 0.0f;
+    for (int j = 0; j < 2 * HRTF_BLOCK; ++j) {
+        QCOMPARE(fadeOutput[j], silentOutput[j]);
+        maxOutput = std::max(maxOutput, fabsf(fadeOutput[j]));
+    }
+    QVERIFY(maxOutput > 0.0f);
+
+    // and once faded out, nothing more is rendered
+    float nextOutput[2 * HRTF_BLOCK] = {};
+    hrtf.renderFadeOut(nextOutput, HRTF_INDEX, HRTF_BLOCK);
+    for (int j = 0; j < 2 * HRTF_BLOCK; ++j) {
+        QCOMPARE(nextOutput[j], 0.0f);
+    }
+}
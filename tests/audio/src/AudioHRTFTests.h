@@ -0,0 +1,23 @@
+//
+//  AudioHRTFTests.h
+//  tests/audio/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioHRTFTests_h
+#define hifi_AudioHRTFTests_h
+
+#include <QtTest/QtTest>
+
+class AudioHRTFTests : public QObject {
+    Q_OBJECT
+private slots:
+    void fadeOutFromLastParameters();
+};
+
+#endif // hifi_AudioHRTFTests_h
@@ -0,0 +1,206 @@
+//
+//  HMACAuthTests.cpp
+//  tests/networking/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HMACAuthTests.h"
+
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <HMACAuth.h>
+#include <NLPacket.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(HMACAuthTests)
+
+static const int DATA_SIZE = 500;
+
+static QByteArray testData() {
+    QByteArray data(DATA_SIZE, 0);
+    for (int i = 0; i < DATA_SIZE; ++i) {
+        data[i] = (char)i;
+    }
+    return data;
+}
+
+static HMACAuth::HMACHash hashOnThread(HMACAuth& auth, const QByteArray& data) {
+    HMACAuth::HMACHash hash;
+    std::thread hasher([&] {
+        auth.calculateHash(hash, data.constData(), data.size());
+    });
+    hasher.join();
+    return hash;
+}
+
+void HMACAuthTests::threadContextTest() {
+    HMACAuth auth;
+    auth.setKey(QUuid::createUuid());
+    auto data = testData();
+
+    auth.addData(data.constData(), data.size());
+    auto expected = auth.result();
+    QCOMPARE((int)expected.size(), NUM_BYTES_MD5_HASH);
+
+    HMACAuth::HMACHash hash;
+    QVERIFY(auth.calculateHash(hash, data.constData(), data.size()));
+    QVERIFY(hash == expected);
+
+    // hashing again on the same thread starts from the key, not from the previous hash
+    QVERIFY(auth.calculateHash(hash, data.constData(), data.size()));
+    QVERIFY(hash == expected);
+
+    QVERIFY(hashOnThread(auth, data) == expected);
+}
+
+void HMACAuthTests::rekeyTest() {
+    HMACAuth auth;
+    auth.setKey(QUuid::createUuid());
+    auto data = testData();
+
+    HMACAuth::HMACHash firstHash;
+    auth.calculateHash(firstHash, data.constData(), data.size());
+
+    auth.setKey(QUuid::createUuid());
+    HMACAuth::HMACHash secondHash;
+    auth.calculateHash(secondHash, data.constData(), data.size());
+    QVERIFY(secondHash != firstHash);
+    QVERIFY(hashOnThread(auth, data) == secondHash);
+
+    // a new instance in the place of a deleted one never gets its contexts
+    auto deleted = new HMACAuth();
+    deleted->setKey(QUuid::createUuid());
+    deleted->calculateHash(firstHash, data.constData(), data.size());
+    delete deleted;
+
+    auto replacement = new HMACAuth();
+    auto key = QUuid::createUuid();
+    replacement->setKey(key);
+    replacement->calculateHash(secondHash, data.constData(), data.size());
+
+    HMACAuth reference;
+    reference.setKey(key);
+    reference.addData(data.constData(), data.size());
+    QVERIFY(secondHash == reference.result());
+    delete replacement;
+}
+
+void HMACAuthTests::sipHashTest() {
+    HMACAuth auth(HMACAuth::SIPHASH);
+    char key[16];
+    for (int i = 0; i < 16; ++i) {
+        key[i] = (char)i;
+    }
+    auth.setKey(key, sizeof(key));
+
+    // the first two 128 bit vectors of the reference implementation, for key 00 01 .. 0f
+    const unsigned char EMPTY_HASH[] = {
+        0xa3, 0x81, 0x7f, 0x04, 0xba, 0x25, 0xa8, 0xe6, 0x6d, 0xf6, 0x72, 0x14, 0xc7, 0x55, 0x02, 0x93
+    };
+    const unsigned char ONE_BYTE_HASH[] = {
+        0xda, 0x87, 0xc1, 0xd8, 0x6b, 0x99, 0xaf, 0x44, 0x34, 0x76, 0x59, 0x11, 0x9b, 0x22, 0xfc, 0x45
+    };
+
+    HMACAuth::HMACHash hash;
+    const char message[] = { 0 };
+    QVERIFY(auth.calculateHash(hash, message, 0));
+    QVERIFY(hash == HMACAuth::HMACHash(EMPTY_HASH, EMPTY_HASH + sizeof(EMPTY_HASH)));
+    QVERIFY(auth.calculateHash(hash, message, 1));
+    QVERIFY(hash == HMACAuth::HMACHash(ONE_BYTE_HASH, ONE_BYTE_HASH + sizeof(ONE_BYTE_HASH)));
+
+    auto data = testData();
+    auth.addData(data.constData(), DATA_SIZE / 2);
+    auth.addData(data.constData() + DATA_SIZE / 2, DATA_SIZE - DATA_SIZE / 2);
+    QVERIFY(hashOnThread(auth, data) == auth.result());
+}
+
+void HMACAuthTests::packetVerificationTest() {
+    auto key = QUuid::createUuid();
+
+    for (auto method : { HMACAuth::MD5, HMACAuth::SIPHASH }) {
+        HMACAuth sender(method);
+        sender.setKey(key);
+        HMACAuth receiver(method);
+        receiver.setKey(key);
+
+        auto packet = NLPacket::create(PacketType::MicrophoneAudioNoEcho);
+        packet->write(testData());
+        packet->writeVerificationHash(sender);
+
+        QCOMPARE(NLPacket::verificationHashInHeader(*packet), NLPacket::hashForPacketAndHMAC(*packet, receiver));
+    }
+}
+
+#ifdef MANUAL_TEST
+
+// verify the same packet from a number of threads, as the mixer slaves do for the packets of a node
+template <typename Verify>
+uint64_t timeVerify(int numThreads, int numPackets, Verify verify) {
+    uint64_t startTime = usecTimestampNow();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < numPackets / numThreads; ++j) {
+                verify();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return usecTimestampNow() - startTime;
+}
+
+void HMACAuthTests::benchmark() {
+    const int NUM_PACKETS = 1000000;
+    int numThreads[] = { 1, 2, 4, 8, 16 };
+
+    auto key = QUuid::createUuid();
+    auto packet = NLPacket::create(PacketType::MicrophoneAudioNoEcho);
+    packet->write(testData());
+
+    HMACAuth lockedAuth;
+    lockedAuth.setKey(key);
+    HMACAuth md5Auth;
+    md5Auth.setKey(key);
+    HMACAuth sipAuth(HMACAuth::SIPHASH);
+    sipAuth.setKey(key);
+    std::mutex lockedMutex;
+
+    std::cout << "[numThreads, lockedMD5 (packets/sec), threadMD5 (packets/sec), threadSipHash (packets/sec)] = ["
+        << std::endl;
+    for (int n : numThreads) {
+        // the shared context behind one lock, as every packet was verified before
+        uint64_t lockedUsecs = timeVerify(n, NUM_PACKETS, [&] {
+            std::lock_guard<std::mutex> lock(lockedMutex);
+            lockedAuth.addData(packet->getData(), packet->getDataSize());
+            lockedAuth.result();
+        });
+
+        uint64_t md5Usecs = timeVerify(n, NUM_PACKETS, [&] {
+            NLPacket::hashForPacketAndHMAC(*packet, md5Auth);
+        });
+
+        uint64_t sipUsecs = timeVerify(n, NUM_PACKETS, [&] {
+            NLPacket::hashForPacketAndHMAC(*packet, sipAuth);
+        });
+
+        std::cout << "    " << n << ", "
+            << (uint64_t)NUM_PACKETS * USECS_PER_SECOND / lockedUsecs << ", "
+            << (uint64_t)NUM_PACKETS * USECS_PER_SECOND / md5Usecs << ", "
+            << (uint64_t)NUM_PACKETS * USECS_PER_SECOND / sipUsecs << ";" << std::endl;
+    }
+    std::cout << "];" << std::endl;
+}
+
+#endif // MANUAL_TEST
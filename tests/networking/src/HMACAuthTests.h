@@ -0,0 +1,41 @@
+//
+//  HMACAuthTests.h
+//  tests/networking/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HMACAuthTests_h
+#define hifi_HMACAuthTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class HMACAuthTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that hashes calculated on other threads match the hash of the shared context
+    void threadContextTest();
+
+    // Test that other threads pick up a new key
+    void rekeyTest();
+
+    // Test SipHash against the reference test vectors
+    void sipHashTest();
+
+    // Test that a packet signed with either method verifies
+    void packetVerificationTest();
+
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_HMACAuthTests_h
@@ -0,0 +1,159 @@
+//
+//  PacketBufferPoolTests.cpp
+//  tests/networking/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPoolTests.h"
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <NLPacket.h>
+#include <SharedUtil.h>
+#include <udt/PacketBufferPool.h>
+
+QTEST_MAIN(PacketBufferPoolTests)
+
+using udt::PacketBuffer;
+using udt::PacketBufferPool;
+
+void PacketBufferPoolTests::reuseTest() {
+    PacketBufferPool::resetStats();
+
+    auto buffer = PacketBufferPool::allocate(udt::MAX_PACKET_SIZE);
+    char* data = buffer.get();
+    buffer.reset();
+
+    buffer = PacketBufferPool::allocate(udt::MAX_PACKET_SIZE);
+    QCOMPARE(buffer.get(), data);
+
+    auto stats = PacketBufferPool::getStats();
+    QCOMPARE(stats.hits, (uint64_t)1);
+
+    // packets get their buffers from the pool too
+    buffer.reset();
+    auto packet = NLPacket::create(PacketType::MixedAudio);
+    QCOMPARE(packet->getData(), data);
+}
+
+void PacketBufferPoolTests::crossThreadTest() {
+    const int NUM_BUFFERS = 1000;
+
+    std::vector<PacketBuffer> buffers;
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        buffers.push_back(PacketBufferPool::allocate(udt::MAX_PACKET_SIZE));
+    }
+
+    // release every buffer on another thread, as the socket thread's buffers are released by the mixers
+    std::thread releaser([&] {
+        buffers.clear();
+    });
+    releaser.join();
+
+    PacketBufferPool::resetStats();
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        buffers.push_back(PacketBufferPool::allocate(udt::MAX_PACKET_SIZE));
+    }
+
+    auto stats = PacketBufferPool::getStats();
+    QCOMPARE(stats.misses, (uint64_t)0);
+    QCOMPARE(stats.hits, (uint64_t)NUM_BUFFERS);
+}
+
+void PacketBufferPoolTests::oversizedTest() {
+    PacketBufferPool::resetStats();
+
+    const int OVERSIZED = 4 * PacketBufferPool::MAX_BUFFER_SIZE;
+    auto buffer = PacketBufferPool::allocate(OVERSIZED);
+    memset(buffer.get(), 1, OVERSIZED);
+
+    auto stats = PacketBufferPool::getStats();
+    QCOMPARE(stats.oversized, (uint64_t)1);
+    QCOMPARE(stats.hits + stats.misses, (uint64_t)0);
+
+    // buffers allocated outside of the pool are still accepted
+    PacketBuffer heapBuffer = std::unique_ptr<char[]>(new char[OVERSIZED]);
+    QVERIFY(heapBuffer.get() != nullptr);
+}
+
+#ifdef MANUAL_TEST
+
+// allocate buffers on one thread and release them on another, like received packets
+template <typename Allocate>
+uint64_t timeHandoff(int numThreads, int numBuffers, Allocate allocate) {
+    uint64_t startTime = usecTimestampNow();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&] {
+            std::vector<decltype(allocate())> buffers;
+            buffers.reserve(numBuffers);
+            for (int j = 0; j < numBuffers; ++j) {
+                buffers.push_back(allocate());
+                buffers.back()[0] = (char)j;
+            }
+
+            std::thread releaser([&] {
+                buffers.clear();
+            });
+            releaser.join();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return usecTimestampNow() - startTime;
+}
+
+void PacketBufferPoolTests::benchmark() {
+    const int NUM_PACKETS = 1000000;
+    const int HANDOFF_BUFFERS = 10000;
+    const int NUM_HANDOFFS = 100;
+    int numThreads[] = { 1, 2, 4, 8 };
+
+    std::cout << "[numThreads, createPackets (usec), handoffHeap (usec), handoffPool (usec)] = [" << std::endl;
+    for (int n : numThreads) {
+        // create and send packets, as the mixer slaves do every frame
+        uint64_t startTime = usecTimestampNow();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < n; ++i) {
+            threads.emplace_back([&] {
+                for (int j = 0; j < NUM_PACKETS / n; ++j) {
+                    auto packet = NLPacket::create(PacketType::MixedAudio);
+                    packet->writePrimitive(j);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        uint64_t createUsecs = usecTimestampNow() - startTime;
+
+        uint64_t heapUsecs = 0;
+        uint64_t poolUsecs = 0;
+        for (int i = 0; i < NUM_HANDOFFS; ++i) {
+            heapUsecs += timeHandoff(n, HANDOFF_BUFFERS, [] {
+                return std::unique_ptr<char[]>(new char[udt::MAX_PACKET_SIZE]);
+            });
+            poolUsecs += timeHandoff(n, HANDOFF_BUFFERS, [] {
+                return PacketBufferPool::allocate(udt::MAX_PACKET_SIZE);
+            });
+        }
+
+        std::cout << "    " << n << ", " << createUsecs << ", " << heapUsecs << ", " << poolUsecs << std::endl;
+    }
+    std::cout << "];" << std::endl;
+
+    auto stats = PacketBufferPool::getStats();
+    std::cout << "pool hits " << stats.hits << ", misses " << stats.misses << std::endl;
+}
+
+#endif // MANUAL_TEST
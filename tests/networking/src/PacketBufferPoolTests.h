@@ -0,0 +1,38 @@
+//
+//  PacketBufferPoolTests.h
+//  tests/networking/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketBufferPoolTests_h
+#define hifi_PacketBufferPoolTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class PacketBufferPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that released buffers are reused by the same thread
+    void reuseTest();
+
+    // Test that buffers released on another thread find their way back
+    void crossThreadTest();
+
+    // Test that buffers too large for the pool still work
+    void oversizedTest();
+
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_PacketBufferPoolTests_h
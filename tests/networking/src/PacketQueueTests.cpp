@@ -0,0 +1,181 @@
+//
+//  PacketQueueTests.cpp
+//  tests/networking/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketQueueTests.h"
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <SharedUtil.h>
+#include <udt/PacketList.h>
+#include <udt/PacketQueue.h>
+
+QTEST_MAIN(PacketQueueTests)
+
+using namespace udt;
+
+static std::unique_ptr<Packet> createPacket(int value) {
+    auto packet = Packet::create();
+    packet->writePrimitive(value);
+    return packet;
+}
+
+static std::unique_ptr<PacketList> createPacketList(int firstValue, int numPackets, bool isOrdered = false) {
+    auto packetList = PacketList::create(PacketType::Unknown, QByteArray(), isOrdered, isOrdered);
+    for (int i = 0; i < numPackets; ++i) {
+        packetList->writePrimitive(firstValue + i);
+        packetList->closeCurrentPacket();
+    }
+    return packetList;
+}
+
+static int valueOf(const Packet& packet) {
+    return *reinterpret_cast<const int*>(packet.getPayload());
+}
+
+void PacketQueueTests::roundRobinTest() {
+    PacketQueue queue;
+    QVERIFY(queue.isEmpty());
+
+    queue.queuePacketList(createPacketList(10, 3));
+    queue.queuePacketList(createPacketList(20, 3));
+    queue.queuePacket(createPacket(1));
+
+    std::vector<int> values;
+    while (auto packet = queue.takePacket()) {
+        values.push_back(valueOf(*packet));
+    }
+
+    std::vector<int> expected { 10, 20, 1, 11, 21, 12, 22 };
+    QCOMPARE(values, expected);
+    QVERIFY(queue.isEmpty());
+}
+
+void PacketQueueTests::messageNumberTest() {
+    const MessageNumber FIRST_MESSAGE_NUMBER = 41;
+    PacketQueue queue(FIRST_MESSAGE_NUMBER);
+
+    queue.queuePacketList(createPacketList(0, 2, true));
+    queue.queuePacketList(createPacketList(0, 2, true));
+    QCOMPARE(queue.getCurrentMessageNumber(), FIRST_MESSAGE_NUMBER + 2);
+
+    std::vector<MessageNumber> messageNumbers;
+    while (auto packet = queue.takePacket()) {
+        messageNumbers.push_back(packet->getMessageNumber());
+    }
+
+    std::vector<MessageNumber> expected { 42, 43, 42, 43 };
+    QCOMPARE(messageNumbers, expected);
+}
+
+void PacketQueueTests::multipleProducersTest() {
+    const int NUM_PRODUCERS = 4;
+    const int NUM_PACKETS = 10000;
+    const int LIST_INTERVAL = 100;
+    const int PACKETS_PER_LIST = 3;
+
+    PacketQueue queue;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        producers.emplace_back([&queue, producer] {
+            for (int i = 0; i < NUM_PACKETS; ++i) {
+                if (i % LIST_INTERVAL == 0) {
+                    // packet lists carry negative values, they only compete for the send slots
+                    queue.queuePacketList(createPacketList(-PACKETS_PER_LIST - 1, PACKETS_PER_LIST));
+                } else {
+                    queue.queuePacket(createPacket(producer * NUM_PACKETS + i));
+                }
+            }
+        });
+    }
+
+    int numExpected = NUM_PRODUCERS * (NUM_PACKETS + (NUM_PACKETS / LIST_INTERVAL) * (PACKETS_PER_LIST - 1));
+    int numTaken = 0;
+    std::vector<int> lastValues(NUM_PRODUCERS, -1);
+    bool isOrdered = true;
+
+    while (numTaken < numExpected) {
+        auto packet = queue.takePacket();
+        if (!packet) {
+            std::this_thread::yield();
+            continue;
+        }
+        ++numTaken;
+
+        int value = valueOf(*packet);
+        if (value >= 0) {
+            int producer = value / NUM_PACKETS;
+            isOrdered = isOrdered && value > lastValues[producer];
+            lastValues[producer] = value;
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    QVERIFY(isOrdered);
+    QVERIFY(queue.isEmpty());
+}
+
+#ifdef MANUAL_TEST
+
+void PacketQueueTests::benchmark() {
+    const int NUM_PACKETS = 1000000;
+    int numProducers[] = { 1, 2, 4, 8 };
+
+    std::cout << "[numProducers, timeToQueueAndTakeAll (usec), producerUsecsPerPacket] = [" << std::endl;
+    for (int n : numProducers) {
+        PacketQueue queue;
+
+        // build the packets up front, so that we only measure the queue
+        std::vector<std::vector<std::unique_ptr<Packet>>> packets(n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < NUM_PACKETS / n; ++j) {
+                packets[i].push_back(Packet::create(0));
+            }
+        }
+
+        std::atomic<uint64_t> producerUsecs { 0 };
+        uint64_t startTime = usecTimestampNow();
+
+        std::vector<std::thread> producers;
+        for (int i = 0; i < n; ++i) {
+            producers.emplace_back([&, i] {
+                uint64_t producerStart = usecTimestampNow();
+                for (auto& packet : packets[i]) {
+                    queue.queuePacket(std::move(packet));
+                }
+                producerUsecs += usecTimestampNow() - producerStart;
+            });
+        }
+
+        int numTaken = 0;
+        int numExpected = n * (NUM_PACKETS / n);
+        while (numTaken < numExpected) {
+            if (queue.takePacket()) {
+                ++numTaken;
+            }
+        }
+
+        uint64_t usecs = usecTimestampNow() - startTime;
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        std::cout << "    " << n << ", " << usecs << ", " << (double)producerUsecs / numExpected << std::endl;
+    }
+    std::cout << "];" << std::endl;
+}
+
+#endif // MANUAL_TEST
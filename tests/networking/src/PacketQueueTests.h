@@ -0,0 +1,38 @@
+//
+//  PacketQueueTests.h
+//  tests/networking/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketQueueTests_h
+#define hifi_PacketQueueTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class PacketQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that packet lists are taken round-robin
+    void roundRobinTest();
+
+    // Test that ordered packet lists get consecutive message numbers
+    void messageNumberTest();
+
+    // Test that packets from concurrent producers are all taken, in order per producer
+    void multipleProducersTest();
+
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_PacketQueueTests_h
@@ -0,0 +1,157 @@
+//
+//  SendSchedulerTests.cpp
+//  tests/networking/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendSchedulerTests.h"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <udt/SendScheduler.h>
+
+QTEST_MAIN(SendSchedulerTests)
+
+using namespace udt;
+
+using time_point = SendScheduler::time_point;
+
+// long enough for the send thread to get to what the test waits for, short enough to fail quickly if it never does
+static const std::chrono::seconds TIMEOUT { 5 };
+
+void SendSchedulerTests::wakeWhileBusyTest() {
+    std::promise<void> isBusy;
+    std::promise<void> canReturn;
+    std::promise<void> isServicedAgain;
+    auto canReturnFuture = canReturn.get_future();
+    std::atomic<int> numServices { 0 };
+
+    SendScheduler::Task task;
+    task.service = [&](bool& isWaiting) {
+        if (++numServices == 1) {
+            isBusy.set_value();
+            canReturnFuture.wait();
+
+            // wait for an event, far longer than the test waits
+            isWaiting = true;
+            return p_high_resolution_clock::now() + std::chrono::minutes(1);
+        }
+
+        isServicedAgain.set_value();
+        return time_point::max();
+    };
+
+    SendScheduler scheduler(1);
+    scheduler.add(task);
+
+    QVERIFY(isBusy.get_future().wait_for(TIMEOUT) == std::future_status::ready);
+
+    // the wake up comes before the queue decides to wait, it must not be lost
+    scheduler.wake(task);
+    canReturn.set_value();
+
+    QVERIFY(isServicedAgain.get_future().wait_for(TIMEOUT) == std::future_status::ready);
+    QCOMPARE(numServices.load(), 2);
+
+    scheduler.remove(task);
+}
+
+void SendSchedulerTests::removeWhileBusyTest() {
+    std::promise<void> isBusy;
+    std::promise<void> canReturn;
+    auto canReturnFuture = canReturn.get_future();
+    std::atomic<int> numServices { 0 };
+    std::atomic<bool> hasReturned { false };
+
+    SendScheduler::Task task;
+    task.service = [&](bool&) {
+        if (++numServices == 1) {
+            isBusy.set_value();
+            canReturnFuture.wait();
+        }
+
+        hasReturned = true;
+
+        // due again right away, unless it was removed
+        return p_high_resolution_clock::now();
+    };
+
+    SendScheduler scheduler(2);
+    scheduler.add(task);
+
+    QVERIFY(isBusy.get_future().wait_for(TIMEOUT) == std::future_status::ready);
+
+    std::atomic<bool> isRemoved { false };
+    bool hadReturnedWhenRemoved = false;
+    std::thread remover([&] {
+        scheduler.remove(task);
+        hadReturnedWhenRemoved = hasReturned;
+        isRemoved = true;
+    });
+
+    // remove can't return while a send thread is servicing the queue
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    bool wasRemovedWhileBusy = isRemoved;
+
+    canReturn.set_value();
+    remover.join();
+
+    QVERIFY(!wasRemovedWhileBusy);
+    QVERIFY(isRemoved);
+    QVERIFY(hadReturnedWhenRemoved);
+
+    // the time it returned has come, but a removed queue is never looked at again
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    QCOMPARE(numServices.load(), 1);
+}
+
+void SendSchedulerTests::pacingTest() {
+    const std::chrono::milliseconds SEND_PERIOD { 20 };
+    const size_t NUM_SERVICES = 5;
+
+    std::mutex mutex;
+    std::vector<time_point> serviceTimes;
+    std::promise<void> isDone;
+
+    SendScheduler::Task task;
+    task.service = [&](bool&) {
+        auto now = p_high_resolution_clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        serviceTimes.push_back(now);
+        if (serviceTimes.size() == NUM_SERVICES) {
+            isDone.set_value();
+            return time_point::max();
+        }
+
+        return now + SEND_PERIOD;
+    };
+
+    SendScheduler scheduler(2);
+    scheduler.add(task);
+
+    // a paced queue isn't waiting for an event, so waking it up does nothing
+    auto doneFuture = isDone.get_future();
+    auto giveUpTime = p_high_resolution_clock::now() + TIMEOUT;
+    while (doneFuture.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+        scheduler.wake(task);
+        QVERIFY(p_high_resolution_clock::now() < giveUpTime);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    QCOMPARE(serviceTimes.size(), NUM_SERVICES);
+    for (size_t i = 1; i < serviceTimes.size(); ++i) {
+        QVERIFY(serviceTimes[i] - serviceTimes[i - 1] >= SEND_PERIOD);
+    }
+
+    scheduler.remove(task);
+}
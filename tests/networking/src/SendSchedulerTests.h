@@ -0,0 +1,32 @@
+//
+//  SendSchedulerTests.h
+//  tests/networking/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendSchedulerTests_h
+#define hifi_SendSchedulerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SendSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a queue woken up while it is being serviced is serviced again when it decides to wait
+    void wakeWhileBusyTest();
+
+    // Test that removing a queue waits for its service to be done, and that it isn't serviced again
+    void removeWhileBusyTest();
+
+    // Test that a paced queue is never serviced before its time, even when woken up
+    void pacingTest();
+};
+
+#endif // hifi_SendSchedulerTests_h
@@ -0,0 +1,180 @@
+//
+//  EntityBulkQueryTests.cpp
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBulkQueryTests.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <EntityBulkQuery.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityBulkQueryTests)
+
+const float WORLD_SIZE = 200.0f;
+
+static EntityTreePointer createTree(int numEntities) {
+    auto tree = createServerTree();
+    tree->withWriteLock([&] {
+        for (int i = 0; i < numEntities; ++i) {
+            EntityItemProperties properties;
+            properties.setType(i % 2 ? EntityTypes::Box : EntityTypes::Sphere);
+            properties.setPosition(glm::vec3(randFloatInRange(-WORLD_SIZE, WORLD_SIZE), randFloatInRange(-WORLD_SIZE, WORLD_SIZE),
+                                             randFloatInRange(-WORLD_SIZE, WORLD_SIZE)));
+            properties.setDimensions(glm::vec3(randFloatInRange(0.1f, 10.0f), randFloatInRange(0.1f, 10.0f),
+                                               randFloatInRange(0.1f, 10.0f)));
+            tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        }
+    });
+    return tree;
+}
+
+static glm::vec3 randPosition() {
+    return glm::vec3(randFloatInRange(-WORLD_SIZE, WORLD_SIZE), randFloatInRange(-WORLD_SIZE, WORLD_SIZE),
+                     randFloatInRange(-WORLD_SIZE, WORLD_SIZE));
+}
+
+static ViewFrustum randFrustum() {
+    ViewFrustum frustum;
+    frustum.setPosition(randPosition());
+    frustum.setOrientation(glm::angleAxis(randFloatInRange(0.0f, TWO_PI), glm::normalize(randPosition())));
+    frustum.setProjection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, randFloatInRange(10.0f, WORLD_SIZE)));
+    frustum.setCenterRadius(randFloatInRange(1.0f, 10.0f));
+    frustum.calculate();
+    return frustum;
+}
+
+static bool sameEntities(QVector<EntityItemPointer> a, QVector<EntityItemPointer> b) {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+void EntityBulkQueryTests::initTestCase() {
+    setupEntityTestDependencies();
+}
+
+void EntityBulkQueryTests::sameResultsTest() {
+    const int NUM_ENTITIES = 2000;
+    const int NUM_QUERIES_PER_TYPE = 25;
+
+    auto tree = createTree(NUM_ENTITIES);
+
+    EntityBulkQuery query;
+    std::vector<QVector<EntityItemPointer>> expected;
+    int numFound = 0;
+    tree->withReadLock([&] {
+        for (int i = 0; i < NUM_QUERIES_PER_TYPE; ++i) {
+            QVector<EntityItemPointer> found;
+
+            glm::vec3 center = randPosition();
+            float radius = randFloatInRange(1.0f, 50.0f);
+            query.addSphere(center, radius);
+            tree->findEntities(center, radius, found);
+            expected.push_back(found);
+
+            AABox box(randPosition(), glm::vec3(randFloatInRange(1.0f, 50.0f), randFloatInRange(1.0f, 50.0f),
+                                                randFloatInRange(1.0f, 50.0f)));
+            query.addBox(box);
+            tree->findEntities(box, found);
+            expected.push_back(found);
+
+            AACube cube(randPosition(), randFloatInRange(1.0f, 50.0f));
+            query.addCube(cube);
+            tree->findEntities(cube, found);
+            expected.push_back(found);
+
+            ViewFrustum frustum = randFrustum();
+            query.addFrustum(frustum);
+            tree->findEntities(frustum, found);
+            expected.push_back(found);
+        }
+
+        tree->findEntities(query);
+    });
+
+    QCOMPARE(query.getNumQueries(), (int)expected.size());
+    for (int i = 0; i < query.getNumQueries(); ++i) {
+        QVERIFY(sameEntities(query.getResults(i), expected[i]));
+        numFound += expected[i].size();
+    }
+    // make sure the queries found something to compare
+    QVERIFY(numFound > 0);
+}
+
+void EntityBulkQueryTests::emptyTest() {
+    auto tree = createTree(100);
+
+    EntityBulkQuery query;
+    tree->withReadLock([&] {
+        tree->findEntities(query);
+    });
+    QCOMPARE(query.getNumQueries(), 0);
+
+    int sphere = query.addSphere(glm::vec3(10.0f * WORLD_SIZE), 1.0f);
+    int box = query.addBox(AABox(glm::vec3(-10.0f * WORLD_SIZE), 1.0f));
+    tree->withReadLock([&] {
+        tree->findEntities(query);
+    });
+    QCOMPARE(query.getResults(sphere).size(), 0);
+    QCOMPARE(query.getResults(box).size(), 0);
+
+    query.clear();
+    QCOMPARE(query.getNumQueries(), 0);
+}
+
+#ifdef MANUAL_TEST
+
+void EntityBulkQueryTests::queryBenchmark() {
+    const int NUM_ENTITIES = 100000;
+    const int NUM_QUERIES = 1000;
+    const int NUM_REPEATS = 10;
+
+    auto tree = createTree(NUM_ENTITIES);
+
+    std::vector<glm::vec3> centers;
+    std::vector<float> radii;
+    EntityBulkQuery query;
+    for (int i = 0; i < NUM_QUERIES; ++i) {
+        centers.push_back(randPosition());
+        radii.push_back(randFloatInRange(1.0f, 20.0f));
+        query.addSphere(centers.back(), radii.back());
+    }
+
+    quint64 singleTime = 0;
+    quint64 bulkTime = 0;
+    tree->withReadLock([&] {
+        QVector<EntityItemPointer> found;
+        for (int r = 0; r < NUM_REPEATS; ++r) {
+            quint64 startTime = usecTimestampNow();
+            for (int i = 0; i < NUM_QUERIES; ++i) {
+                tree->findEntities(centers[i], radii[i], found);
+            }
+            singleTime += usecTimestampNow() - startTime;
+
+            startTime = usecTimestampNow();
+            tree->findEntities(query);
+            bulkTime += usecTimestampNow() - startTime;
+        }
+    });
+
+    double numQueries = (double)NUM_QUERIES * NUM_REPEATS;
+    std::cout << "single queries per second = " << (quint64)(numQueries * USECS_PER_SECOND / singleTime) << std::endl;
+    std::cout << "bulk queries per second = " << (quint64)(numQueries * USECS_PER_SECOND / bulkTime) << std::endl;
+}
+
+#endif // MANUAL_TEST
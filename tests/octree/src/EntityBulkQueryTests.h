@@ -0,0 +1,38 @@
+//
+//  EntityBulkQueryTests.h
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBulkQueryTests_h
+#define hifi_EntityBulkQueryTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class EntityBulkQueryTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that a batch of spheres, boxes, cubes and frustums finds what each query finds on its own
+    void sameResultsTest();
+
+    // Test a batch without queries, and queries that touch nothing
+    void emptyTest();
+
+#ifdef MANUAL_TEST
+    // Queries per second of a batch and of the same queries one at a time
+    void queryBenchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_EntityBulkQueryTests_h
@@ -0,0 +1,156 @@
+//
+//  EntityEditLogTests.cpp
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditLogTests.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+
+#include <OctreeEditLog.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityEditLogTests)
+
+static const int NUM_ENTITIES = 20;
+static const int64_t DATA_VERSION = 7;
+
+static QString editLogPath(const QString& persistPath) {
+    return persistPath + "." + OctreeEditLog::FILE_EXTENSION;
+}
+
+// saves a tree of NUM_ENTITIES entities, then logs an edit, an erase and an add
+static void saveAndLogEdits(const QString& persistPath, std::vector<EntityItemID>& entityIDs, EntityItemID& addedID) {
+    auto tree = createServerTree();
+    addEntities(tree, NUM_ENTITIES, entityIDs);
+    QCOMPARE((int)entityIDs.size(), NUM_ENTITIES);
+    tree->setOctreeVersionInfo(QUuid::createUuid(), DATA_VERSION);
+    QVERIFY(tree->writeToFile(qPrintable(persistPath), nullptr, "json.gz"));
+
+    OctreeEditLog editLog(editLogPath(persistPath), PacketType::EntityData);
+    QVERIFY(editLog.reset(tree->getPersistID(), tree->getPersistDataVersion()));
+
+    tree->withWriteLock([&] {
+        tree->setWantEditLog(true);
+
+        EntityItemProperties properties;
+        properties.setName("Edited");
+        QVERIFY(tree->updateEntity(entityIDs[0], properties));
+
+        tree->deleteEntity(entityIDs[1]);
+
+        addedID = EntityItemID(QUuid::createUuid());
+        QVERIFY(tree->addEntity(addedID, createBoxProperties(NUM_ENTITIES)));
+
+        tree->appendEditsToLog(editLog);
+    });
+    QCOMPARE(editLog.getNumPendingRecords(), 3);
+    QVERIFY(editLog.flush());
+}
+
+static EntityTreePointer loadTree(const QString& persistPath, int& numRecords) {
+    auto tree = createServerTree();
+    OctreeEditLog editLog(editLogPath(persistPath), PacketType::EntityData);
+    tree->withWriteLock([&] {
+        tree->readFromFile(qPrintable(persistPath));
+        numRecords = editLog.open(tree->getPersistID(), tree->getPersistDataVersion(), [&](const OctreeEditLogRecord& record) {
+            return tree->replayEditLogRecord(record);
+        });
+    });
+    return tree;
+}
+
+void EntityEditLogTests::initTestCase() {
+    setupEntityTestDependencies();
+}
+
+void EntityEditLogTests::replayTest() {
+    QTemporaryDir directory;
+    QString persistPath = directory.filePath("models.json.gz");
+
+    std::vector<EntityItemID> entityIDs;
+    EntityItemID addedID;
+    saveAndLogEdits(persistPath, entityIDs, addedID);
+    QCOMPARE((int)entityIDs.size(), NUM_ENTITIES);
+
+    int numRecords = 0;
+    auto tree = loadTree(persistPath, numRecords);
+    QCOMPARE(numRecords, 3);
+
+    auto editedEntity = tree->findEntityByEntityItemID(entityIDs[0]);
+    QVERIFY(editedEntity);
+    QCOMPARE(editedEntity->getName(), QString("Edited"));
+    QVERIFY(!tree->findEntityByEntityItemID(entityIDs[1]));
+
+    auto addedEntity = tree->findEntityByEntityItemID(addedID);
+    QVERIFY(addedEntity);
+    QCOMPARE(addedEntity->getName(), QString("Entity %1").arg(NUM_ENTITIES));
+    QVERIFY(addedEntity->getWorldPosition() == glm::vec3((float)NUM_ENTITIES, 0.0f, 0.0f));
+
+    for (int i = 2; i < NUM_ENTITIES; ++i) {
+        auto entity = tree->findEntityByEntityItemID(entityIDs[i]);
+        QVERIFY(entity);
+        QCOMPARE(entity->getName(), QString("Entity %1").arg(i));
+    }
+}
+
+void EntityEditLogTests::otherDataTest() {
+    QTemporaryDir directory;
+    QString persistPath = directory.filePath("models.json.gz");
+
+    std::vector<EntityItemID> entityIDs;
+    EntityItemID addedID;
+    saveAndLogEdits(persistPath, entityIDs, addedID);
+    QCOMPARE((int)entityIDs.size(), NUM_ENTITIES);
+
+    // as when the entities have since been saved in full, or replaced by the domain server
+    auto tree = createServerTree();
+    tree->withWriteLock([&] {
+        QVERIFY(tree->readFromFile(qPrintable(persistPath)));
+    });
+    tree->setOctreeVersionInfo(tree->getPersistID(), DATA_VERSION + 1);
+    QVERIFY(tree->writeToFile(qPrintable(persistPath), nullptr, "json.gz"));
+    qint64 editLogSize = QFileInfo(editLogPath(persistPath)).size();
+
+    int numRecords = 0;
+    auto loadedTree = loadTree(persistPath, numRecords);
+    QCOMPARE(numRecords, 0);
+    QCOMPARE(loadedTree->findEntityByEntityItemID(entityIDs[0])->getName(), QString("Entity 0"));
+    QVERIFY(loadedTree->findEntityByEntityItemID(entityIDs[1]));
+    QVERIFY(!loadedTree->findEntityByEntityItemID(addedID));
+
+    // the records that weren't replayed are kept aside, and a new log started
+    QFileInfoList backups = QDir(directory.path()).entryInfoList({ "models.json.gz.editlog.backup.*" }, QDir::Files);
+    QCOMPARE(backups.size(), 1);
+    QCOMPARE(backups[0].size(), editLogSize);
+    QVERIFY(QFileInfo(editLogPath(persistPath)).size() < editLogSize);
+}
+
+void EntityEditLogTests::truncatedTest() {
+    QTemporaryDir directory;
+    QString persistPath = directory.filePath("models.json.gz");
+
+    std::vector<EntityItemID> entityIDs;
+    EntityItemID addedID;
+    saveAndLogEdits(persistPath, entityIDs, addedID);
+    QCOMPARE((int)entityIDs.size(), NUM_ENTITIES);
+
+    // as when the server crashes while appending the last record
+    QFile editLogFile(editLogPath(persistPath));
+    qint64 fullSize = editLogFile.size();
+    QVERIFY(editLogFile.resize(fullSize - 1));
+
+    int numRecords = 0;
+    loadTree(persistPath, numRecords);
+    QCOMPARE(numRecords, 2);
+    QVERIFY(QFileInfo(editLogFile.fileName()).size() < fullSize - 1);
+}
@@ -0,0 +1,34 @@
+//
+//  EntityEditLogTests.h
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditLogTests_h
+#define hifi_EntityEditLogTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class EntityEditLogTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that adds, edits and erases appended to an edit log are replayed onto the saved entities
+    void replayTest();
+
+    // Test that a log of other saved data is moved aside rather than replayed
+    void otherDataTest();
+
+    // Test that replay stops at a record cut short, and the log is truncated there
+    void truncatedTest();
+};
+
+#endif // hifi_EntityEditLogTests_h
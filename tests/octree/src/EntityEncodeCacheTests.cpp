@@ -0,0 +1,142 @@
+//
+//  EntityEncodeCacheTests.cpp
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodeCacheTests.h"
+
+#include <EntityEncodeCache.h>
+#include <OctreePacketData.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityEncodeCacheTests)
+
+static EntityItemPointer createEntity(const QString& userData) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setName("Cached");
+    properties.setUserData(userData);
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    return EntityTypes::constructEntityItem(EntityTypes::Box, QUuid::createUuid(), properties);
+}
+
+static QByteArray toByteArray(OctreePacketData& packetData) {
+    return QByteArray((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+}
+
+static QByteArray encodeDirectly(const EntityItemPointer& entity, int targetSize, OctreeElement::AppendState& state) {
+    OctreePacketData packetData(false, targetSize);
+    EncodeBitstreamParams params;
+    EntityTreeElementExtraEncodeDataPointer extraEncodeData { new EntityTreeElementExtraEncodeData() };
+    state = entity->appendEntityData(&packetData, params, extraEncodeData);
+    return toByteArray(packetData);
+}
+
+static QByteArray encodeCached(EntityEncodeCache& cache, const EntityItemPointer& entity, int targetSize,
+                               OctreeElement::AppendState& state, int& numSends) {
+    OctreePacketData packetData(false, targetSize);
+    EncodeBitstreamParams params;
+    params.trackSend = [&](const QUuid&, quint64) {
+        ++numSends;
+    };
+    EntityTreeElementExtraEncodeDataPointer extraEncodeData { new EntityTreeElementExtraEncodeData() };
+    state = cache.appendEntityData(entity, packetData, params, extraEncodeData);
+    return toByteArray(packetData);
+}
+
+void EntityEncodeCacheTests::initTestCase() {
+    setupEntityTestDependencies();
+}
+
+void EntityEncodeCacheTests::sameBytesTest() {
+    EntityEncodeCache cache;
+    auto entity = createEntity("{\"cached\":true}");
+
+    OctreeElement::AppendState state;
+    QByteArray expected = encodeDirectly(entity, MAX_OCTREE_PACKET_DATA_SIZE, state);
+    QCOMPARE(state, OctreeElement::COMPLETED);
+
+    int numSends = 0;
+    for (int i = 0; i < 3; ++i) {
+        QByteArray encoded = encodeCached(cache, entity, MAX_OCTREE_PACKET_DATA_SIZE, state, numSends);
+        QCOMPARE(state, OctreeElement::COMPLETED);
+        QCOMPARE(encoded, expected);
+    }
+    QCOMPARE(numSends, 3);
+    QCOMPARE((int)cache.getNumMisses(), 1);
+    QCOMPARE((int)cache.getNumHits(), 2);
+    QCOMPARE(cache.getSize(), expected.size());
+
+    cache.remove(entity->getEntityItemID());
+    QCOMPARE(cache.getSize(), 0);
+}
+
+void EntityEncodeCacheTests::editTest() {
+    EntityEncodeCache cache;
+    auto entity = createEntity("{\"edited\":false}");
+
+    OctreeElement::AppendState state;
+    int numSends = 0;
+    QByteArray before = encodeCached(cache, entity, MAX_OCTREE_PACKET_DATA_SIZE, state, numSends);
+
+    entity->setUserData("{\"edited\":true}");
+    entity->setLastEdited(entity->getLastEdited() + 1);
+
+    QByteArray expected = encodeDirectly(entity, MAX_OCTREE_PACKET_DATA_SIZE, state);
+    QByteArray after = encodeCached(cache, entity, MAX_OCTREE_PACKET_DATA_SIZE, state, numSends);
+    QCOMPARE(state, OctreeElement::COMPLETED);
+    QVERIFY(after != before);
+    QCOMPARE(after, expected);
+    QCOMPARE((int)cache.getNumMisses(), 2);
+    QCOMPARE(cache.getSize(), expected.size());
+}
+
+void EntityEncodeCacheTests::serverChangeTest() {
+    EntityEncodeCache cache;
+    auto entity = createEntity("{\"owned\":true}");
+    entity->setSimulationOwner(QUuid::createUuid(), SCRIPT_GRAB_SIMULATION_PRIORITY);
+
+    OctreeElement::AppendState state;
+    int numSends = 0;
+    QByteArray before = encodeCached(cache, entity, MAX_OCTREE_PACKET_DATA_SIZE, state, numSends);
+
+    // as when the server clears the ownership of an owner that has left, without editing the entity
+    entity->clearSimulationOwnership();
+    entity->markAsChangedOnServer();
+
+    QByteArray expected = encodeDirectly(entity, MAX_OCTREE_PACKET_DATA_SIZE, state);
+    QByteArray after = encodeCached(cache, entity, MAX_OCTREE_PACKET_DATA_SIZE, state, numSends);
+    QCOMPARE(state, OctreeElement::COMPLETED);
+    QVERIFY(after != before);
+    QCOMPARE(after, expected);
+    QCOMPARE((int)cache.getNumMisses(), 2);
+    QCOMPARE((int)cache.getNumHits(), 0);
+}
+
+void EntityEncodeCacheTests::partialTest() {
+    const int SMALL_PACKET_SIZE = 200;
+
+    EntityEncodeCache cache;
+    auto entity = createEntity(QString(4 * SMALL_PACKET_SIZE, 'x'));
+
+    // cache the whole entity, as encoded for a client with room for it
+    OctreeElement::AppendState state;
+    int numSends = 0;
+    encodeCached(cache, entity, MAX_OCTREE_PACKET_DATA_SIZE, state, numSends);
+    QCOMPARE(state, OctreeElement::COMPLETED);
+
+    OctreeElement::AppendState expectedState;
+    QByteArray expected = encodeDirectly(entity, SMALL_PACKET_SIZE, expectedState);
+    QVERIFY(expectedState != OctreeElement::COMPLETED);
+
+    QByteArray encoded = encodeCached(cache, entity, SMALL_PACKET_SIZE, state, numSends);
+    QCOMPARE(state, expectedState);
+    QCOMPARE(encoded, expected);
+}
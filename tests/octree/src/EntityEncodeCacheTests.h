@@ -0,0 +1,37 @@
+//
+//  EntityEncodeCacheTests.h
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodeCacheTests_h
+#define hifi_EntityEncodeCacheTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class EntityEncodeCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that cached entities are appended with the same bytes as encoding them
+    void sameBytesTest();
+
+    // Test that an entity is encoded again once it is edited
+    void editTest();
+
+    // Test that an entity is encoded again once the server changes it, without an edit
+    void serverChangeTest();
+
+    // Test that an entity that doesn't fit the packet is split as usual
+    void partialTest();
+};
+
+#endif // hifi_EntityEncodeCacheTests_h
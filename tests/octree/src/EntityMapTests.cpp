@@ -0,0 +1,185 @@
+//
+//  EntityMapTests.cpp
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityMapTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ShardedEntityMap.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityMapTests)
+
+static std::vector<EntityItemPointer> createEntities(int numEntities) {
+    std::vector<EntityItemPointer> entities;
+    for (int i = 0; i < numEntities; ++i) {
+        auto properties = createBoxProperties(i);
+        entities.push_back(EntityTypes::constructEntityItem(EntityTypes::Box, QUuid::createUuid(), properties));
+    }
+    return entities;
+}
+
+void EntityMapTests::initTestCase() {
+    setupEntityTestDependencies();
+}
+
+void EntityMapTests::mapTest() {
+    const int NUM_ENTITIES = 200;
+
+    ShardedEntityMap map;
+    auto entities = createEntities(NUM_ENTITIES);
+    for (auto& entity : entities) {
+        QVERIFY(entity);
+        QVERIFY(map.insert(entity->getEntityItemID(), entity));
+    }
+    QCOMPARE(map.size(), NUM_ENTITIES);
+
+    // an id that is already there is left alone
+    auto otherEntity = EntityTypes::constructEntityItem(EntityTypes::Box, entities[0]->getEntityItemID(),
+                                                        createBoxProperties(0));
+    QVERIFY(!map.insert(entities[0]->getEntityItemID(), otherEntity));
+    QVERIFY(map.value(entities[0]->getEntityItemID()) == entities[0]);
+
+    for (int i = 0; i < NUM_ENTITIES; i += 2) {
+        map.remove(entities[i]->getEntityItemID());
+    }
+    QCOMPARE(map.size(), NUM_ENTITIES / 2);
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        auto entity = map.value(entities[i]->getEntityItemID());
+        QVERIFY(entity == (i % 2 ? entities[i] : EntityItemPointer()));
+    }
+    QVERIFY(!map.value(QUuid::createUuid()));
+
+    auto all = map.takeAll();
+    QCOMPARE(all.size(), NUM_ENTITIES / 2);
+    QVERIFY(all.value(entities[1]->getEntityItemID()) == entities[1]);
+    QCOMPARE(map.size(), 0);
+    QVERIFY(!map.value(entities[1]->getEntityItemID()));
+}
+
+void EntityMapTests::concurrentLookupTest() {
+    const int NUM_ENTITIES = 100;
+    const int NUM_EDITS = 2000;
+
+    auto tree = createServerTree();
+    std::vector<EntityItemID> entityIDs;
+    addEntities(tree, NUM_ENTITIES, entityIDs);
+    QCOMPARE((int)entityIDs.size(), NUM_ENTITIES);
+
+    std::atomic<bool> editing { true };
+    std::atomic<int> numMissing { 0 };
+    std::thread reader([&] {
+        while (editing) {
+            for (auto& entityID : entityIDs) {
+                if (!tree->findEntityByEntityItemID(entityID)) {
+                    ++numMissing;
+                }
+            }
+        }
+    });
+
+    // no QVERIFY until the reader is joined, since a failure returns early
+    int numEditsFailed = 0;
+    for (int i = 0; i < NUM_EDITS; ++i) {
+        EntityItemID entityID(QUuid::createUuid());
+        tree->withWriteLock([&] {
+            tree->addEntity(entityID, createBoxProperties(i));
+        });
+        bool added = (bool)tree->findEntityByEntityItemID(entityID);
+        tree->withWriteLock([&] {
+            tree->deleteEntity(entityID, true, true);
+        });
+        if (!added || tree->findEntityByEntityItemID(entityID)) {
+            ++numEditsFailed;
+        }
+    }
+
+    editing = false;
+    reader.join();
+    QCOMPARE(numEditsFailed, 0);
+    QCOMPARE(numMissing.load(), 0);
+}
+
+#ifdef MANUAL_TEST
+
+void EntityMapTests::contentionBenchmark() {
+    const int NUM_ENTITIES = 10000;
+    const int NUM_EDITED_ENTITIES = 1000;
+    const quint64 DURATION_USECS = 2 * USECS_PER_SECOND;
+
+    int numShards[] = { 1, ShardedEntityMap::DEFAULT_NUM_SHARDS };
+    int maxReaders = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+
+    auto entities = createEntities(NUM_ENTITIES);
+    auto editedEntities = createEntities(NUM_EDITED_ENTITIES);
+    std::vector<EntityItemID> entityIDs;
+    for (auto& entity : entities) {
+        entityIDs.push_back(entity->getEntityItemID());
+    }
+
+    std::cout << "[numShards, numReaders, lookupsPerSecond, editsPerSecond] = [" << std::endl;
+    for (int shards : numShards) {
+        for (int numReaders = 1; numReaders <= maxReaders; numReaders *= 2) {
+            ShardedEntityMap map(shards);
+            for (auto& entity : entities) {
+                map.insert(entity->getEntityItemID(), entity);
+            }
+
+            std::atomic<bool> running { true };
+            std::atomic<quint64> numLookups { 0 };
+            std::vector<std::thread> readers;
+            for (int r = 0; r < numReaders; ++r) {
+                readers.emplace_back([&, r] {
+                    quint64 lookups = 0;
+                    int i = r;
+                    while (running) {
+                        map.value(entityIDs[i]);
+                        i = (i + 7) % NUM_ENTITIES;
+                        ++lookups;
+                    }
+                    numLookups += lookups;
+                });
+            }
+
+            // the writer adds and removes entities as fast as it can, like a burst of edits
+            quint64 numEdits = 0;
+            quint64 startTime = usecTimestampNow();
+            quint64 elapsed = 0;
+            while ((elapsed = usecTimestampNow() - startTime) < DURATION_USECS) {
+                for (auto& entity : editedEntities) {
+                    map.insert(entity->getEntityItemID(), entity);
+                }
+                for (auto& entity : editedEntities) {
+                    map.remove(entity->getEntityItemID());
+                }
+                numEdits += 2 * NUM_EDITED_ENTITIES;
+            }
+            running = false;
+            for (auto& reader : readers) {
+                reader.join();
+            }
+
+            double seconds = (double)elapsed / USECS_PER_SECOND;
+            std::cout << "    " << shards << ", " << numReaders << ", " << (quint64)(numLookups / seconds) << ", "
+                << (quint64)(numEdits / seconds) << std::endl;
+        }
+    }
+    std::cout << "];" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,38 @@
+//
+//  EntityMapTests.h
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityMapTests_h
+#define hifi_EntityMapTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class EntityMapTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test inserting, finding and removing entities in a sharded map
+    void mapTest();
+
+    // Test that entities stay findable in a tree while other entities are added and deleted on another thread
+    void concurrentLookupTest();
+
+#ifdef MANUAL_TEST
+    // Lookups per second with a thread adding and removing entities, with one shard and with the default
+    void contentionBenchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_EntityMapTests_h
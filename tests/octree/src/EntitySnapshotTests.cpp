@@ -0,0 +1,263 @@
+//
+//  EntitySnapshotTests.cpp
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySnapshotTests.h"
+
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+
+#include <NumericalConstants.h>
+#include <OctreeSnapshot.h>
+#include <SharedUtil.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntitySnapshotTests)
+
+static const int NUM_MODEL_URLS = 50;
+
+// a world of boxes, models, texts and lights, with the same contents for the same seed
+static EntityItemProperties createProperties(int i, std::mt19937& generator) {
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(0.1f, 10.0f);
+    std::uniform_real_distribution<float> angle(0.0f, TWO_PI);
+
+    EntityItemProperties properties;
+    switch (i % 4) {
+        case 0:
+            properties.setType(EntityTypes::Box);
+            properties.setColor(xColor { (uint8_t)i, 128, 255 });
+            break;
+        case 1:
+            properties.setType(EntityTypes::Model);
+            properties.setModelURL(QString("http://example.com/models/model%1.fbx").arg(i % NUM_MODEL_URLS));
+            break;
+        case 2:
+            properties.setType(EntityTypes::Text);
+            properties.setText(QString::fromUtf8("Text %1 \xC3\xA9\xE2\x82\xAC").arg(i));
+            break;
+        default:
+            properties.setType(EntityTypes::Light);
+            properties.setIntensity(size(generator));
+            break;
+    }
+
+    properties.setName(QString("Entity %1").arg(i));
+    properties.setUserData(QString("{\"index\":%1,\"grabbableKey\":{\"grabbable\":false}}").arg(i));
+    properties.setPosition(glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)));
+    properties.setRotation(glm::quat(glm::vec3(angle(generator), angle(generator), angle(generator))));
+    properties.setDimensions(glm::vec3(size(generator), size(generator), size(generator)));
+    return properties;
+}
+
+static EntityTreePointer createTree(int numEntities, std::vector<EntityItemID>& entityIDs) {
+    auto tree = createServerTree();
+    std::mt19937 generator(numEntities);
+    addEntities(tree, numEntities, entityIDs, [&](int i) {
+        return createProperties(i, generator);
+    });
+    return tree;
+}
+
+static EntityTreePointer loadTree(const QString& path, bool& success) {
+    auto tree = createServerTree();
+    tree->withWriteLock([&] {
+        success = tree->readFromFile(qPrintable(path));
+    });
+    return tree;
+}
+
+void EntitySnapshotTests::initTestCase() {
+    setupEntityTestDependencies();
+}
+
+void EntitySnapshotTests::roundTripTest() {
+    const int NUM_ENTITIES = 100;
+
+    QTemporaryDir directory;
+    QString path = directory.filePath("models.snapshot");
+
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createTree(NUM_ENTITIES, entityIDs);
+    tree->setOctreeVersionInfo(QUuid::createUuid(), 42);
+    QCOMPARE((int)entityIDs.size(), NUM_ENTITIES);
+    QVERIFY(tree->writeToFile(qPrintable(path), nullptr, OctreeSnapshot::FILE_TYPE));
+
+    OctreeSnapshot::Header header;
+    QVERIFY(OctreeSnapshot::readHeaderFromFile(path, header));
+    QCOMPARE((int)header.numItems, NUM_ENTITIES);
+    QVERIFY(header.dataVersion == 42);
+
+    bool success = false;
+    auto loadedTree = loadTree(path, success);
+    QVERIFY(success);
+
+    for (auto& entityID : entityIDs) {
+        auto entity = tree->findEntityByEntityItemID(entityID);
+        auto loadedEntity = loadedTree->findEntityByEntityItemID(entityID);
+        QVERIFY(loadedEntity);
+
+        auto properties = entity->getProperties();
+        auto loadedProperties = loadedEntity->getProperties();
+        QCOMPARE(loadedProperties.getType(), properties.getType());
+        QCOMPARE(loadedProperties.getName(), properties.getName());
+        QCOMPARE(loadedProperties.getUserData(), properties.getUserData());
+        QCOMPARE(loadedProperties.getModelURL(), properties.getModelURL());
+        QCOMPARE(loadedProperties.getText(), properties.getText());
+        QCOMPARE(loadedProperties.getIntensity(), properties.getIntensity());
+        QCOMPARE(loadedProperties.getCreated(), properties.getCreated());
+        QVERIFY(loadedProperties.getPosition() == properties.getPosition());
+        QVERIFY(loadedProperties.getRotation() == properties.getRotation());
+        QVERIFY(loadedProperties.getDimensions() == properties.getDimensions());
+
+        xColor color = properties.getColor();
+        xColor loadedColor = loadedProperties.getColor();
+        QCOMPARE(loadedColor.red, color.red);
+        QCOMPARE(loadedColor.green, color.green);
+        QCOMPARE(loadedColor.blue, color.blue);
+    }
+}
+
+void EntitySnapshotTests::jsonContentTest() {
+    const int NUM_ENTITIES = 10;
+
+    QTemporaryDir directory;
+    QString jsonPath = directory.filePath("models.json.gz");
+    QString snapshotPath = directory.filePath("models.snapshot");
+
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createTree(NUM_ENTITIES, entityIDs);
+    QVERIFY(tree->writeToFile(qPrintable(jsonPath), nullptr, "json.gz"));
+
+    // as when the domain server sends replacement data for a server persisting snapshots
+    QVERIFY(QFile::rename(jsonPath, snapshotPath));
+
+    bool success = false;
+    auto loadedTree = loadTree(snapshotPath, success);
+    QVERIFY(success);
+
+    for (auto& entityID : entityIDs) {
+        QVERIFY(loadedTree->findEntityByEntityItemID(entityID));
+    }
+}
+
+// as if the snapshot had been written by another build
+static bool rewriteHeaderField(const QString& path, size_t offset, uint32_t value) {
+    QFile file(path);
+    return file.open(QIODevice::ReadWrite) && file.seek(offset) &&
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value)) == sizeof(value);
+}
+
+void EntitySnapshotTests::otherVersionTest() {
+    const int NUM_ENTITIES = 10;
+
+    QTemporaryDir directory;
+    QString path = directory.filePath("models.snapshot");
+
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createTree(NUM_ENTITIES, entityIDs);
+    tree->setOctreeVersionInfo(QUuid::createUuid(), 42);
+    QVERIFY(tree->writeToFile(qPrintable(path), nullptr, OctreeSnapshot::FILE_TYPE));
+
+    OctreeSnapshot::Header header;
+    QVERIFY(OctreeSnapshot::readHeaderFromFile(path, header));
+    QVERIFY(rewriteHeaderField(path, offsetof(OctreeSnapshot::Header, protocolVersion), header.protocolVersion - 1));
+
+    bool success = false;
+    auto loadedTree = loadTree(path, success);
+    QVERIFY(success);
+    QVERIFY(!loadedTree->isFileUnreadable());
+    QCOMPARE(loadedTree->getPersistID(), tree->getPersistID());
+    QVERIFY(loadedTree->getPersistDataVersion() == 42);
+
+    for (auto& entityID : entityIDs) {
+        auto entity = tree->findEntityByEntityItemID(entityID);
+        auto loadedEntity = loadedTree->findEntityByEntityItemID(entityID);
+        QVERIFY(loadedEntity);
+        QCOMPARE(loadedEntity->getProperties().getName(), entity->getProperties().getName());
+    }
+
+    // without its JSON, a snapshot is only read by a build with the same protocol version
+    QVERIFY(tree->writeToFile(qPrintable(path), nullptr, OctreeSnapshot::FILE_TYPE, false));
+    loadedTree = loadTree(path, success);
+    QVERIFY(success);
+    QVERIFY(loadedTree->findEntityByEntityItemID(entityIDs[0]));
+    QVERIFY(rewriteHeaderField(path, offsetof(OctreeSnapshot::Header, protocolVersion), header.protocolVersion - 1));
+    loadedTree = loadTree(path, success);
+    QVERIFY(!success);
+    QVERIFY(loadedTree->isFileUnreadable());
+}
+
+void EntitySnapshotTests::unreadableTest() {
+    const int NUM_ENTITIES = 10;
+
+    QTemporaryDir directory;
+    QString path = directory.filePath("models.snapshot");
+
+    std::vector<EntityItemID> entityIDs;
+    auto tree = createTree(NUM_ENTITIES, entityIDs);
+    QVERIFY(tree->writeToFile(qPrintable(path), nullptr, OctreeSnapshot::FILE_TYPE));
+    QVERIFY(rewriteHeaderField(path, offsetof(OctreeSnapshot::Header, dataPacketType), (uint32_t)PacketType::Unknown));
+
+    bool success = true;
+    auto loadedTree = loadTree(path, success);
+    QVERIFY(!success);
+    QVERIFY(loadedTree->isFileUnreadable());
+}
+
+#ifdef MANUAL_TEST
+
+void EntitySnapshotTests::benchmark() {
+    int numEntities[] = { 1000, 10000, 100000 };
+
+    QTemporaryDir directory;
+
+    std::cout << "[numEntities, jsonGzSaveUsecs, snapshotSaveUsecs, jsonGzLoadUsecs, snapshotLoadUsecs, "
+        << "jsonGzBytes, snapshotBytes] = [" << std::endl;
+    for (int n : numEntities) {
+        std::vector<EntityItemID> entityIDs;
+        auto tree = createTree(n, entityIDs);
+
+        // different base names, since loading picks the most recent of the persist extensions
+        QString jsonPath = directory.filePath(QString("json%1.json.gz").arg(n));
+        QString snapshotPath = directory.filePath(QString("snapshot%1.snapshot").arg(n));
+
+        uint64_t startTime = usecTimestampNow();
+        tree->writeToFile(qPrintable(jsonPath), nullptr, "json.gz");
+        uint64_t jsonSaveUsecs = usecTimestampNow() - startTime;
+
+        startTime = usecTimestampNow();
+        tree->writeToFile(qPrintable(snapshotPath), nullptr, OctreeSnapshot::FILE_TYPE);
+        uint64_t snapshotSaveUsecs = usecTimestampNow() - startTime;
+
+        // keep the loaded trees until after the timing, so that it doesn't include tearing them down
+        bool success = false;
+        startTime = usecTimestampNow();
+        auto jsonTree = loadTree(jsonPath, success);
+        uint64_t jsonLoadUsecs = usecTimestampNow() - startTime;
+
+        startTime = usecTimestampNow();
+        auto snapshotTree = loadTree(snapshotPath, success);
+        uint64_t snapshotLoadUsecs = usecTimestampNow() - startTime;
+
+        std::cout << "    " << n << ", " << jsonSaveUsecs << ", " << snapshotSaveUsecs << ", "
+            << jsonLoadUsecs << ", " << snapshotLoadUsecs << ", "
+            << QFileInfo(jsonPath).size() << ", " << QFileInfo(snapshotPath).size() << std::endl;
+    }
+    std::cout << "];" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,43 @@
+//
+//  EntitySnapshotTests.h
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySnapshotTests_h
+#define hifi_EntitySnapshotTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class EntitySnapshotTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that entities saved to a snapshot load back with the same properties
+    void roundTripTest();
+
+    // Test that a persist file with a snapshot extension but JSON content still loads
+    void jsonContentTest();
+
+    // Test that a snapshot written with another protocol version loads from the JSON it carries
+    void otherVersionTest();
+
+    // Test that a snapshot that can't be read is reported, rather than loading as an empty tree
+    void unreadableTest();
+
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_EntitySnapshotTests_h
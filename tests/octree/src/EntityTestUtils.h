@@ -0,0 +1,65 @@
+//
+//  EntityTestUtils.h
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTestUtils_h
+#define hifi_EntityTestUtils_h
+
+#include <functional>
+#include <vector>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+// Setup and factories shared by the entity testcases
+// (inline, since every .cpp file of a testcase must be a test class)
+
+// the dependencies an EntityTree and its entities need, called from the initTestCase of each testcase
+inline void setupEntityTestDependencies() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+// a named box, one meter further along x for each i
+inline EntityItemProperties createBoxProperties(int i) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setName(QString("Entity %1").arg(i));
+    properties.setPosition(glm::vec3((float)i, 0.0f, 0.0f));
+    return properties;
+}
+
+// a server tree, which doesn't need rez permissions to add entities
+inline EntityTreePointer createServerTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    return tree;
+}
+
+// adds the entities made by createProperties(i) for i in [0, numEntities), appending the ids of those added
+inline void addEntities(const EntityTreePointer& tree, int numEntities, std::vector<EntityItemID>& entityIDs,
+                        std::function<EntityItemProperties(int)> createProperties = createBoxProperties) {
+    tree->withWriteLock([&] {
+        for (int i = 0; i < numEntities; ++i) {
+            EntityItemID entityID(QUuid::createUuid());
+            if (tree->addEntity(entityID, createProperties(i))) {
+                entityIDs.push_back(entityID);
+            }
+        }
+    });
+}
+
+#endif // hifi_EntityTestUtils_h
@@ -0,0 +1,141 @@
+//
+//  EntityTransformDeltaTests.cpp
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTransformDeltaTests.h"
+
+#include <EntityTransformDelta.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(EntityTransformDeltaTests)
+
+const float POSITION_TOLERANCE = 1.0e-3f;
+const float ROTATION_TOLERANCE = 1.0e-3f;
+const float VELOCITY_TOLERANCE = 2.0e-3f;
+
+static EntityTransform createTransform(float t) {
+    EntityTransform transform;
+    transform.position = glm::vec3(10.0f + t, 2.0f, -5.0f + 0.5f * t);
+    transform.rotation = glm::angleAxis(0.3f * t, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f)));
+    transform.velocity = glm::vec3(1.0f, 0.0f, 0.5f + 0.1f * t);
+    transform.angularVelocity = glm::vec3(0.0f, 0.3f, 0.0f);
+    return transform;
+}
+
+static bool closeTo(const EntityTransform& a, const EntityTransform& b) {
+    return glm::length(a.position - b.position) < POSITION_TOLERANCE &&
+        fabsf(glm::dot(a.rotation, b.rotation)) > 1.0f - ROTATION_TOLERANCE &&
+        glm::length(a.velocity - b.velocity) < VELOCITY_TOLERANCE &&
+        glm::length(a.angularVelocity - b.angularVelocity) < VELOCITY_TOLERANCE;
+}
+
+void EntityTransformDeltaTests::deltaTest() {
+    EntityTransformDeltaEncoder encoder;
+    EntityTransformKeyframe clientKeyframe;
+    EntityItemID entityID(QUuid::createUuid());
+    quint64 now = usecTimestampNow();
+
+    EntityTransform transform = createTransform(0.0f);
+    QByteArray keyframe = encoder.encode(entityID, transform, now);
+    QVERIFY(EntityTransformDelta::isKeyframe(keyframe));
+    encoder.trackSend(entityID, keyframe);
+    QCOMPARE(encoder.getNumKeyframes(), 1);
+
+    EntityTransform decoded;
+    QVERIFY(EntityTransformDelta::decode(keyframe, clientKeyframe, decoded));
+    QVERIFY(clientKeyframe.valid);
+    QVERIFY(closeTo(decoded, transform));
+
+    const int NUM_STEPS = 10;
+    const float STEP = 0.1f;
+    for (int i = 1; i <= NUM_STEPS; ++i) {
+        transform = createTransform(i * STEP);
+        QByteArray delta = encoder.encode(entityID, transform, now + i * USECS_PER_MSEC);
+        QVERIFY(!EntityTransformDelta::isKeyframe(delta));
+        QVERIFY(delta.size() < keyframe.size());
+        encoder.trackSend(entityID, delta);
+
+        QVERIFY(EntityTransformDelta::decode(delta, clientKeyframe, decoded));
+        QVERIFY(closeTo(decoded, transform));
+    }
+
+    // an entity that hasn't moved since its keyframe is sent as little more than a header
+    QByteArray unchanged = encoder.encode(entityID, createTransform(0.0f), now + USECS_PER_MSEC);
+    QVERIFY(unchanged.size() <= 6);
+    QVERIFY(EntityTransformDelta::decode(unchanged, clientKeyframe, decoded));
+    QVERIFY(closeTo(decoded, createTransform(0.0f)));
+
+    // what isn't a transform isn't decoded
+    QVERIFY(!EntityTransformDelta::decode(QByteArray(), clientKeyframe, decoded));
+    QVERIFY(!EntityTransformDelta::decode(unchanged + 'x', clientKeyframe, decoded));
+    QVERIFY(!EntityTransformDelta::decode(keyframe.left(keyframe.size() - 1), clientKeyframe, decoded));
+}
+
+void EntityTransformDeltaTests::keyframeTest() {
+    EntityTransformDeltaEncoder encoder;
+    EntityItemID entityID(QUuid::createUuid());
+    quint64 now = usecTimestampNow();
+
+    EntityTransform transform = createTransform(0.0f);
+    encoder.trackSend(entityID, encoder.encode(entityID, transform, now));
+
+    // too far to fit the delta
+    EntityTransform farTransform = transform;
+    farTransform.position += glm::vec3(100.0f, 0.0f, 0.0f);
+    QVERIFY(EntityTransformDelta::isKeyframe(encoder.encode(entityID, farTransform, now + 1)));
+
+    // too fast
+    EntityTransform fastTransform = transform;
+    fastTransform.velocity = glm::vec3(0.0f, -200.0f, 0.0f);
+    QVERIFY(EntityTransformDelta::isKeyframe(encoder.encode(entityID, fastTransform, now + 1)));
+
+    // too long since the keyframe
+    quint64 later = now + EntityTransformDeltaEncoder::KEYFRAME_INTERVAL_USECS;
+    QVERIFY(EntityTransformDelta::isKeyframe(encoder.encode(entityID, transform, later)));
+
+    // an entity that isn't tracked anymore starts over with a keyframe
+    QVERIFY(!EntityTransformDelta::isKeyframe(encoder.encode(entityID, transform, now + 1)));
+    encoder.remove(entityID);
+    QVERIFY(EntityTransformDelta::isKeyframe(encoder.encode(entityID, transform, now + 1)));
+}
+
+void EntityTransformDeltaTests::lostKeyframeTest() {
+    EntityTransformDeltaEncoder encoder;
+    EntityTransformKeyframe clientKeyframe;
+    EntityItemID entityID(QUuid::createUuid());
+    quint64 now = usecTimestampNow();
+    EntityTransform decoded;
+
+    QByteArray firstKeyframe = encoder.encode(entityID, createTransform(0.0f), now);
+    encoder.trackSend(entityID, firstKeyframe);
+    QVERIFY(EntityTransformDelta::decode(firstKeyframe, clientKeyframe, decoded));
+
+    // the second keyframe is lost
+    quint64 later = now + EntityTransformDeltaEncoder::KEYFRAME_INTERVAL_USECS;
+    QByteArray secondKeyframe = encoder.encode(entityID, createTransform(1.0f), later);
+    QVERIFY(EntityTransformDelta::isKeyframe(secondKeyframe));
+    encoder.trackSend(entityID, secondKeyframe);
+
+    EntityTransform transform = createTransform(1.1f);
+    QByteArray delta = encoder.encode(entityID, transform, later + 1);
+    QVERIFY(!EntityTransformDelta::isKeyframe(delta));
+    QVERIFY(!EntityTransformDelta::decode(delta, clientKeyframe, decoded));
+
+    // until it is resent
+    QVERIFY(EntityTransformDelta::decode(secondKeyframe, clientKeyframe, decoded));
+    QVERIFY(EntityTransformDelta::decode(delta, clientKeyframe, decoded));
+    QVERIFY(closeTo(decoded, transform));
+
+    // the first keyframe arriving again doesn't replace the second
+    QVERIFY(EntityTransformDelta::decode(firstKeyframe, clientKeyframe, decoded));
+    QVERIFY(EntityTransformDelta::decode(delta, clientKeyframe, decoded));
+    QVERIFY(closeTo(decoded, transform));
+}
@@ -0,0 +1,34 @@
+//
+//  EntityTransformDeltaTests.h
+//  tests/octree/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTransformDeltaTests_h
+#define hifi_EntityTransformDeltaTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class EntityTransformDeltaTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the first transform sent is a keyframe, and that later ones are smaller deltas that decode to within a
+    // unit of what was encoded
+    void deltaTest();
+
+    // Test that transforms that moved too far, or long after their keyframe, are sent as new keyframes
+    void keyframeTest();
+
+    // Test that the deltas of a keyframe the client hasn't received are dropped, and that a keyframe that arrives late
+    // doesn't replace a later one
+    void lostKeyframeTest();
+};
+
+#endif // hifi_EntityTransformDeltaTests_h
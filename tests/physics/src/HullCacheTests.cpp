@@ -0,0 +1,161 @@
+//
+//  HullCacheTests.cpp
+//  tests/physics/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HullCacheTests.h"
+
+#include <QTemporaryDir>
+
+#include <HullCache.h>
+#include <ShapeFactory.h>
+
+QTEST_MAIN(HullCacheTests)
+
+static ShapeInfo::PointList makeHullPoints(const glm::vec3& offset, float radius) {
+    ShapeInfo::PointList points;
+    points.push_back(radius * glm::vec3(1.0f, 1.0f, 1.0f) + offset);
+    points.push_back(radius * glm::vec3(1.0f, -1.0f, -1.0f) + offset);
+    points.push_back(radius * glm::vec3(-1.0f, 1.0f, -1.0f) + offset);
+    points.push_back(radius * glm::vec3(-1.0f, -1.0f, 1.0f) + offset);
+    points.push_back(radius * glm::vec3(0.0f, 0.5f, 0.0f) + offset);
+    return points;
+}
+
+static void compareHulls(const btConvexHullShape* hull, const btConvexHullShape* otherHull) {
+    QCOMPARE(otherHull->getMargin(), hull->getMargin());
+    QCOMPARE(otherHull->getNumPoints(), hull->getNumPoints());
+    for (int i = 0; i < hull->getNumPoints(); ++i) {
+        QCOMPARE(otherHull->getUnscaledPoints()[i], hull->getUnscaledPoints()[i]);
+    }
+}
+
+void HullCacheTests::saveAndLoadHull() {
+    QTemporaryDir dir;
+    auto hullCache = std::make_shared<HullCache>(dir.path().toStdString());
+    hullCache->initialize();
+
+    ShapeInfo::PointCollection pointCollection;
+    pointCollection.push_back(makeHullPoints(glm::vec3(0.0f), 1.0f));
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_SIMPLE_HULL, glm::vec3(1.0f));
+    info.setPointCollection(pointCollection);
+
+    QVERIFY(hullCache->loadShape(info) == nullptr);
+
+    // building the shape saves its hull
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info, hullCache.get());
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shape->getShapeType(), (int)CONVEX_HULL_SHAPE_PROXYTYPE);
+    QCOMPARE(hullCache->getNumTotalFiles(), (size_t)1);
+
+    btCollisionShape* loadedShape = hullCache->loadShape(info);
+    QVERIFY(loadedShape != nullptr);
+    QCOMPARE(loadedShape->getShapeType(), (int)CONVEX_HULL_SHAPE_PROXYTYPE);
+    compareHulls(static_cast<const btConvexHullShape*>(shape), static_cast<const btConvexHullShape*>(loadedShape));
+
+    ShapeFactory::deleteShape(shape);
+    ShapeFactory::deleteShape(loadedShape);
+}
+
+void HullCacheTests::saveAndLoadCompound() {
+    QTemporaryDir dir;
+    auto hullCache = std::make_shared<HullCache>(dir.path().toStdString());
+    hullCache->initialize();
+
+    ShapeInfo::PointCollection pointCollection;
+    int numHulls = 4;
+    for (int i = 0; i < numHulls; ++i) {
+        pointCollection.push_back(makeHullPoints(glm::vec3((float)(2 * i), 0.0f, 0.0f), (float)(i + 1)));
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(4.0f));
+    info.setPointCollection(pointCollection);
+    info.setOffset(glm::vec3(0.0f, 1.0f, 0.0f));
+
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info, hullCache.get());
+    QVERIFY(shape != nullptr);
+
+    // the cached hulls are those without the offset, which is applied again when the shape is made from them
+    const btCollisionShape* cachedShape = ShapeFactory::createShapeFromInfo(info, hullCache.get());
+    QVERIFY(cachedShape != nullptr);
+    QCOMPARE(hullCache->getNumTotalFiles(), (size_t)1);
+    QCOMPARE(cachedShape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    const btCompoundShape* cachedCompound = static_cast<const btCompoundShape*>(cachedShape);
+    QCOMPARE(cachedCompound->getNumChildShapes(), numHulls);
+    for (int i = 0; i < numHulls; ++i) {
+        QCOMPARE(cachedCompound->getChildTransform(i).getOrigin(), compound->getChildTransform(i).getOrigin());
+        compareHulls(static_cast<const btConvexHullShape*>(compound->getChildShape(i)),
+                static_cast<const btConvexHullShape*>(cachedCompound->getChildShape(i)));
+    }
+
+    ShapeFactory::deleteShape(shape);
+    ShapeFactory::deleteShape(cachedShape);
+}
+
+void HullCacheTests::ignoreOtherShapes() {
+    QTemporaryDir dir;
+    auto hullCache = std::make_shared<HullCache>(dir.path().toStdString());
+    hullCache->initialize();
+
+    // only hulls are cached
+    ShapeInfo boxInfo;
+    boxInfo.setBox(glm::vec3(1.0f));
+    const btCollisionShape* box = ShapeFactory::createShapeFromInfo(boxInfo, hullCache.get());
+    QVERIFY(box != nullptr);
+    QCOMPARE(hullCache->getNumTotalFiles(), (size_t)0);
+    ShapeFactory::deleteShape(box);
+
+    // and only found for the info they were built for
+    ShapeInfo::PointCollection pointCollection;
+    pointCollection.push_back(makeHullPoints(glm::vec3(0.0f), 1.0f));
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_SIMPLE_HULL, glm::vec3(1.0f));
+    info.setPointCollection(pointCollection);
+    const btCollisionShape* hull = ShapeFactory::createShapeFromInfo(info, hullCache.get());
+    QVERIFY(hull != nullptr);
+    ShapeFactory::deleteShape(hull);
+
+    pointCollection[0][0] += glm::vec3(0.5f);
+    ShapeInfo otherInfo;
+    otherInfo.setParams(SHAPE_TYPE_SIMPLE_HULL, glm::vec3(1.0f));
+    otherInfo.setPointCollection(pointCollection);
+    QVERIFY(hullCache->loadShape(otherInfo) == nullptr);
+}
+
+void HullCacheTests::ignoreOtherPoints() {
+    QTemporaryDir dir;
+    auto hullCache = std::make_shared<HullCache>(dir.path().toStdString());
+    hullCache->initialize();
+
+    ShapeInfo::PointCollection pointCollection;
+    int numHulls = 2;
+    for (int i = 0; i < numHulls; ++i) {
+        pointCollection.push_back(makeHullPoints(glm::vec3((float)(2 * i), 0.0f, 0.0f), 1.0f));
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(2.0f), "http://example.com/model.fbx");
+    info.setPointCollection(pointCollection);
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info, hullCache.get());
+    QVERIFY(shape != nullptr);
+    ShapeFactory::deleteShape(shape);
+
+    // as when the model at the url has changed: the hash of the info is the same, but not its points
+    pointCollection[1][0] += glm::vec3(0.5f);
+    ShapeInfo otherInfo;
+    otherInfo.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(2.0f), "http://example.com/model.fbx");
+    otherInfo.setPointCollection(pointCollection);
+    QCOMPARE(otherInfo.getHash().getHash64(), info.getHash().getHash64());
+    QVERIFY(hullCache->loadShape(otherInfo) == nullptr);
+
+    btCollisionShape* loadedShape = hullCache->loadShape(info);
+    QVERIFY(loadedShape != nullptr);
+    ShapeFactory::deleteShape(loadedShape);
+}
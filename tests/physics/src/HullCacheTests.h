@@ -0,0 +1,27 @@
+//
+//  HullCacheTests.h
+//  tests/physics/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HullCacheTests_h
+#define hifi_HullCacheTests_h
+
+#include <QtTest/QtTest>
+
+class HullCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void saveAndLoadHull();
+    void saveAndLoadCompound();
+    void ignoreOtherShapes();
+    void ignoreOtherPoints();
+};
+
+#endif // hifi_HullCacheTests_h
@@ -13,6 +13,9 @@
 
 #include <iostream>
 
+#include <QElapsedTimer>
+#include <QThread>
+
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -244,3 +247,114 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::addCompoundShapeInBackground() {
+    // the points of a few tetrahedral hulls side by side
+    ShapeInfo::PointCollection pointCollection;
+    Extents extents;
+    int numHulls = 3;
+    for (int i = 0; i < numHulls; ++i) {
+        glm::vec3 offset((float)(2 * i), 0.0f, 0.0f);
+        ShapeInfo::PointList pointList;
+        pointList.push_back(glm::vec3(1.0f, 1.0f, 1.0f) + offset);
+        pointList.push_back(glm::vec3(1.0f, -1.0f, -1.0f) + offset);
+        pointList.push_back(glm::vec3(-1.0f, 1.0f, -1.0f) + offset);
+        pointList.push_back(glm::vec3(-1.0f, -1.0f, 1.0f) + offset);
+        for (auto& point : pointList) {
+            extents.addPoint(point);
+        }
+        pointCollection.push_back(pointList);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, 0.5f * (extents.maximum - extents.minimum));
+    info.setPointCollection(pointCollection);
+
+    ShapeManager shapeManager;
+    shapeManager.setBuildShapesInBackground(true);
+
+    // the shape isn't ready the first time it is asked for
+    const btCollisionShape* shape = shapeManager.getShape(info);
+    QVERIFY(shape == nullptr);
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 1);
+
+    // ask again until it is
+    const qint64 MAX_WAIT_MSECS = 10000;
+    QElapsedTimer timer;
+    timer.start();
+    while (!shape && timer.elapsed() < MAX_WAIT_MSECS) {
+        QThread::msleep(1);
+        shape = shapeManager.getShape(info);
+        QVERIFY(shape || shapeManager.getNumPendingShapes() == 1);
+    }
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    QCOMPARE(static_cast<const btCompoundShape*>(shape)->getNumChildShapes(), numHulls);
+    QCOMPARE(shapeManager.getNumShapes(), 1);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 0);
+    QCOMPARE(shapeManager.getNumReferences(info), 1);
+
+    // once built it is shared like any other shape
+    QCOMPARE(shapeManager.getShape(info), shape);
+    QCOMPARE(shapeManager.getNumReferences(info), 2);
+    shapeManager.releaseShape(shape);
+    shapeManager.releaseShape(shape);
+    shapeManager.collectGarbage();
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+
+    // a shape that is done is kept through garbage collection until it is asked for again
+    ShapeInfo otherInfo = info;
+    otherInfo.setOffset(glm::vec3(0.0f, 1.0f, 0.0f));
+    QVERIFY(shapeManager.getShape(otherInfo) == nullptr);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 1);
+    const qint64 GARBAGE_MSECS = 200;
+    timer.restart();
+    while (timer.elapsed() < GARBAGE_MSECS) {
+        QThread::msleep(1);
+        shapeManager.collectGarbage();
+    }
+    QCOMPARE(shapeManager.getNumPendingShapes(), 1);
+    shape = nullptr;
+    timer.restart();
+    while (!shape && timer.elapsed() < MAX_WAIT_MSECS) {
+        shape = shapeManager.getShape(otherInfo);
+        QThread::msleep(1);
+    }
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 0);
+    shapeManager.releaseShape(shape);
+    shapeManager.collectGarbage();
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+
+    // one of two bodies waiting for a shape giving up on it doesn't take it from the other
+    otherInfo.setOffset(glm::vec3(0.0f, 3.0f, 0.0f));
+    QVERIFY(shapeManager.getShape(otherInfo) == nullptr);
+    QVERIFY(shapeManager.getShape(otherInfo) == nullptr);
+    shapeManager.releasePendingShape(otherInfo.getHash());
+    shape = nullptr;
+    timer.restart();
+    while (!shape && timer.elapsed() < MAX_WAIT_MSECS) {
+        QThread::msleep(1);
+        shapeManager.collectGarbage();
+        QCOMPARE(shapeManager.getNumPendingShapes(), 1);
+        shape = shapeManager.getShape(otherInfo, true);
+    }
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 0);
+    shapeManager.releaseShape(shape);
+    shapeManager.collectGarbage();
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+
+    // or until it is released, after which it is collected with the garbage once it is done
+    otherInfo.setOffset(glm::vec3(0.0f, 2.0f, 0.0f));
+    QVERIFY(shapeManager.getShape(otherInfo) == nullptr);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 1);
+    shapeManager.releasePendingShape(otherInfo.getHash());
+    timer.restart();
+    while (shapeManager.getNumPendingShapes() > 0 && timer.elapsed() < MAX_WAIT_MSECS) {
+        QThread::msleep(1);
+        shapeManager.collectGarbage();
+    }
+    QCOMPARE(shapeManager.getNumPendingShapes(), 0);
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+}
@@ -0,0 +1,152 @@
+//
+//  ThreadSafeDynamicsWorldTests.cpp
+//  tests/physics/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ThreadSafeDynamicsWorldTests.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <QThread>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <SharedUtil.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(ThreadSafeDynamicsWorldTests)
+
+const float BOX_HALF_EXTENT = 0.5f;
+const float STACK_SPACING = 4.0f * BOX_HALF_EXTENT;
+const btScalar SUBSTEP = btScalar(1.0) / btScalar(90.0);
+
+// Stacks of boxes on the ground, each its own island, with a kinematic platform under the first two stacks so that
+// they share a body and must be solved together
+class StackedBoxes {
+public:
+    StackedBoxes(int numStacks, int boxesPerStack, int numSolverThreads) {
+        _world.reset(new ThreadSafeDynamicsWorld(&_dispatcher, &_broadphase, &_solver, &_collisionConfig));
+        _world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+        _world->setNumSolverThreads(numSolverThreads);
+
+        addBody(&_groundShape, 0.0f, btVector3(0.0f, -1.0f, 0.0f));
+
+        addBody(&_platformShape, 0.0f, btVector3(0.5f * STACK_SPACING, 0.5f * BOX_HALF_EXTENT, 0.0f), true);
+        float platformTop = BOX_HALF_EXTENT;
+
+        int stacksPerRow = (int)ceilf(sqrtf((float)numStacks));
+        for (int i = 0; i < numStacks; ++i) {
+            float x = (float)(i % stacksPerRow) * STACK_SPACING;
+            float z = (float)(i / stacksPerRow) * STACK_SPACING;
+            float bottom = i < 2 ? platformTop : 0.0f;
+            for (int j = 0; j < boxesPerStack; ++j) {
+                // a little off center, so that the stacks have something to settle
+                float offset = 0.01f * (float)((i + j) % 3 - 1);
+                btVector3 position(x + offset, bottom + (2.0f * (float)j + 1.0f) * BOX_HALF_EXTENT, z);
+                _boxes.push_back(addBody(&_boxShape, 1.0f, position));
+            }
+        }
+    }
+
+    ~StackedBoxes() {
+        for (auto& body : _bodies) {
+            _world->removeRigidBody(body.get());
+        }
+    }
+
+    void step(int numSubsteps) {
+        for (int i = 0; i < numSubsteps; ++i) {
+            _world->stepSimulationWithSubstepCallback(SUBSTEP, 1, SUBSTEP);
+        }
+    }
+
+    const std::vector<btRigidBody*>& getBoxes() const { return _boxes; }
+
+private:
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const btVector3& position, bool kinematic = false) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+        info.m_startWorldTransform.setOrigin(position);
+        btRigidBody* body = new btRigidBody(info);
+        if (kinematic) {
+            int flags = body->getCollisionFlags() & ~btCollisionObject::CF_STATIC_OBJECT;
+            body->setCollisionFlags(flags | btCollisionObject::CF_KINEMATIC_OBJECT);
+            body->setActivationState(DISABLE_DEACTIVATION);
+        }
+        _bodies.emplace_back(body);
+        _world->addRigidBody(body);
+        return body;
+    }
+
+    btDefaultCollisionConfiguration _collisionConfig;
+    btCollisionDispatcher _dispatcher { &_collisionConfig };
+    btDbvtBroadphase _broadphase;
+    btSequentialImpulseConstraintSolver _solver;
+    std::unique_ptr<ThreadSafeDynamicsWorld> _world;
+
+    btBoxShape _groundShape { btVector3(1000.0f, 1.0f, 1000.0f) };
+    btBoxShape _platformShape { btVector3(0.75f * STACK_SPACING, 0.5f * BOX_HALF_EXTENT, 0.75f * BOX_HALF_EXTENT) };
+    btBoxShape _boxShape { btVector3(BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT) };
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+    std::vector<btRigidBody*> _boxes;
+};
+
+void ThreadSafeDynamicsWorldTests::testParallelSolverIsDeterministic() {
+    if (!ThreadSafeDynamicsWorld::isParallelSolverSupported()) {
+        QSKIP("this build of Bullet can't solve islands on several threads");
+    }
+
+    const int NUM_STACKS = 40;
+    const int BOXES_PER_STACK = 8;
+    const int NUM_SUBSTEPS = 120;
+    StackedBoxes twoThreads(NUM_STACKS, BOXES_PER_STACK, 2);
+    StackedBoxes fourThreads(NUM_STACKS, BOXES_PER_STACK, 4);
+    twoThreads.step(NUM_SUBSTEPS);
+    fourThreads.step(NUM_SUBSTEPS);
+
+    const auto& boxes = twoThreads.getBoxes();
+    const auto& otherBoxes = fourThreads.getBoxes();
+    QCOMPARE(boxes.size(), otherBoxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        QVERIFY(boxes[i]->getWorldTransform().getOrigin() == otherBoxes[i]->getWorldTransform().getOrigin());
+        QVERIFY(boxes[i]->getWorldTransform().getBasis() == otherBoxes[i]->getWorldTransform().getBasis());
+        QVERIFY(boxes[i]->getLinearVelocity() == otherBoxes[i]->getLinearVelocity());
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void ThreadSafeDynamicsWorldTests::benchmarkStackedBoxes() {
+    const int BOXES_PER_STACK = 10;
+    const int NUM_SUBSTEPS = 180;
+    int numThreads = std::max(QThread::idealThreadCount(), 2);
+    std::vector<int> numBoxes = { 1000, 2000, 4000, 8000 };
+
+    std::cout << "[numBoxes, usecPerSubstep, usecPerSubstepOn" << numThreads << "Threads] = [" << std::endl;
+    for (int n : numBoxes) {
+        uint64_t usec[2];
+        for (int k = 0; k < 2; ++k) {
+            StackedBoxes boxes(n / BOXES_PER_STACK, BOXES_PER_STACK, k == 0 ? 1 : numThreads);
+            boxes.step(1);
+            uint64_t startTime = usecTimestampNow();
+            boxes.step(NUM_SUBSTEPS);
+            usec[k] = (usecTimestampNow() - startTime) / NUM_SUBSTEPS;
+        }
+        std::cout << "    " << n << ", " << usec[0] << ", " << usec[1] << std::endl;
+    }
+    std::cout << "];" << std::endl;
+}
+
+#endif // MANUAL_TEST
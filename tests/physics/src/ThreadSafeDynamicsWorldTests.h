@@ -0,0 +1,29 @@
+//
+//  ThreadSafeDynamicsWorldTests.h
+//  tests/physics/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ThreadSafeDynamicsWorldTests_h
+#define hifi_ThreadSafeDynamicsWorldTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class ThreadSafeDynamicsWorldTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testParallelSolverIsDeterministic();
+#ifdef MANUAL_TEST
+    void benchmarkStackedBoxes();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_ThreadSafeDynamicsWorldTests_h
@@ -13,6 +13,8 @@
 
 #include <iostream>
 
+#include <glm/gtx/norm.hpp>
+
 #include <workload/Space.h>
 #include <StreamUtils.h>
 #include <SharedUtil.h>
@@ -100,8 +102,6 @@ void SpaceTests::testOverlaps() {
     }
 }
 
-#ifdef MANUAL_TEST
-
 const float WORLD_WIDTH = 1000.0f;
 const float MIN_RADIUS = 1.0f;
 const float MAX_RADIUS = 100.0f;
@@ -127,6 +127,257 @@ void generateSpheres(uint32_t numProxies, std::vector<workload::Space::Sphere>&
     }
 }
 
+void generateViews(std::vector<workload::Space::View>& views) {
+    std::vector<glm::vec3> viewPositions;
+    viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f));
+    viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f + 0.1f * WORLD_WIDTH));
+    float radius0 = 0.25f * WORLD_WIDTH;
+    float radius1 = 0.50f * WORLD_WIDTH;
+    float radius2 = 0.75f * WORLD_WIDTH;
+    views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
+    views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
+}
+
+// categorizeAndGetChanges as it was before Space kept its proxies in SoA arrays, one proxy at a time
+class ReferenceSpace {
+public:
+    void createProxies(const std::vector<workload::Space::Sphere>& spheres) {
+        _spheres = spheres;
+        _regions.assign(spheres.size(), (uint8_t)workload::Space::REGION_UNKNOWN);
+    }
+    void createProxy(int32_t proxyId, const workload::Space::Sphere& sphere) {
+        if (proxyId >= (int32_t)_spheres.size()) {
+            _spheres.resize(proxyId + 1);
+            _regions.resize(proxyId + 1, (uint8_t)workload::Space::REGION_INVALID);
+        }
+        _spheres[proxyId] = sphere;
+        _regions[proxyId] = workload::Space::REGION_UNKNOWN;
+    }
+    void deleteProxy(int32_t proxyId) { _regions[proxyId] = workload::Space::REGION_INVALID; }
+    void updateProxy(int32_t proxyId, const workload::Space::Sphere& sphere) { _spheres[proxyId] = sphere; }
+    void setViews(const std::vector<workload::Space::View>& views) { _views = views; }
+
+    void categorizeAndGetChanges(std::vector<workload::Space::Change>& changes) {
+        for (uint32_t i = 0; i < (uint32_t)_spheres.size(); ++i) {
+            if (_regions[i] < workload::Space::REGION_INVALID) {
+                uint8_t region = workload::Space::REGION_UNKNOWN;
+                for (uint32_t j = 0; j < (uint32_t)_views.size(); ++j) {
+                    float distance2 = glm::distance2(_views[j].center, glm::vec3(_spheres[i]));
+                    for (uint8_t c = 0; c < region; ++c) {
+                        float touchDistance = _views[j].radiuses[c] + _spheres[i].w;
+                        if (distance2 < touchDistance * touchDistance) {
+                            region = c;
+                            break;
+                        }
+                    }
+                }
+                if (region != _regions[i]) {
+                    changes.push_back(workload::Space::Change((int32_t)i, region, _regions[i]));
+                }
+                _regions[i] = region;
+            }
+        }
+    }
+
+private:
+    std::vector<workload::Space::Sphere> _spheres;
+    std::vector<uint8_t> _regions;
+    std::vector<workload::Space::View> _views;
+};
+
+void compareChanges(const std::vector<workload::Space::Change>& changes,
+                    const std::vector<workload::Space::Change>& expectedChanges) {
+    QCOMPARE(changes.size(), expectedChanges.size());
+    for (size_t i = 0; i < changes.size(); ++i) {
+        QCOMPARE(changes[i].proxyId, expectedChanges[i].proxyId);
+        QCOMPARE(changes[i].region, expectedChanges[i].region);
+        QCOMPARE(changes[i].prevRegion, expectedChanges[i].prevRegion);
+    }
+}
+
+void SpaceTests::testCategorizeMatchesReference() {
+    // enough proxies for categorizeAllAndGetChanges to be split across threads, and not a multiple of the padding
+    const uint32_t NUM_PROXIES = 4 * workload::Space::MIN_PROXIES_PER_THREAD + 13;
+
+    srand(0);
+    std::vector<workload::Space::Sphere> spheres;
+    generateSpheres(NUM_PROXIES, spheres);
+    std::vector<workload::Space::View> views;
+    generateViews(views);
+
+    workload::Space space;
+    ReferenceSpace reference;
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        QCOMPARE(space.createProxy(spheres[i]), (int32_t)i);
+    }
+    reference.createProxies(spheres);
+    for (uint32_t i = 0; i < NUM_PROXIES; i += 7) {
+        space.deleteProxy(i);
+        reference.deleteProxy(i);
+    }
+    space.setViews(views);
+    reference.setViews(views);
+
+    for (int step = 0; step < 3; ++step) {
+        std::vector<workload::Space::Change> changes;
+        std::vector<workload::Space::Change> expectedChanges;
+        space.categorizeAllAndGetChanges(changes);
+        reference.categorizeAndGetChanges(expectedChanges);
+        QVERIFY(expectedChanges.size() > 0);
+        compareChanges(changes, expectedChanges);
+
+        // move some of the proxies, far enough to change region
+        for (uint32_t i = 1; i < NUM_PROXIES; i += 3) {
+            workload::Space::Sphere sphere(0.1f * WORLD_WIDTH * randomVec3() + glm::vec3(spheres[i]), spheres[i].w);
+            space.updateProxy(i, sphere);
+            reference.updateProxy(i, sphere);
+        }
+    }
+}
+
+void SpaceTests::testIncrementalMatchesReference() {
+    const uint32_t NUM_PROXIES = 20000;
+    const int NUM_STEPS = 60;
+
+    srand(1);
+    std::vector<workload::Space::Sphere> spheres;
+    generateSpheres(NUM_PROXIES, spheres);
+    std::vector<workload::Space::View> views;
+    generateViews(views);
+
+    workload::Space space;
+    ReferenceSpace reference;
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        space.createProxy(spheres[i]);
+    }
+    reference.createProxies(spheres);
+    std::vector<bool> deleted(NUM_PROXIES, false);
+
+    for (int step = 0; step < NUM_STEPS; ++step) {
+        // move the views a little, most of the time
+        if (step % 4 != 3) {
+            for (auto& view : views) {
+                view.center += glm::vec3(0.5f, 0.0f, 0.2f) + randomVec3();
+            }
+        }
+        if (step == NUM_STEPS / 3) {
+            views.pop_back();
+        } else if (step == 2 * NUM_STEPS / 3) {
+            views.push_back(workload::Space::View(glm::vec3(-0.3f * WORLD_WIDTH, 0.0f, 0.0f), 50.0f, 100.0f, 200.0f));
+        }
+        space.setViews(views);
+        reference.setViews(views);
+
+        // move a few of the proxies a little, and a few more far
+        for (uint32_t j = 0; j < NUM_PROXIES / 100; ++j) {
+            int32_t proxyId = rand() % NUM_PROXIES;
+            float distance = (j % 10 == 0) ? 0.1f * WORLD_WIDTH : 1.0f;
+            spheres[proxyId] = workload::Space::Sphere(distance * randomVec3() + glm::vec3(spheres[proxyId]),
+                                                       spheres[proxyId].w);
+            space.updateProxy(proxyId, spheres[proxyId]);
+            reference.updateProxy(proxyId, spheres[proxyId]);
+        }
+
+        // and now and then delete some, and create others in their place
+        if (step % 10 == 5) {
+            for (uint32_t j = 0; j < NUM_PROXIES / 100; ++j) {
+                int32_t proxyId = (step * 101 + j * 37) % NUM_PROXIES;
+                if (!deleted[proxyId]) {
+                    space.deleteProxy(proxyId);
+                    reference.deleteProxy(proxyId);
+                    deleted[proxyId] = true;
+                }
+            }
+        } else if (step % 10 == 8) {
+            for (uint32_t j = 0; j < NUM_PROXIES / 200; ++j) {
+                workload::Space::Sphere sphere(WORLD_WIDTH * randomVec3(), MIN_RADIUS + MAX_RADIUS * fabsf(randomFloat()));
+                int32_t proxyId = space.createProxy(sphere);
+                QVERIFY(proxyId < (int32_t)NUM_PROXIES);
+                reference.createProxy(proxyId, sphere);
+                spheres[proxyId] = sphere;
+                deleted[proxyId] = false;
+            }
+        }
+
+        // the brute force categorization now and then too, to check the grid is kept up by it
+        std::vector<workload::Space::Change> changes;
+        std::vector<workload::Space::Change> expectedChanges;
+        if (step % 13 == 12) {
+            space.categorizeAllAndGetChanges(changes);
+        } else {
+            space.categorizeAndGetChanges(changes);
+        }
+        reference.categorizeAndGetChanges(expectedChanges);
+        compareChanges(changes, expectedChanges);
+    }
+
+    { // nothing moved
+        space.setViews(views);
+        std::vector<workload::Space::Change> changes;
+        space.categorizeAndGetChanges(changes);
+        QVERIFY(changes.empty());
+    }
+}
+
+void SpaceTests::testIncrementalAfterFullPass() {
+    const uint32_t NUM_PROXIES = 20000;
+    const int NUM_STEPS = 10;
+
+    // small proxies, so that few of them are in the cells the edges of the regions move through
+    srand(2);
+    std::vector<workload::Space::Sphere> spheres;
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        spheres.push_back(workload::Space::Sphere(WORLD_WIDTH * randomVec3(), MIN_RADIUS));
+    }
+
+    workload::Space space;
+    ReferenceSpace reference;
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        space.createProxy(spheres[i]);
+    }
+    reference.createProxies(spheres);
+
+    auto categorize = [&](bool all) {
+        std::vector<workload::Space::Change> changes;
+        std::vector<workload::Space::Change> expectedChanges;
+        if (all) {
+            space.categorizeAllAndGetChanges(changes);
+        } else {
+            space.categorizeAndGetChanges(changes);
+        }
+        reference.categorizeAndGetChanges(expectedChanges);
+        compareChanges(changes, expectedChanges);
+    };
+
+    // the views start away from every proxy, and the first categorization looks at all of them
+    std::vector<workload::Space::View> views;
+    views.push_back(workload::Space::View(glm::vec3(10.0f * WORLD_WIDTH, 0.0f, 0.0f), 50.0f, 100.0f, 200.0f));
+    space.setViews(views);
+    reference.setViews(views);
+    categorize(false);
+    QCOMPARE(space.getNumCategorized(), NUM_PROXIES);
+
+    // a jump of the views that puts almost every proxy in another region falls back to a full pass, as does the brute
+    // force categorization, and in both cases the next views moving a little are incremental
+    for (int fallback = 0; fallback < 2; ++fallback) {
+        views[0] = workload::Space::View(glm::vec3(0.0f), 50.0f, 100.0f + fallback, 1.7f * WORLD_WIDTH);
+        space.setViews(views);
+        reference.setViews(views);
+        categorize(fallback == 1);
+        QCOMPARE(space.getNumCategorized(), NUM_PROXIES);
+
+        for (int step = 0; step < NUM_STEPS; ++step) {
+            views[0].center += glm::vec3(1.0f, 0.5f, 0.0f);
+            space.setViews(views);
+            reference.setViews(views);
+            categorize(false);
+            QVERIFY(space.getNumCategorized() < NUM_PROXIES / 8);
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+
 void generatePositions(uint32_t numProxies, std::vector<glm::vec3>& positions) {
     positions.reserve(numProxies);
     for (uint32_t i = 0; i < numProxies; ++i) {
@@ -269,4 +520,91 @@ void SpaceTests::benchmark() {
     std::cout << "];" << std::endl;
 }
 
+void SpaceTests::benchmarkCategorize() {
+    uint32_t numProxies[] = { 100000, 1000000 };
+    uint32_t numTests = 2;
+    const uint32_t NUM_STEPS = 10;
+    std::vector<uint64_t> timeToCategorize;
+    std::vector<uint64_t> timeToCategorizeWithStillViews;
+    std::vector<uint64_t> timeToCategorizeAll;
+    std::vector<uint64_t> timeToCategorizeReference;
+    for (uint32_t i = 0; i < numTests; ++i) {
+        uint32_t n = numProxies[i];
+        std::vector<workload::Space::Sphere> proxySpheres;
+        generateSpheres(n, proxySpheres);
+        std::vector<workload::Space::View> views;
+        generateViews(views);
+
+        workload::Space space;
+        workload::Space stillSpace;
+        workload::Space allSpace;
+        ReferenceSpace reference;
+        for (uint32_t j = 0; j < n; ++j) {
+            space.createProxy(proxySpheres[j]);
+            stillSpace.createProxy(proxySpheres[j]);
+            allSpace.createProxy(proxySpheres[j]);
+        }
+        reference.createProxies(proxySpheres);
+        stillSpace.setViews(views);
+
+        // move the views a little every step, and one proxy in a thousand, so that some of the proxies change region
+        std::vector<workload::Space::Change> changes;
+        uint64_t usec = 0;
+        uint64_t stillUsec = 0;
+        uint64_t allUsec = 0;
+        uint64_t referenceUsec = 0;
+        for (uint32_t k = 0; k <= NUM_STEPS; ++k) {
+            for (auto& view : views) {
+                view.center += glm::vec3(1.0f, 0.0f, 0.0f);
+            }
+            space.setViews(views);
+            allSpace.setViews(views);
+            reference.setViews(views);
+            for (uint32_t j = k; j < n; j += 1000) {
+                proxySpheres[j] += workload::Space::Sphere(randomVec3(), 0.0f);
+                space.updateProxy(j, proxySpheres[j]);
+                stillSpace.updateProxy(j, proxySpheres[j]);
+                allSpace.updateProxy(j, proxySpheres[j]);
+                reference.updateProxy(j, proxySpheres[j]);
+            }
+
+            // the first step categorizes every proxy, for all of them
+            bool timed = k > 0;
+
+            changes.clear();
+            uint64_t startTime = usecTimestampNow();
+            space.categorizeAndGetChanges(changes);
+            usec += timed ? usecTimestampNow() - startTime : 0;
+
+            changes.clear();
+            startTime = usecTimestampNow();
+            stillSpace.categorizeAndGetChanges(changes);
+            stillUsec += timed ? usecTimestampNow() - startTime : 0;
+
+            changes.clear();
+            startTime = usecTimestampNow();
+            allSpace.categorizeAllAndGetChanges(changes);
+            allUsec += timed ? usecTimestampNow() - startTime : 0;
+
+            changes.clear();
+            startTime = usecTimestampNow();
+            reference.categorizeAndGetChanges(changes);
+            referenceUsec += timed ? usecTimestampNow() - startTime : 0;
+        }
+        timeToCategorize.push_back(usec / NUM_STEPS);
+        timeToCategorizeWithStillViews.push_back(stillUsec / NUM_STEPS);
+        timeToCategorizeAll.push_back(allUsec / NUM_STEPS);
+        timeToCategorizeReference.push_back(referenceUsec / NUM_STEPS);
+    }
+
+    std::cout << "[numProxies, timeToCategorize, timeToCategorizeWithStillViews, timeToCategorizeAll, "
+        << "timeToCategorizeOneAtATime] = [" << std::endl;
+    for (uint32_t i = 0; i < timeToCategorize.size(); ++i) {
+        uint32_t n = numProxies[i];
+        std::cout << "    " << n << ", " << timeToCategorize[i] << ", " << timeToCategorizeWithStillViews[i] << ", "
+            << timeToCategorizeAll[i] << ", " << timeToCategorizeReference[i] << std::endl;
+    }
+    std::cout << "];" << std::endl;
+}
+
 #endif // MANUAL_TEST
@@ -21,8 +21,12 @@ class SpaceTests : public QObject {
 
 private slots:
     void testOverlaps();
+    void testCategorizeMatchesReference();
+    void testIncrementalMatchesReference();
+    void testIncrementalAfterFullPass();
 #ifdef MANUAL_TEST
     void benchmark();
+    void benchmarkCategorize();
 #endif // MANUAL_TEST
 };
 
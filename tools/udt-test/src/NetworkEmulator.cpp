@@ -0,0 +1,166 @@
+//
+//  NetworkEmulator.cpp
+//  tools/udt-test/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NetworkEmulator.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+
+using namespace std::chrono;
+
+static const double BITS_PER_BYTE = 8.0;
+static const double USECS_PER_SECOND = 1000000.0;
+static const double BITS_PER_MEGABIT = 1000000.0;
+
+NetworkEmulator::NetworkEmulator(const HifiSockAddr& target, const Impairments& impairments) :
+    _target(target),
+    _impairments(impairments)
+{
+    _sendTimer.setSingleShot(true);
+    _sendTimer.setTimerType(Qt::PreciseTimer);
+
+    connect(&_socket, &QUdpSocket::readyRead, this, &NetworkEmulator::readPendingDatagrams);
+    connect(&_sendTimer, &QTimer::timeout, this, &NetworkEmulator::sendDueDatagrams);
+}
+
+NetworkEmulator::~NetworkEmulator() {
+    if (_thread.isRunning()) {
+        // bring the relay back to this thread, so that its socket and timer can be destroyed here
+        QMetaObject::invokeMethod(this, "stop", Qt::BlockingQueuedConnection);
+        _thread.quit();
+        _thread.wait();
+    }
+}
+
+HifiSockAddr NetworkEmulator::start() {
+    // bound to any address, so that the target can be on another machine
+    _socket.bind(QHostAddress::AnyIPv4, 0);
+
+    moveToThread(&_thread);
+    _thread.setObjectName("Network Emulator");
+    _thread.start();
+
+    qDebug() << "Emulating" << _impairments.delayMsecs << "ms delay," << _impairments.lossRate * 100.0 << "% loss and"
+        << _impairments.bandwidthMbps << "Mb/s bandwidth towards" << _target;
+
+    return HifiSockAddr(QHostAddress::LocalHost, _socket.localPort());
+}
+
+NetworkEmulator::Stats NetworkEmulator::sampleStats() {
+    Stats stats;
+    stats.relayed = _numRelayed.exchange(0);
+    stats.lost = _numLost.exchange(0);
+    stats.overflowed = _numOverflowed.exchange(0);
+    return stats;
+}
+
+void NetworkEmulator::stop() {
+    _sendTimer.stop();
+    _socket.close();
+    moveToThread(qApp->thread());
+}
+
+void NetworkEmulator::readPendingDatagrams() {
+    while (_socket.hasPendingDatagrams()) {
+        QByteArray data(_socket.pendingDatagramSize(), 0);
+        QHostAddress senderAddress;
+        quint16 senderPort;
+
+        if (_socket.readDatagram(data.data(), data.size(), &senderAddress, &senderPort) < 0) {
+            continue;
+        }
+
+        HifiSockAddr senderSockAddr(senderAddress, senderPort);
+
+        if (senderSockAddr == _target) {
+            if (!_sender.isNull()) {
+                enqueue(_towardsSender, std::move(data), _sender);
+            }
+        } else {
+            _sender = senderSockAddr;
+            enqueue(_towardsTarget, std::move(data), _target);
+        }
+    }
+
+    scheduleNextSend();
+}
+
+void NetworkEmulator::enqueue(Direction& direction, QByteArray data, const HifiSockAddr& destination) {
+    if (_impairments.lossRate > 0.0 && _lossDistribution(_generator) < _impairments.lossRate) {
+        ++_numLost;
+        return;
+    }
+
+    auto now = p_high_resolution_clock::now();
+    auto departureTime = now;
+
+    if (_impairments.bandwidthMbps > 0.0) {
+        // the datagram starts through the bottleneck once everything queued ahead of it is through
+        auto startTime = std::max(now, direction.bottleneckFreeTime);
+
+        if (startTime - now > milliseconds(_impairments.queueMsecs)) {
+            ++_numOverflowed;
+            return;
+        }
+
+        auto transmitUsecs = data.size() * BITS_PER_BYTE * USECS_PER_SECOND / (_impairments.bandwidthMbps * BITS_PER_MEGABIT);
+        direction.bottleneckFreeTime = startTime + microseconds((int64_t)transmitUsecs);
+        departureTime = direction.bottleneckFreeTime;
+    }
+
+    departureTime += milliseconds(_impairments.delayMsecs);
+
+    direction.datagrams.push_back({ std::move(data), destination, departureTime });
+}
+
+void NetworkEmulator::sendDueDatagrams() {
+    auto now = p_high_resolution_clock::now();
+
+    for (auto direction : { &_towardsTarget, &_towardsSender }) {
+        auto& datagrams = direction->datagrams;
+        while (!datagrams.empty() && datagrams.front().departureTime <= now) {
+            auto& datagram = datagrams.front();
+            _socket.writeDatagram(datagram.data, datagram.destination.getAddress(), datagram.destination.getPort());
+            ++_numRelayed;
+            datagrams.pop_front();
+        }
+    }
+
+    scheduleNextSend();
+}
+
+void NetworkEmulator::scheduleNextSend() {
+    auto nextDepartureTime = p_high_resolution_clock::time_point::max();
+
+    for (auto direction : { &_towardsTarget, &_towardsSender }) {
+        if (!direction->datagrams.empty()) {
+            nextDepartureTime = std::min(nextDepartureTime, direction->datagrams.front().departureTime);
+        }
+    }
+
+    if (nextDepartureTime == p_high_resolution_clock::time_point::max()) {
+        return;
+    }
+
+    auto now = p_high_resolution_clock::now();
+    if (nextDepartureTime <= now) {
+        sendDueDatagrams();
+        return;
+    }
+
+    // the timer has millisecond resolution - round up, the datagrams that are due by then all go out together
+    auto usecsUntilDeparture = duration_cast<microseconds>(nextDepartureTime - now).count();
+    int timeout = (int)((usecsUntilDeparture + 999) / 1000);
+
+    if (!_sendTimer.isActive() || _sendTimer.remainingTime() > timeout) {
+        _sendTimer.start(timeout);
+    }
+}
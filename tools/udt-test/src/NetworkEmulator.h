@@ -0,0 +1,98 @@
+//
+//  NetworkEmulator.h
+//  tools/udt-test/src
+//
+//  Created on 10/16/26.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_NetworkEmulator_h
+#define hifi_NetworkEmulator_h
+
+#include <atomic>
+#include <deque>
+#include <random>
+
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtNetwork/QUdpSocket>
+
+#include <HifiSockAddr.h>
+#include <PortableHighResolutionClock.h>
+
+// Loopback relay that impairs the datagrams between a sender and its target, so that congestion controls
+// can be compared on a single machine
+//   The sender sends to the relay instead of the target. Datagrams from the target go back to the last sender.
+//   In each direction, datagrams are dropped at random, then go through a bottleneck of limited bandwidth with a
+//   tail-drop queue, then are held for a fixed delay. The relay runs on a thread of its own.
+class NetworkEmulator : public QObject {
+    Q_OBJECT
+public:
+    struct Impairments {
+        int delayMsecs { 0 }; // one way delay, in each direction
+        double lossRate { 0.0 }; // fraction of datagrams dropped at random, in each direction
+        double bandwidthMbps { 0.0 }; // bottleneck bandwidth in each direction, 0 for none
+        int queueMsecs { 100 }; // bottleneck queue, as the time it takes to drain when full
+    };
+
+    struct Stats {
+        int relayed { 0 };
+        int lost { 0 }; // dropped at random
+        int overflowed { 0 }; // dropped by the bottleneck queue
+    };
+
+    NetworkEmulator(const HifiSockAddr& target, const Impairments& impairments);
+    ~NetworkEmulator();
+
+    // bind and start relaying, returns the loopback address to send to instead of the target
+    HifiSockAddr start();
+
+    // stats since the last sample, for both directions
+    Stats sampleStats();
+
+private slots:
+    void readPendingDatagrams();
+    void sendDueDatagrams();
+    void stop();
+
+private:
+    struct Datagram {
+        QByteArray data;
+        HifiSockAddr destination;
+        p_high_resolution_clock::time_point departureTime;
+    };
+
+    struct Direction {
+        std::deque<Datagram> datagrams; // in departure order, since the delay is the same for all
+        p_high_resolution_clock::time_point bottleneckFreeTime; // time the bottleneck is done with the queue
+    };
+
+    void enqueue(Direction& direction, QByteArray data, const HifiSockAddr& destination);
+    void scheduleNextSend();
+
+    HifiSockAddr _target;
+    HifiSockAddr _sender; // last address that sent to the relay, other than the target
+    Impairments _impairments;
+
+    QThread _thread;
+    QUdpSocket _socket { this };
+    QTimer _sendTimer { this };
+
+    Direction _towardsTarget;
+    Direction _towardsSender;
+
+    std::mt19937 _generator { std::random_device()() };
+    std::uniform_real_distribution<double> _lossDistribution { 0.0, 1.0 };
+
+    std::atomic<int> _numRelayed { 0 };
+    std::atomic<int> _numLost { 0 };
+    std::atomic<int> _numOverflowed { 0 };
+};
+
+#endif // hifi_NetworkEmulator_h
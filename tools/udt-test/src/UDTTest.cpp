@@ -52,6 +52,28 @@ const QCommandLineOption MESSAGE_SIZE {
 const QCommandLineOption MESSAGE_SEED {
     "message-seed", "seed used for random number generation to match ordered messages (default is 742272)", "integer"
 };
+const QCommandLineOption FLOOD_PACKETS {
+    "flood", "send unreliable packets as fast as possible, to measure how many the target ingests"
+};
+const QCommandLineOption RECEIVE_THREADS {
+    "receive-threads", "number of threads reading datagrams in batches (Linux only, default reads on the socket thread)",
+    "threads"
+};
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control for reliable packets, vegas or bbr (default is vegas)", "name"
+};
+const QCommandLineOption EMULATE_DELAY {
+    "emulate-delay", "one way delay to add in each direction between us and the target", "milliseconds"
+};
+const QCommandLineOption EMULATE_LOSS {
+    "emulate-loss", "percentage of packets to drop at random in each direction between us and the target", "percent"
+};
+const QCommandLineOption EMULATE_BANDWIDTH {
+    "emulate-bandwidth", "bottleneck bandwidth in each direction between us and the target", "Mb/s"
+};
+const QCommandLineOption EMULATE_QUEUE {
+    "emulate-queue", "bottleneck queue, as the time it takes to drain (default is 100ms)", "milliseconds"
+};
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
@@ -62,12 +84,20 @@ const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Sent ACK2", "Sent Packets", "Re-sent Packets"
 };
 
+const QStringList EMULATOR_STATS_TABLE_HEADERS {
+    "Emu Relayed (P)", "Emu Lost (P)", "Emu Overflow (P)"
+};
+
 const QStringList SERVER_STATS_TABLE_HEADERS {
     "  Mb/s  ", "Recv Mb/s", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)",
     "Sent ACK", "Sent LACK", "Sent NAK", "Sent TNAK",
     "Recv ACK2", "Duplicates (P)"
 };
 
+const QStringList INGEST_STATS_TABLE_HEADERS {
+    "Ingested (P/s)", "Ingested (Mb/s)", "Reader Threads"
+};
+
 UDTTest::UDTTest(int& argc, char** argv) :
     QCoreApplication(argc, argv)
 {
@@ -76,6 +106,17 @@ UDTTest::UDTTest(int& argc, char** argv) :
     // randomize the seed for packet size randomization
     srand(time(NULL));
 
+    if (_argumentParser.isSet(RECEIVE_THREADS)) {
+        _socket.setNumReceiveThreads(_argumentParser.value(RECEIVE_THREADS).toInt());
+    }
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        if (!_socket.setCongestionControl(_argumentParser.value(CONGESTION_CONTROL))) {
+            qCritical() << "Unknown congestion control" << _argumentParser.value(CONGESTION_CONTROL);
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+    }
+
     _socket.bind(QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
     qDebug() << "Test socket is listening on" << _socket.localPort();
     
@@ -94,6 +135,8 @@ UDTTest::UDTTest(int& argc, char** argv) :
         } else {
             _target = HifiSockAddr(address, port);
             qDebug() << "Packets will be sent to" << _target;
+
+            setupNetworkEmulator();
         }
     }
     
@@ -144,6 +187,17 @@ UDTTest::UDTTest(int& argc, char** argv) :
     if (_argumentParser.isSet(ORDERED_PACKETS)) {
         _sendOrdered = true;
     }
+
+    if (_argumentParser.isSet(FLOOD_PACKETS)) {
+        if (_sendOrdered) {
+            qCritical() << "Cannot flood with ordered packets.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+
+        // there is no send queue to pace unreliable packets, so flooding is how we keep the target busy
+        _flood = true;
+        _sendReliable = false;
+    }
     
     if (_argumentParser.isSet(MESSAGE_SIZE)) {
         if (_argumentParser.isSet(ORDERED_PACKETS)) {
@@ -198,6 +252,13 @@ UDTTest::UDTTest(int& argc, char** argv) :
                 }
 
         });
+
+        // count the unreliable packets that make it through the socket, to report how many we can ingest
+        _socket.setPacketHandler(
+            [this](std::unique_ptr<udt::Packet> packet) {
+                ++_ingestedPackets;
+                _ingestedBytes += (int)packet->getDataSize();
+        });
     }
     _socket.setMessageFailureHandler(
         [this](HifiSockAddr from, udt::Packet::MessageNumber messageNumber) {
@@ -216,6 +277,42 @@ UDTTest::UDTTest(int& argc, char** argv) :
     statsTimer->start(_statsInterval);
 }
 
+UDTTest::~UDTTest() {
+    // stop relaying before our socket goes away
+    _networkEmulator.reset();
+}
+
+void UDTTest::setupNetworkEmulator() {
+    if (!_argumentParser.isSet(EMULATE_DELAY) && !_argumentParser.isSet(EMULATE_LOSS)
+        && !_argumentParser.isSet(EMULATE_BANDWIDTH)) {
+        return;
+    }
+
+    NetworkEmulator::Impairments impairments;
+
+    if (_argumentParser.isSet(EMULATE_DELAY)) {
+        impairments.delayMsecs = _argumentParser.value(EMULATE_DELAY).toInt();
+    }
+
+    if (_argumentParser.isSet(EMULATE_LOSS)) {
+        static const double PERCENT_TO_RATE = 0.01;
+        impairments.lossRate = _argumentParser.value(EMULATE_LOSS).toDouble() * PERCENT_TO_RATE;
+    }
+
+    if (_argumentParser.isSet(EMULATE_BANDWIDTH)) {
+        impairments.bandwidthMbps = _argumentParser.value(EMULATE_BANDWIDTH).toDouble();
+    }
+
+    if (_argumentParser.isSet(EMULATE_QUEUE)) {
+        impairments.queueMsecs = _argumentParser.value(EMULATE_QUEUE).toInt();
+    }
+
+    // from now on we talk to the relay, which forwards to the real target
+    _networkEmulator.reset(new NetworkEmulator(_target, impairments));
+    _target = _networkEmulator->start();
+    qDebug() << "Packets will be relayed through" << _target;
+}
+
 void UDTTest::parseArguments() {
     // use a QCommandLineParser to setup command line arguments and give helpful output
     _argumentParser.setApplicationDescription("High Fidelity UDT Protocol Test Client");
@@ -226,7 +323,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, FLOOD_PACKETS, RECEIVE_THREADS, CONGESTION_CONTROL,
+        EMULATE_DELAY, EMULATE_LOSS, EMULATE_BANDWIDTH, EMULATE_QUEUE, STATS_INTERVAL
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -243,6 +341,14 @@ void UDTTest::parseArguments() {
 
 void UDTTest::sendInitialPackets() {
     static const int NUM_INITIAL_PACKETS = 500;
+
+    if (_flood) {
+        // keep sending bursts from the event loop, so that stats are still sampled while we flood
+        QTimer* floodTimer = new QTimer(this);
+        connect(floodTimer, &QTimer::timeout, this, &UDTTest::floodPackets);
+        floodTimer->start(0);
+        return;
+    }
     
     int numPackets = std::max(NUM_INITIAL_PACKETS, _maxSendPackets);
     
@@ -333,6 +439,14 @@ void UDTTest::sendPacket() {
     
 }
 
+void UDTTest::floodPackets() {
+    static const int PACKETS_PER_BURST = 1000;
+
+    for (int i = 0; i < PACKETS_PER_BURST; ++i) {
+        sendPacket();
+    }
+}
+
 void UDTTest::handleMessage(std::unique_ptr<Message> message) {
     // generate the byte array that should match this message - using the same seed the sender did
     
@@ -369,8 +483,12 @@ void UDTTest::sampleStats() {
 
     if (!_target.isNull()) {
         if (first) {
-            // output the headers for stats for our table
-            qDebug() << qPrintable(CLIENT_STATS_TABLE_HEADERS.join(" | "));
+            // output the headers for stats for our table, with the emulator stats at the end if we are emulating
+            QStringList headers = CLIENT_STATS_TABLE_HEADERS;
+            if (_networkEmulator) {
+                headers << EMULATOR_STATS_TABLE_HEADERS;
+            }
+            qDebug() << qPrintable(headers.join(" | "));
             first = false;
         }
         
@@ -394,7 +512,42 @@ void UDTTest::sampleStats() {
             QString::number(stats.sentPackets).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.events[udt::ConnectionStats::Stats::Retransmission]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size())
         };
+
+        if (_networkEmulator) {
+            NetworkEmulator::Stats emulatorStats = _networkEmulator->sampleStats();
+
+            headerIndex = -1;
+            values << QString::number(emulatorStats.relayed).rightJustified(EMULATOR_STATS_TABLE_HEADERS[++headerIndex].size())
+                << QString::number(emulatorStats.lost).rightJustified(EMULATOR_STATS_TABLE_HEADERS[++headerIndex].size())
+                << QString::number(emulatorStats.overflowed).rightJustified(EMULATOR_STATS_TABLE_HEADERS[++headerIndex].size());
+        }
         
+        // output this line of values
+        qDebug() << qPrintable(values.join(" | "));
+    } else if (_ingestedPackets > 0 && _socket.getConnectionSockAddrs().empty()) {
+        // unreliable packets only, there are no connection stats to report
+        static bool firstIngest = true;
+        if (firstIngest) {
+            // output the headers for stats for our table
+            qDebug() << qPrintable(INGEST_STATS_TABLE_HEADERS.join(" | "));
+            firstIngest = false;
+        }
+
+        int headerIndex = -1;
+
+        double packetsPerSecond = (_ingestedPackets * MS_PER_SECOND) / _statsInterval;
+        double megabitsPerSecond = (_ingestedBytes * MEGABITS_PER_BYTE * MS_PER_SECOND) / _statsInterval;
+
+        // setup a list of left justified values
+        QStringList values {
+            QString::number(packetsPerSecond, 'f', 0).rightJustified(INGEST_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(megabitsPerSecond, 'f', 2).rightJustified(INGEST_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(_socket.getNumReceiveThreads()).rightJustified(INGEST_STATS_TABLE_HEADERS[++headerIndex].size())
+        };
+
+        _ingestedPackets = 0;
+        _ingestedBytes = 0;
+
         // output this line of values
         qDebug() << qPrintable(values.join(" | "));
     } else {
@@ -404,6 +557,10 @@ void UDTTest::sampleStats() {
             first = false;
         }
         
+        // reliable packets also reach our packet handler, they are reported through the connection stats instead
+        _ingestedPackets = 0;
+        _ingestedBytes = 0;
+
         auto sockets = _socket.getConnectionSockAddrs();
         if (sockets.size() > 0) {
             udt::ConnectionStats::Stats stats = _socket.sampleStatsForConnection(sockets.front());
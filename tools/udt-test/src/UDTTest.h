@@ -25,6 +25,8 @@
 
 #include <ReceivedMessage.h>
 
+#include "NetworkEmulator.h"
+
 struct Message {
     udt::MessageNumber messageNumber;
     QByteArray data;
@@ -34,15 +36,18 @@ class UDTTest : public QCoreApplication {
     Q_OBJECT
 public:
     UDTTest(int& argc, char** argv);
+    ~UDTTest();
 
 public slots:
     void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
+    void floodPackets(); // sends a burst of unreliable packets, called continuously while flooding
     void sampleStats();
     
 private:
     void parseArguments();
     void handleMessage(std::unique_ptr<Message> message);
     
+    void setupNetworkEmulator(); // relays packets to the target through an impaired loopback path
     void sendInitialPackets(); // fills the queue with packets to start
     void sendPacket(); // constructs and sends a packet according to the test parameters
     
@@ -50,6 +55,8 @@ private:
     udt::Socket _socket;
     
     HifiSockAddr _target; // the target for sent packets
+
+    std::unique_ptr<NetworkEmulator> _networkEmulator; // relay between us and the target, when emulating a network
     
     int _minPacketSize { udt::MAX_PACKET_SIZE };
     int _maxPacketSize { udt::MAX_PACKET_SIZE };
@@ -58,6 +65,7 @@ private:
     
     bool _sendReliable { true }; // whether packets are sent reliably or unreliably
     bool _sendOrdered { false }; // whether to send ordered packets
+    bool _flood { false }; // whether to send unreliable packets as fast as possible
     
     int _messageSize { 10000000 }; // number of bytes per message while sending ordered
 
@@ -70,6 +78,9 @@ private:
     int _totalQueuedPackets { 0 }; // keeps track of the number of packets we have already queued
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
     
+    int _ingestedPackets { 0 }; // unreliable packets handed to us by the socket since the last stats sample
+    int _ingestedBytes { 0 }; // bytes in those packets
+
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
 };
 